@@ -0,0 +1,642 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <algorithm>
+#include <thread>
+#include <filesystem>
+#include <utility>
+
+#include <benchmark/benchmark.h>
+
+#include "../KNPO-Molchanov-PrIn-266/Tokenizer.h"
+#include "../KNPO-Molchanov-PrIn-266/DfaTokenizer.h"
+#include "../KNPO-Molchanov-PrIn-266/MnemonicTranslator.h"
+#include "../KNPO-Molchanov-PrIn-266/SourceFile.h"
+#include "../KNPO-Molchanov-PrIn-266/ProgramState.h"
+#include "../KNPO-Molchanov-PrIn-266/Bytecode.h"
+#include "../KNPO-Molchanov-PrIn-266/BytecodeEngine.h"
+#include "../KNPO-Molchanov-PrIn-266/Fusion.h"
+#include "../KNPO-Molchanov-PrIn-266/BatchRunner.h"
+#include "../KNPO-Molchanov-PrIn-266/IoPort.h"
+#include "../KNPO-Molchanov-PrIn-266/ProgramImage.h"
+#include "../KNPO-Molchanov-PrIn-266/TranslationCache.h"
+#include "../KNPO-Molchanov-PrIn-266/Program.h"
+
+
+/// Количество строк в сгенерированной программе для замеров запуска и масштабирования трансляции
+const int GENERATED_LINE_COUNT = 1000000;
+
+/// Количество ячеек памяти, в которое помещаются данные сгенерированной программы
+const int GENERATED_MEMORY_SIZE = 64 * 1024 * 1024;
+
+/// Количество ячеек данных программы в замере сброса
+const int RESET_DATA_SIZE = 64 * 1024;
+
+/// Количество запусков в замере пакетного режима
+const int BATCH_RUN_COUNT = 64;
+
+/// Файл по умолчанию, в который записываются результаты в формате JSON
+const char* DEFAULT_JSON_OUTPUT = "benchmark.json";
+
+/// Программа для замера пакетного режима: цикл из 8 инструкций, 200000 итераций
+const char* BATCH_SOURCE =
+	"set r0, 200000\n"
+	"loop: add r1, r0\n"
+	"xor r2, r1\n"
+	"and r3, r2\n"
+	"or r4, r1\n"
+	"shl r5, 1\n"
+	"add r6, r5\n"
+	"sub r0, 1\n"
+	"jgt loop, r0, r7\n"
+	"set r0, r1\n"
+	"call puti\n";
+
+/// Цикл из арифметических инструкций: 8 инструкций на итерацию, 1000000 итераций
+const char* LOOP_KERNEL =
+	"set r0, 1000000\n"
+	"loop: add r1, r0\n"
+	"xor r2, r1\n"
+	"and r3, r2\n"
+	"or r4, r1\n"
+	"shl r5, 1\n"
+	"add r6, r5\n"
+	"sub r0, 1\n"
+	"jgt loop, r0, r7\n";
+
+/// Цикл из вызовов строковых подпрограмм length, find и ispalindrom, 100000 итераций
+const char* STRING_KERNEL =
+	"data text \"abacabadabacaba\"\n"
+	"data pattern \"dab\"\n"
+	"set r5, 100000\n"
+	"loop: set r0, text\n"
+	"call length\n"
+	"set r1, pattern\n"
+	"call find\n"
+	"call ispalindrom\n"
+	"sub r5, 1\n"
+	"jgt loop, r5, r7\n";
+
+/// Рекурсивное суммирование глубиной 60 вызовов (почти MAX_CALL_STACK_DEPTH), повторенное 10000 раз
+const char* CALL_KERNEL =
+	"set r5, 10000\n"
+	"outer: set r1, 60\n"
+	"set r0, 0\n"
+	"call sum\n"
+	"sub r5, 1\n"
+	"jgt outer, r5, r7\n"
+	"jmp done\n"
+	"sum: set r2, 0\n"
+	"jgt rec, r1, r2\n"
+	"ret\n"
+	"rec: add r0, r1\n"
+	"sub r1, 1\n"
+	"call sum\n"
+	"ret\n"
+	"done: set r0, 0\n";
+
+/// Сумма произведений i * 37 с умножением сдвигами и сложениями, 100000 итераций
+const char* MUL_EMULATED_KERNEL =
+	"set r5, 100000\n"
+	"loop: set r0, 0\n"
+	"set r1, r5\n"
+	"set r2, 37\n"
+	"mul_loop: set r3, r2\n"
+	"and r3, 1\n"
+	"jeq mul_skip, r3, r7\n"
+	"add r0, r1\n"
+	"mul_skip: shl r1, 1\n"
+	"shr r2, 1\n"
+	"jgt mul_loop, r2, r7\n"
+	"add r6, r0\n"
+	"sub r5, 1\n"
+	"jgt loop, r5, r7\n";
+
+/// Та же сумма произведений i * 37 с инструкцией "mul", 100000 итераций
+const char* MUL_NATIVE_KERNEL =
+	"set r5, 100000\n"
+	"loop: set r0, r5\n"
+	"mul r0, 37\n"
+	"add r6, r0\n"
+	"sub r5, 1\n"
+	"jgt loop, r5, r7\n";
+
+/// Рекурсивное суммирование глубиной 60 вызовов с сохранением аргумента в памяти
+/// по программному указателю стека r6, повторенное 10000 раз
+const char* SPILL_CALL_KERNEL =
+	"set r5, 10000\n"
+	"outer: set r1, 60\n"
+	"set r0, 0\n"
+	"set r6, 1024\n"
+	"call sum\n"
+	"sub r5, 1\n"
+	"jgt outer, r5, r7\n"
+	"jmp done\n"
+	"sum: jle base, r1, 0\n"
+	"sti r6, r1\n"
+	"add r6, 1\n"
+	"sub r1, 1\n"
+	"call sum\n"
+	"sub r6, 1\n"
+	"ldi r1, r6\n"
+	"add r0, r1\n"
+	"base: ret\n"
+	"done: set r0, 0\n";
+
+/// То же рекурсивное суммирование с сохранением аргумента инструкциями "push" и "pop"
+const char* STACK_CALL_KERNEL =
+	"set r5, 10000\n"
+	"outer: set r1, 60\n"
+	"set r0, 0\n"
+	"call sum\n"
+	"sub r5, 1\n"
+	"jgt outer, r5, r7\n"
+	"jmp done\n"
+	"sum: jle base, r1, 0\n"
+	"push r1\n"
+	"sub r1, 1\n"
+	"call sum\n"
+	"pop r1\n"
+	"add r0, r1\n"
+	"base: ret\n"
+	"done: set r0, 0\n";
+
+/// Строки разных видов для замера токенизации
+const std::pair<const char*, const char*> TOKENIZER_LINES[] = {
+	{ "label", "label_10:" },
+	{ "register", "\tadd r1, r2" },
+	{ "immediate", "\tsub r2, -0x1F ; comment" },
+	{ "jump", "\tjgt label_0, r1, r2" },
+	{ "call", "\tcall puti" },
+	{ "data", "data_8: data str_8 \"line\\n\", 'a', 0b101, 0o17" },
+	{ "comment", "; comment line 9" },
+};
+
+/*!
+Генерирует программу на псевдо-ассемблере, в которой встречаются все виды строк:
+метки, инструкции с регистрами и числами, вызовы, данные и комментарии
+\param[in] line_count Количество строк
+\return Текст программы
+*/
+static std::string generate_source(int line_count) {
+	std::ostringstream source;
+
+	for (int i = 0; i < line_count; i++) {
+		switch (i % 10) {
+		case 0:
+			source << "label_" << i << ":\n";
+			break;
+		case 1:
+			source << "\tadd r" << i % 8 << ", r" << (i + 1) % 8 << "\n";
+			break;
+		case 2:
+			source << "\tsub r" << i % 8 << ", -0x" << std::hex << i << std::dec << " ; comment\n";
+			break;
+		case 3:
+			source << "\tset r1, " << i << "\n";
+			break;
+		case 4:
+			source << "\tldi r2, r3\n";
+			break;
+		case 5:
+			source << "\tsti r3, r2\n";
+			break;
+		case 6:
+			source << "\tjgt label_" << i - 6 << ", r1, r2\n";
+			break;
+		case 7:
+			source << "\tcall puti\n";
+			break;
+		case 8:
+			source << "data_" << i << ": data str_" << i << " \"line\\n\", 'a', 0b101, 0o17\n";
+			break;
+		case 9:
+			source << "; comment line " << i << "\n";
+			break;
+		}
+	}
+
+	return source.str();
+}
+
+/*!
+Возвращает сгенерированную программу. Программа каждого размера генерируется один раз
+\param[in] line_count Количество строк
+\return Текст программы
+*/
+static const std::string& get_generated_source(int line_count) {
+	static std::map<int, std::string> sources;
+
+	auto found = sources.find(line_count);
+	if (found == sources.end()) {
+		found = sources.emplace(line_count, generate_source(line_count)).first;
+	}
+	return found->second;
+}
+
+/*!
+Транслирует программу так же, как интерпретатор: переводит, компонует, размещает данные и записывает байт-код
+\param[in] source Текст программы
+\param[out] program Программа
+\param[in] memory_size Количество ячеек памяти программы
+\return Флаг, удалось ли оттранслировать программу
+*/
+static bool translate_program(std::string_view source, TranslatedProgram& program, int memory_size = DEFAULT_MEMORY_SIZE) {
+	std::vector<TokenizerError> tokenizer_errors;
+	std::vector<SyntaxError> syntax_errors;
+
+	MnemonicTranslator translator;
+	bool translated = translator.translate(source, program.instrs, program.labels, tokenizer_errors, syntax_errors)
+		&& translator.link(program.instrs, program.labels, syntax_errors)
+		&& translator.layout_data(program.instrs, program.data_addresses, program.memory_image, syntax_errors, memory_size);
+	if (translated) {
+		translator.emit(program.instrs, program.bytecode);
+	}
+	return translated;
+}
+
+/*!
+Загружает программу так же, как интерпретатор при запуске: отображает файл в память
+и либо транслирует текст в байт-код, либо читает готовый двоичный образ
+\param[in] file_name Файл программы или её образа
+\param[out] program Программа
+\return Флаг, удалось ли загрузить программу
+*/
+static bool load_program(const char* file_name, TranslatedProgram& program) {
+	SourceFile source;
+	if (!source.open(file_name)) {
+		return false;
+	}
+
+	if (ProgramImage::is_image(source.get_text())) {
+		try {
+			ProgramImage::read(source.get_text(), program);
+		}
+		catch (ImageError&) {
+			return false;
+		}
+		return true;
+	}
+
+	return translate_program(source.get_text(), program, GENERATED_MEMORY_SIZE);
+}
+
+/// Файл сгенерированной программы для замеров запуска
+const char* START_SOURCE_FILE = "benchmark.asm";
+
+/// Файл образа сгенерированной программы для замеров запуска
+const char* START_IMAGE_FILE = "benchmark.kbin";
+
+/// Каталог кэша трансляции для замеров запуска
+const char* START_CACHE_DIRECTORY = "benchmark-cache";
+
+/*!
+Возвращает параметры, с которыми сгенерированная программа записывается в кэш трансляции
+\return Параметры интерпретатора
+*/
+static InterpreterOptions get_start_cache_options() {
+	InterpreterOptions options;
+	options.memory_size = GENERATED_MEMORY_SIZE;
+	options.fuse = false;
+	return options;
+}
+
+/*!
+Записывает на диск сгенерированную программу, её образ и запись кэша трансляции.
+Файлы записываются один раз за запуск
+\return Флаг, удалось ли записать файлы
+*/
+static bool prepare_start_files() {
+	static int prepared = -1;
+	if (prepared >= 0) {
+		return prepared;
+	}
+
+	const std::string& text = get_generated_source(GENERATED_LINE_COUNT);
+	{
+		std::ofstream output_file(START_SOURCE_FILE, std::ios::binary);
+		output_file << text;
+	}
+
+	TranslatedProgram program;
+	prepared = load_program(START_SOURCE_FILE, program);
+	if (prepared) {
+		std::ofstream image_file(START_IMAGE_FILE, std::ios::binary);
+		ProgramImage::write(program, image_file);
+		prepared = TranslationCache(START_CACHE_DIRECTORY).store(text, get_start_cache_options(), program);
+	}
+
+	return prepared;
+}
+
+/*!
+Замеряет токенизацию одной строки
+\param[in|out] state Состояние замера
+\param[in] tokenizer_type Способ выделения токенов
+\param[in] line Строка
+*/
+static void BM_Tokenize(benchmark::State& state, TOKENIZER tokenizer_type, std::string_view line) {
+	std::unique_ptr<AbstractTokenizer> tokenizer;
+	if (tokenizer_type == TOKENIZER::REGEX) {
+		tokenizer.reset(new Tokenizer());
+	}
+	else {
+		tokenizer.reset(new DfaTokenizer());
+	}
+
+	std::vector<Token> tokens;
+	for (auto _ : state) {
+		tokens.clear();
+		tokenizer->tokenize(line, tokens);
+		benchmark::DoNotOptimize(tokens.data());
+	}
+
+	state.SetBytesProcessed(state.iterations() * line.size());
+}
+
+/*!
+Замеряет трансляцию сгенерированной программы. Аргументы: количество строк и количество потоков
+\param[in|out] state Состояние замера
+*/
+static void BM_Translate(benchmark::State& state) {
+	int line_count = state.range(0);
+	int thread_count = state.range(1);
+	std::string_view source = get_generated_source(line_count);
+
+	MnemonicTranslator translator;
+	for (auto _ : state) {
+		std::vector<std::shared_ptr<Instr>> instrs;
+		std::map<std::string, int> labels;
+		std::vector<TokenizerError> tokenizer_errors;
+		std::vector<SyntaxError> syntax_errors;
+
+		if (!translator.translate(source, instrs, labels, tokenizer_errors, syntax_errors, thread_count)) {
+			state.SkipWithError("Ошибка трансляции сгенерированной программы");
+			break;
+		}
+	}
+
+	state.SetItemsProcessed(state.iterations() * line_count);
+	state.SetBytesProcessed(state.iterations() * source.size());
+}
+
+/// Способы запуска сгенерированной программы
+enum class START {
+	SOURCE, ///< Трансляция текста программы
+	IMAGE, ///< Чтение двоичного образа
+	CACHE, ///< Хэширование текста программы и чтение записи кэша трансляции
+};
+
+/*!
+Замеряет время запуска: загрузку программы от открытия файла до готового к выполнению байт-кода
+\param[in|out] state Состояние замера
+\param[in] start Способ запуска
+*/
+static void BM_Start(benchmark::State& state, START start) {
+	if (!prepare_start_files()) {
+		state.SkipWithError("Ошибка записи сгенерированной программы");
+		return;
+	}
+
+	TranslationCache cache(START_CACHE_DIRECTORY);
+	InterpreterOptions options = get_start_cache_options();
+
+	for (auto _ : state) {
+		TranslatedProgram program;
+		bool loaded = false;
+
+		if (start == START::CACHE) {
+			SourceFile source;
+			loaded = source.open(START_SOURCE_FILE) && cache.load(source.get_text(), options, program);
+		}
+		else {
+			loaded = load_program(start == START::SOURCE ? START_SOURCE_FILE : START_IMAGE_FILE, program);
+		}
+
+		if (!loaded) {
+			state.SkipWithError("Ошибка загрузки сгенерированной программы");
+			break;
+		}
+	}
+}
+
+/*!
+Замеряет выполнение программы от создания её состояния до завершения
+\param[in|out] state Состояние замера
+\param[in] source Текст программы
+\param[in] engine Способ выполнения инструкций
+*/
+static void BM_Kernel(benchmark::State& state, const char* source, ENGINE engine) {
+	TranslatedProgram translated;
+	if (!translate_program(source, translated)) {
+		state.SkipWithError("Ошибка трансляции программы");
+		return;
+	}
+
+	// Байт-код выполняется с объединенными инструкциями, как в интерпретаторе
+	if (engine != ENGINE::INSTR) {
+		std::vector<Fusion> fusions;
+		FusionPass fusion_pass;
+		fusion_pass.apply(translated.bytecode, fusions);
+	}
+	const Program program(std::move(translated));
+
+	// Вывод программы накапливается в памяти, чтобы замер не зависел от консоли
+	StringPort port;
+	BytecodeEngine bytecode_engine(engine == ENGINE::SWITCH ? DISPATCH::SWITCH : DISPATCH::THREADED);
+
+	for (auto _ : state) {
+		ProgramState program_state(program);
+		program_state.set_io_port(port);
+
+		try {
+			if (engine == ENGINE::INSTR) {
+				while (program_state.is_running()) {
+					program.get_instrs()[program_state.get_pc()]->execute(program_state);
+				}
+			}
+			else {
+				bytecode_engine.execute(program, program_state);
+			}
+		}
+		catch (RuntimeError& err) {
+			state.SkipWithError(err.what().c_str());
+			break;
+		}
+
+		port.clear_output();
+	}
+}
+
+/*!
+Замеряет сброс состояния программы перед новым запуском: создание состояния
+с загрузкой данных или восстановление снимка. Между сбросами изменяется одна страница памяти
+\param[in|out] state Состояние замера
+\param[in] use_snapshot Сбрасывать ли состояние восстановлением снимка
+*/
+static void BM_Reset(benchmark::State& state, bool use_snapshot) {
+	std::vector<int> memory_image(RESET_DATA_SIZE, 1);
+	std::map<std::string, int> data_addresses{ { "data", 0 } };
+
+	ProgramState program_state(1, RESET_DATA_SIZE);
+	program_state.load_memory_image(memory_image, data_addresses);
+	ProgramStateSnapshot initial = program_state.snapshot();
+
+	for (auto _ : state) {
+		if (use_snapshot) {
+			program_state.set_memory_value(0, 2);
+			program_state.restore(initial);
+		}
+		else {
+			ProgramState rebuilt(1, RESET_DATA_SIZE);
+			rebuilt.load_memory_image(memory_image, data_addresses);
+			rebuilt.set_memory_value(0, 2);
+			benchmark::DoNotOptimize(rebuilt.get_memory_value(0));
+		}
+	}
+}
+
+/*!
+Замеряет пакетный режим: одна оттранслированная программа выполняется BATCH_RUN_COUNT раз.
+Аргумент: количество потоков
+\param[in|out] state Состояние замера
+*/
+static void BM_Batch(benchmark::State& state) {
+	TranslatedProgram translated;
+	if (!translate_program(BATCH_SOURCE, translated)) {
+		state.SkipWithError("Ошибка трансляции программы");
+		return;
+	}
+	const Program program(std::move(translated));
+
+	const char* input_file = "benchmark_input.txt";
+	std::ofstream(input_file).close();
+
+	std::vector<BatchRun> runs(BATCH_RUN_COUNT);
+	for (auto& run : runs) {
+		run.input_file = input_file;
+	}
+
+	BatchRunner batch_runner(program, InterpreterOptions());
+	for (auto _ : state) {
+		batch_runner.run(runs, state.range(0));
+	}
+
+	std::filesystem::remove(input_file);
+	state.SetItemsProcessed(state.iterations() * BATCH_RUN_COUNT);
+}
+
+/*!
+Регистрирует замеры
+*/
+static void register_benchmarks() {
+	int max_threads = std::max(1, (int)std::thread::hardware_concurrency());
+
+	for (const auto& line : TOKENIZER_LINES) {
+		std::string_view text = line.second;
+		benchmark::RegisterBenchmark((std::string("BM_Tokenize/dfa/") + line.first).c_str(), [text](benchmark::State& state) {
+			BM_Tokenize(state, TOKENIZER::DFA, text);
+		});
+		benchmark::RegisterBenchmark((std::string("BM_Tokenize/regex/") + line.first).c_str(), [text](benchmark::State& state) {
+			BM_Tokenize(state, TOKENIZER::REGEX, text);
+		});
+	}
+
+	// Размер программы растет при трансляции в одном потоке, а на самой большой программе замеряется масштабирование
+	benchmark::internal::Benchmark* translate = benchmark::RegisterBenchmark("BM_Translate", BM_Translate);
+	translate->ArgNames({ "lines", "threads" })->Unit(benchmark::kMillisecond)->UseRealTime();
+	for (int line_count = 1000; line_count < GENERATED_LINE_COUNT; line_count *= 10) {
+		translate->Args({ line_count, 1 });
+	}
+	for (int thread_count = 1; thread_count <= max_threads; thread_count *= 2) {
+		translate->Args({ GENERATED_LINE_COUNT, thread_count });
+	}
+
+	const std::pair<const char*, START> starts[] = {
+		{ "source", START::SOURCE },
+		{ "image", START::IMAGE },
+		{ "cache", START::CACHE },
+	};
+	for (const auto& start : starts) {
+		START start_type = start.second;
+		benchmark::RegisterBenchmark((std::string("BM_Start/") + start.first).c_str(), [start_type](benchmark::State& state) {
+			BM_Start(state, start_type);
+		})->Unit(benchmark::kMillisecond);
+	}
+
+	const std::pair<const char*, const char*> kernels[] = {
+		{ "loop", LOOP_KERNEL },
+		{ "strings", STRING_KERNEL },
+		{ "calls", CALL_KERNEL },
+		{ "mul_emulated", MUL_EMULATED_KERNEL },
+		{ "mul_native", MUL_NATIVE_KERNEL },
+		{ "spill_calls", SPILL_CALL_KERNEL },
+		{ "stack_calls", STACK_CALL_KERNEL },
+	};
+	const std::pair<const char*, ENGINE> engines[] = {
+		{ "instr", ENGINE::INSTR },
+		{ "switch", ENGINE::SWITCH },
+		{ "threaded", ENGINE::THREADED },
+	};
+	for (const auto& kernel : kernels) {
+		for (const auto& engine : engines) {
+			const char* source = kernel.second;
+			ENGINE engine_type = engine.second;
+			benchmark::RegisterBenchmark((std::string("BM_Kernel/") + kernel.first + "/" + engine.first).c_str(), [source, engine_type](benchmark::State& state) {
+				BM_Kernel(state, source, engine_type);
+			})->Unit(benchmark::kMillisecond);
+		}
+	}
+
+	benchmark::RegisterBenchmark("BM_Reset/rebuild", [](benchmark::State& state) {
+		BM_Reset(state, false);
+	})->Unit(benchmark::kMicrosecond);
+	benchmark::RegisterBenchmark("BM_Reset/restore", [](benchmark::State& state) {
+		BM_Reset(state, true);
+	})->Unit(benchmark::kMicrosecond);
+
+	benchmark::internal::Benchmark* batch = benchmark::RegisterBenchmark("BM_Batch", BM_Batch);
+	batch->ArgName("threads")->Unit(benchmark::kMillisecond)->UseRealTime();
+	for (int thread_count = 1; thread_count <= max_threads; thread_count *= 2) {
+		batch->Arg(thread_count);
+	}
+}
+
+/*!
+\brief Замеряет токенизацию, трансляцию, запуск и выполнение программ
+
+Принимает параметры Google Benchmark, например --benchmark_filter=BM_Kernel.
+Если файл результатов не указан параметром --benchmark_out, результаты
+дополнительно записываются в формате JSON в файл DEFAULT_JSON_OUTPUT
+*/
+int main(int argc, char** argv) {
+	std::vector<char*> args(argv, argv + argc);
+
+	bool has_output = std::any_of(args.begin(), args.end(), [](const char* arg) {
+		return std::string_view(arg).substr(0, 16) == "--benchmark_out=";
+	});
+
+	std::string output_arg = std::string("--benchmark_out=") + DEFAULT_JSON_OUTPUT;
+	std::string format_arg = "--benchmark_out_format=json";
+	if (!has_output) {
+		args.push_back(output_arg.data());
+		args.push_back(format_arg.data());
+	}
+
+	int arg_count = args.size();
+	benchmark::Initialize(&arg_count, args.data());
+	if (benchmark::ReportUnrecognizedArguments(arg_count, args.data())) {
+		return 1;
+	}
+
+	register_benchmarks();
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+
+	return 0;
+}
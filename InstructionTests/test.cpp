@@ -1,7 +1,25 @@
+#include <sstream>
+#include <fstream>
+#include <cstdio>
+#include <climits>
+#include <filesystem>
+#include <utility>
+
 #include "pch.h"
 
 #include "../KNPO-Molchanov-PrIn-266/Instruction.h"
 #include "../KNPO-Molchanov-PrIn-266/ProgramState.h"
+#include "../KNPO-Molchanov-PrIn-266/Bytecode.h"
+#include "../KNPO-Molchanov-PrIn-266/BytecodeEngine.h"
+#include "../KNPO-Molchanov-PrIn-266/Fusion.h"
+#include "../KNPO-Molchanov-PrIn-266/Builtins.h"
+#include "../KNPO-Molchanov-PrIn-266/OutputBuffer.h"
+#include "../KNPO-Molchanov-PrIn-266/Profiler.h"
+#include "../KNPO-Molchanov-PrIn-266/BatchRunner.h"
+#include "../KNPO-Molchanov-PrIn-266/IoPort.h"
+#include "../KNPO-Molchanov-PrIn-266/ProgramImage.h"
+#include "../KNPO-Molchanov-PrIn-266/Program.h"
+#include "../KNPO-Molchanov-PrIn-266/TranslationCache.h"
 
 
 TEST(InstructionTests, AddRegInstruction) {
@@ -161,6 +179,105 @@ TEST(InstructionTests, ShlImmInstruction) {
 	ASSERT_EQ(state.get_register_value(REGISTER::R0), 32);
 }
 
+TEST(InstructionTests, MulRegInstruction) {
+	ProgramState state(1);
+	state.set_register_value(REGISTER::R0, -6);
+	state.set_register_value(REGISTER::R1, 7);
+
+	MulRegInstr instr{ REGISTER::R0, REGISTER::R1 };
+	instr.execute(state);
+
+	ASSERT_EQ(state.get_register_value(REGISTER::R0), -42);
+}
+
+TEST(InstructionTests, MulImmInstruction) {
+	ProgramState state(1);
+	state.set_register_value(REGISTER::R0, 12);
+
+	MulImmInstr instr{ REGISTER::R0, 3 };
+	instr.execute(state);
+
+	ASSERT_EQ(state.get_register_value(REGISTER::R0), 36);
+}
+
+TEST(InstructionTests, DivRegInstruction) {
+	ProgramState state(1);
+	state.set_register_value(REGISTER::R0, -7);
+	state.set_register_value(REGISTER::R1, 2);
+
+	DivRegInstr instr{ REGISTER::R0, REGISTER::R1 };
+	instr.execute(state);
+
+	ASSERT_EQ(state.get_register_value(REGISTER::R0), -3);
+}
+
+TEST(InstructionTests, DivImmInstruction) {
+	ProgramState state(1);
+	state.set_register_value(REGISTER::R0, 100);
+
+	DivImmInstr instr{ REGISTER::R0, 7 };
+	instr.execute(state);
+
+	ASSERT_EQ(state.get_register_value(REGISTER::R0), 14);
+}
+
+TEST(InstructionTests, ModRegInstruction) {
+	ProgramState state(1);
+	state.set_register_value(REGISTER::R0, -7);
+	state.set_register_value(REGISTER::R1, 2);
+
+	ModRegInstr instr{ REGISTER::R0, REGISTER::R1 };
+	instr.execute(state);
+
+	ASSERT_EQ(state.get_register_value(REGISTER::R0), -1);
+}
+
+TEST(InstructionTests, ModImmInstruction) {
+	ProgramState state(1);
+	state.set_register_value(REGISTER::R0, 100);
+
+	ModImmInstr instr{ REGISTER::R0, 7 };
+	instr.execute(state);
+
+	ASSERT_EQ(state.get_register_value(REGISTER::R0), 2);
+}
+
+TEST(InstructionTests, DivisionByZero) {
+	ProgramState state(1);
+	state.set_register_value(REGISTER::R0, 5);
+
+	EXPECT_THROW(DivRegInstr(REGISTER::R0, REGISTER::R1).execute(state), RuntimeError);
+	EXPECT_THROW(DivImmInstr(REGISTER::R0, 0).execute(state), RuntimeError);
+	EXPECT_THROW(ModRegInstr(REGISTER::R0, REGISTER::R1).execute(state), RuntimeError);
+	EXPECT_THROW(ModImmInstr(REGISTER::R0, 0).execute(state), RuntimeError);
+	EXPECT_EQ(state.get_register_value(REGISTER::R0), 5);
+	EXPECT_EQ(state.get_pc(), 0);
+
+	Bytecode bytecode;
+	SetImmInstr{ REGISTER::R0, 5 }.emit(bytecode);
+	ModRegInstr{ REGISTER::R0, REGISTER::R1 }.emit(bytecode);
+
+	for (DISPATCH dispatch : { DISPATCH::SWITCH, DISPATCH::THREADED }) {
+		ProgramState bytecode_state(bytecode.size());
+		BytecodeEngine engine(dispatch);
+
+		ASSERT_THROW(engine.execute(bytecode, bytecode_state), RuntimeError);
+		EXPECT_EQ(bytecode_state.get_pc(), 1);
+	}
+}
+
+TEST(InstructionTests, DivisionOverflowWraps) {
+	ProgramState state(1);
+	state.set_register_value(REGISTER::R0, INT_MIN);
+	state.set_register_value(REGISTER::R1, INT_MIN);
+
+	DivImmInstr{ REGISTER::R0, -1 }.execute(state);
+	ModImmInstr{ REGISTER::R1, -1 }.execute(state);
+
+	EXPECT_EQ(state.get_register_value(REGISTER::R0), INT_MIN);
+	EXPECT_EQ(state.get_register_value(REGISTER::R1), 0);
+}
+
 TEST(InstructionTests, SetImmInstruction) {
 	ProgramState state(1);
 
@@ -205,13 +322,15 @@ TEST(InstructionTests, LdInstruction) {
 
 TEST(InstructionTests, StInstruction) {
 	ProgramState state(1);
-	state.set_register_value(REGISTER::R0, 0);
+	state.set_register_value(REGISTER::R0, 42);
 	state.allocate_memory("age", { 17 });
+	int address = state.get_address_of_data_label("age");
 
 	StInstr instr{ "age", REGISTER::R0 };
 	instr.execute(state);
 
-	ASSERT_EQ(state.get_memory_value_by_name("age"), 17);
+	ASSERT_EQ(state.get_memory_value_by_name("age"), 42);
+	ASSERT_EQ(state.get_address_of_data_label("age"), address);
 }
 
 TEST(InstructionTests, LdiInstruction) {
@@ -237,11 +356,217 @@ TEST(InstructionTests, StiInstruction) {
 	ASSERT_EQ(state.get_memory_value(0), 12);
 }
 
+TEST(InstructionTests, LdiOffsetInstruction) {
+	ProgramState state(1);
+	state.set_register_value(REGISTER::R1, 1);
+	state.allocate_memory("ages", { 18, 20, 22 });
+
+	LdiOffsetInstr instr{ REGISTER::R0, REGISTER::R1, 1 };
+	instr.execute(state);
+
+	ASSERT_EQ(state.get_register_value(REGISTER::R0), 22);
+}
+
+TEST(InstructionTests, LdiIndexInstruction) {
+	ProgramState state(1);
+	state.set_register_value(REGISTER::R1, 2);
+	state.set_register_value(REGISTER::R2, -1);
+	state.allocate_memory("ages", { 18, 20, 22 });
+
+	LdiIndexInstr instr{ REGISTER::R0, REGISTER::R1, REGISTER::R2 };
+	instr.execute(state);
+
+	ASSERT_EQ(state.get_register_value(REGISTER::R0), 20);
+}
+
+TEST(InstructionTests, StiOffsetInstruction) {
+	ProgramState state(1);
+	state.set_register_value(REGISTER::R0, 3);
+	state.set_register_value(REGISTER::R1, 12);
+
+	StiOffsetInstr instr{ REGISTER::R0, -2, REGISTER::R1 };
+	instr.execute(state);
+
+	ASSERT_EQ(state.get_memory_value(1), 12);
+}
+
+TEST(InstructionTests, StiIndexInstruction) {
+	ProgramState state(1);
+	state.set_register_value(REGISTER::R0, 3);
+	state.set_register_value(REGISTER::R1, 4);
+	state.set_register_value(REGISTER::R2, 12);
+
+	StiIndexInstr instr{ REGISTER::R0, REGISTER::R1, REGISTER::R2 };
+	instr.execute(state);
+
+	ASSERT_EQ(state.get_memory_value(7), 12);
+}
+
+TEST(InstructionTests, BytecodeIndexedAddressing) {
+	Bytecode bytecode;
+
+	// memory[r0 + r1] = memory[r0 + 1] + 5; memory[r0 + 2] = memory[r0 + r1];
+	// последнее чтение по адресу r0 - 11 выходит за пределы памяти
+	SetImmInstr{ REGISTER::R0, 10 }.emit(bytecode);
+	SetImmInstr{ REGISTER::R1, 3 }.emit(bytecode);
+	LdiOffsetInstr{ REGISTER::R2, REGISTER::R0, 1 }.emit(bytecode);
+	AddImmInstr{ REGISTER::R2, 5 }.emit(bytecode);
+	StiIndexInstr{ REGISTER::R0, REGISTER::R1, REGISTER::R2 }.emit(bytecode);
+	LdiIndexInstr{ REGISTER::R3, REGISTER::R0, REGISTER::R1 }.emit(bytecode);
+	StiOffsetInstr{ REGISTER::R0, 2, REGISTER::R3 }.emit(bytecode);
+	LdiOffsetInstr{ REGISTER::R4, REGISTER::R0, -11 }.emit(bytecode);
+
+	for (DISPATCH dispatch : { DISPATCH::SWITCH, DISPATCH::THREADED }) {
+		ProgramState state(bytecode.size());
+		state.set_memory_value(11, 37);
+		BytecodeEngine engine(dispatch);
+
+		ASSERT_THROW(engine.execute(bytecode, state), RuntimeError);
+		EXPECT_EQ(state.get_pc(), 7);
+		EXPECT_EQ(state.get_memory_value(13), 42);
+		EXPECT_EQ(state.get_register_value(REGISTER::R3), 42);
+		EXPECT_EQ(state.get_memory_value(12), 42);
+	}
+}
+
+TEST(InstructionTests, PushPopInstruction) {
+	ProgramState state(1, 16, MEMORY_MODE::FIXED, 4);
+	state.allocate_memory("data", { 1, 2 });
+	state.set_register_value(REGISTER::R0, 10);
+	state.set_register_value(REGISTER::R1, 20);
+
+	// Сегмент стека размещается за уже размещенными данными при первом обращении
+	PushInstr{ REGISTER::R0 }.execute(state);
+	PushInstr{ REGISTER::R1 }.execute(state);
+	EXPECT_EQ(state.get_stack_base(), 2);
+	EXPECT_EQ(state.get_register_value(REGISTER::SP), 4);
+	EXPECT_EQ(state.get_memory_value(4), 20);
+
+	PopInstr{ REGISTER::R2 }.execute(state);
+	PopInstr{ REGISTER::R3 }.execute(state);
+	EXPECT_EQ(state.get_register_value(REGISTER::R2), 20);
+	EXPECT_EQ(state.get_register_value(REGISTER::R3), 10);
+	EXPECT_EQ(state.get_register_value(REGISTER::SP), 6);
+	EXPECT_EQ(state.get_pc(), 4);
+
+	// Данные, размещенные после стека, его не перекрывают
+	state.allocate_memory("extra", { 3 });
+	EXPECT_EQ(state.get_address_of_data_label("extra"), 6);
+}
+
+TEST(InstructionTests, StackErrors) {
+	ProgramState state(1, 16, MEMORY_MODE::FIXED, 2);
+	EXPECT_THROW(state.pop(), RuntimeError);
+
+	state.push(1);
+	state.push(2);
+	EXPECT_THROW(state.push(3), RuntimeError);
+	EXPECT_EQ(state.get_register_value(REGISTER::SP), 0);
+
+	EXPECT_EQ(state.pop(), 2);
+	EXPECT_EQ(state.pop(), 1);
+	EXPECT_THROW(state.pop(), RuntimeError);
+
+	// Указатель стека, измененный программой, проверяется при каждом обращении
+	state.set_register_value(REGISTER::SP, 10);
+	EXPECT_THROW(state.push(4), RuntimeError);
+	EXPECT_THROW(state.pop(), RuntimeError);
+
+	EXPECT_THROW(ProgramState(1, 4, MEMORY_MODE::FIXED, 5).push(1), RuntimeError);
+}
+
+TEST(InstructionTests, BytecodeRecursionWithStack) {
+	Bytecode bytecode;
+
+	// Рекурсивный факториал: r0 = 5; call fact; jmp end;
+	// fact: jle base, r0, 1; push r0; sub r0, 1; call fact; pop r1; mul r1, r2; set r2, r1; ret;
+	// base: set r2, 1; ret; end:
+	SetImmInstr{ REGISTER::R0, 5 }.emit(bytecode);
+	CallInstr call_instr{ "fact" };
+	call_instr.set_address(3);
+	call_instr.emit(bytecode);
+	JmpInstr jmp_instr{ "end" };
+	jmp_instr.set_address(13);
+	jmp_instr.emit(bytecode);
+	JleImmInstr jle_instr{ "base", REGISTER::R0, 1 };
+	jle_instr.set_address(11);
+	jle_instr.emit(bytecode);
+	PushInstr{ REGISTER::R0 }.emit(bytecode);
+	SubImmInstr{ REGISTER::R0, 1 }.emit(bytecode);
+	CallInstr rec_instr{ "fact" };
+	rec_instr.set_address(3);
+	rec_instr.emit(bytecode);
+	PopInstr{ REGISTER::R1 }.emit(bytecode);
+	MulRegInstr{ REGISTER::R1, REGISTER::R2 }.emit(bytecode);
+	SetRegInstr{ REGISTER::R2, REGISTER::R1 }.emit(bytecode);
+	RetInstr{}.emit(bytecode);
+	SetImmInstr{ REGISTER::R2, 1 }.emit(bytecode);
+	RetInstr{}.emit(bytecode);
+
+	for (DISPATCH dispatch : { DISPATCH::SWITCH, DISPATCH::THREADED }) {
+		ProgramState state(bytecode.size(), 64, MEMORY_MODE::FIXED, 8);
+		BytecodeEngine engine(dispatch);
+		engine.execute(bytecode, state);
+
+		EXPECT_EQ(state.get_register_value(REGISTER::R2), 120);
+		EXPECT_EQ(state.get_register_value(REGISTER::SP), state.get_stack_base() + 8);
+		EXPECT_EQ(state.get_pc(), 13);
+
+		ProgramState small_state(bytecode.size(), 64, MEMORY_MODE::FIXED, 3);
+		ASSERT_THROW(engine.execute(bytecode, small_state), RuntimeError);
+		EXPECT_EQ(small_state.get_pc(), 4);
+	}
+}
+
+TEST(InstructionTests, ProgramStateAllocatesStackOnFirstPush) {
+	TranslatedProgram translated;
+	translated.instrs = { std::make_shared<PushInstr>(REGISTER::R0) };
+	translated.memory_image = { 1, 2, 3 };
+	const Program program(std::move(translated));
+
+	// Сегмент стека размещается за данными, размещенными к первому обращению к стеку
+	ProgramState state(program, 16, MEMORY_MODE::FIXED, 8);
+	EXPECT_EQ(state.get_stack_base(), -1);
+	EXPECT_EQ(state.allocate_string("ab"), 3);
+	program.get_instrs()[0]->execute(state);
+	EXPECT_EQ(state.get_stack_base(), 5);
+	EXPECT_EQ(state.get_register_value(REGISTER::SP), 12);
+	EXPECT_EQ(state.allocate_string("a"), 13);
+
+	// Если сегмент стека не помещается в память, ошибка возникает при обращении к стеку
+	ProgramState small_state(program, 10, MEMORY_MODE::FIXED, 8);
+	EXPECT_THROW(program.get_instrs()[0]->execute(small_state), RuntimeError);
+	EXPECT_EQ(small_state.get_pc(), 0);
+}
+
+TEST(InstructionTests, ProgramWithoutStackUsesAllMemory) {
+	// Программа почти заполняет память по умолчанию данными и не использует стек
+	TranslatedProgram translated;
+	translated.instrs = {
+		std::make_shared<SetNameInstr>(REGISTER::R0, "big"),
+		std::make_shared<AddImmInstr>(REGISTER::R0, 1),
+	};
+	std::static_pointer_cast<DataAccessInstr>(translated.instrs[0])->set_data_address(0);
+	translated.data_addresses = { { "big", 0 } };
+	translated.memory_image.assign(DEFAULT_MEMORY_SIZE - 200, 6);
+	const Program program(std::move(translated));
+
+	ProgramState state(program);
+	while (state.is_running()) {
+		program.get_instrs()[state.get_pc()]->execute(state);
+	}
+	EXPECT_EQ(state.get_register_value(REGISTER::R0), 7);
+	EXPECT_EQ(state.get_stack_base(), -1);
+
+	// Оставшаяся память целиком доступна для строк, прочитанных при выполнении
+	EXPECT_EQ(state.allocate_string(std::string(199, 'a')), DEFAULT_MEMORY_SIZE - 200);
+}
+
 TEST(InstructionTests, JmpInstruction) {
 	ProgramState state(1);
-	state.add_label("loop", 12);
 
 	JmpInstr instr{ "loop" };
+	instr.set_address(12);
 	instr.execute(state);
 
 	ASSERT_EQ(state.get_pc(), 12);
@@ -249,12 +574,12 @@ TEST(InstructionTests, JmpInstruction) {
 
 TEST(InstructionTests, JeqInstructionJumps) {
 	ProgramState state(1);
-	state.add_label("loop", 12);
 
 	state.set_register_value(REGISTER::R0, 10);
 	state.set_register_value(REGISTER::R1, 10);
 
 	JeqInstr instr{ "loop", REGISTER::R0, REGISTER::R1 };
+	instr.set_address(12);
 	instr.execute(state);
 
 	ASSERT_EQ(state.get_pc(), 12);
@@ -262,12 +587,12 @@ TEST(InstructionTests, JeqInstructionJumps) {
 
 TEST(InstructionTests, JeqInstructionDoesntJump) {
 	ProgramState state(1);
-	state.add_label("loop", 12);
 
 	state.set_register_value(REGISTER::R0, 9);
 	state.set_register_value(REGISTER::R1, 10);
 
 	JeqInstr instr{ "loop", REGISTER::R0, REGISTER::R1 };
+	instr.set_address(12);
 	instr.execute(state);
 
 	ASSERT_EQ(state.get_pc(), 1);
@@ -275,12 +600,12 @@ TEST(InstructionTests, JeqInstructionDoesntJump) {
 
 TEST(InstructionTests, JgtInstructionJumps) {
 	ProgramState state(1);
-	state.add_label("loop", 15);
 
 	state.set_register_value(REGISTER::R0, 14);
 	state.set_register_value(REGISTER::R1, 10);
 
 	JgtInstr instr{ "loop", REGISTER::R0, REGISTER::R1 };
+	instr.set_address(15);
 	instr.execute(state);
 
 	ASSERT_EQ(state.get_pc(), 15);
@@ -288,22 +613,99 @@ TEST(InstructionTests, JgtInstructionJumps) {
 
 TEST(InstructionTests, JgtInstructionDoesntJump) {
 	ProgramState state(1);
-	state.add_label("loop", 15);
 
 	state.set_register_value(REGISTER::R0, 10);
 	state.set_register_value(REGISTER::R1, 14);
 
 	JgtInstr instr{ "loop", REGISTER::R0, REGISTER::R1 };
+	instr.set_address(15);
 	instr.execute(state);
 
 	ASSERT_EQ(state.get_pc(), 1);
 }
 
+TEST(InstructionTests, ComparisonBranches) {
+	// Для каждой пары значений: переходят ли jeq, jne, jgt, jlt, jge, jle
+	const std::pair<std::pair<int, int>, std::vector<bool>> test_data[] = {
+		{ { 3, 3 }, { true, false, false, false, true, true } },
+		{ { 4, 3 }, { false, true, true, false, true, false } },
+		{ { -5, 3 }, { false, true, false, true, false, true } },
+	};
+
+	for (const auto& test : test_data) {
+		int a = test.first.first;
+		int b = test.first.second;
+
+		ProgramState state(1);
+		state.set_register_value(REGISTER::R0, a);
+		state.set_register_value(REGISTER::R1, b);
+
+		std::vector<std::shared_ptr<BranchInstr>> reg_instrs = {
+			std::make_shared<JeqInstr>("label", REGISTER::R0, REGISTER::R1),
+			std::make_shared<JneInstr>("label", REGISTER::R0, REGISTER::R1),
+			std::make_shared<JgtInstr>("label", REGISTER::R0, REGISTER::R1),
+			std::make_shared<JltInstr>("label", REGISTER::R0, REGISTER::R1),
+			std::make_shared<JgeInstr>("label", REGISTER::R0, REGISTER::R1),
+			std::make_shared<JleInstr>("label", REGISTER::R0, REGISTER::R1),
+		};
+		std::vector<std::shared_ptr<BranchInstr>> imm_instrs = {
+			std::make_shared<JeqImmInstr>("label", REGISTER::R0, b),
+			std::make_shared<JneImmInstr>("label", REGISTER::R0, b),
+			std::make_shared<JgtImmInstr>("label", REGISTER::R0, b),
+			std::make_shared<JltImmInstr>("label", REGISTER::R0, b),
+			std::make_shared<JgeImmInstr>("label", REGISTER::R0, b),
+			std::make_shared<JleImmInstr>("label", REGISTER::R0, b),
+		};
+
+		for (int i = 0; i < test.second.size(); i++) {
+			for (const auto& instr : { reg_instrs[i], imm_instrs[i] }) {
+				instr->set_address(12);
+				state.set_pc(0);
+				instr->execute(state);
+				EXPECT_EQ(state.get_pc(), test.second[i] ? 12 : 1) << a << ", " << b << ", " << i;
+			}
+		}
+	}
+}
+
+TEST(InstructionTests, BytecodeComparisonBranches) {
+	Bytecode bytecode;
+
+	// r0 = 0; r1 = 0; loop: r1 += r0; r0 += 1; jlt loop, r0, 10;
+	// jne skip, r1, 45; r2 = 1; skip: jge end, r1, r0; r2 = 2; end:
+	SetImmInstr{ REGISTER::R0, 0 }.emit(bytecode);
+	SetImmInstr{ REGISTER::R1, 0 }.emit(bytecode);
+	AddRegInstr{ REGISTER::R1, REGISTER::R0 }.emit(bytecode);
+	AddImmInstr{ REGISTER::R0, 1 }.emit(bytecode);
+	JltImmInstr jlt_instr{ "loop", REGISTER::R0, 10 };
+	jlt_instr.set_address(2);
+	jlt_instr.emit(bytecode);
+	JneImmInstr jne_instr{ "skip", REGISTER::R1, 45 };
+	jne_instr.set_address(7);
+	jne_instr.emit(bytecode);
+	SetImmInstr{ REGISTER::R2, 1 }.emit(bytecode);
+	JgeInstr jge_instr{ "end", REGISTER::R1, REGISTER::R0 };
+	jge_instr.set_address(9);
+	jge_instr.emit(bytecode);
+	SetImmInstr{ REGISTER::R2, 2 }.emit(bytecode);
+
+	for (DISPATCH dispatch : { DISPATCH::SWITCH, DISPATCH::THREADED }) {
+		ProgramState state(bytecode.size());
+		BytecodeEngine engine(dispatch);
+		engine.execute(bytecode, state);
+
+		EXPECT_EQ(state.get_register_value(REGISTER::R0), 10);
+		EXPECT_EQ(state.get_register_value(REGISTER::R1), 45);
+		EXPECT_EQ(state.get_register_value(REGISTER::R2), 1);
+		EXPECT_EQ(state.get_pc(), 9);
+	}
+}
+
 TEST(InstructionTests, CallInstruction) {
 	ProgramState state(1);
-	state.add_label("func", 15);
 
 	CallInstr instr{ "func" };
+	instr.set_address(15);
 	instr.execute(state);
 
 	ASSERT_EQ(state.get_pc(), 15);
@@ -318,4 +720,586 @@ TEST(InstructionTests, RetInstruction) {
 	instr.execute(state);
 
 	ASSERT_EQ(state.get_pc(), 1);
-}
\ No newline at end of file
+}
+
+TEST(InstructionTests, EmitBytecode) {
+	Bytecode bytecode;
+
+	AddImmInstr instr{ REGISTER::R3, -7 };
+	instr.set_line_number(4);
+	instr.emit(bytecode);
+
+	ASSERT_EQ(bytecode.size(), 1);
+	EXPECT_EQ(bytecode.get_instrs()[0].opcode, OPCODE::ADD_IMM);
+	EXPECT_EQ(bytecode.get_instrs()[0].dest, (uint8_t)REGISTER::R3);
+	EXPECT_EQ(bytecode.get_instrs()[0].imm_value, -7);
+	EXPECT_EQ(bytecode.get_line_number(0), 4);
+}
+
+TEST(InstructionTests, BytecodeEngineLoop) {
+	Bytecode bytecode;
+
+	// r0 = 5; r1 = 0; loop: r1 += r0; r0 -= 1; jgt loop, r0, r2
+	SetImmInstr{ REGISTER::R0, 5 }.emit(bytecode);
+	SetImmInstr{ REGISTER::R1, 0 }.emit(bytecode);
+	AddRegInstr{ REGISTER::R1, REGISTER::R0 }.emit(bytecode);
+	SubImmInstr{ REGISTER::R0, 1 }.emit(bytecode);
+	JgtInstr jgt_instr{ "loop", REGISTER::R0, REGISTER::R2 };
+	jgt_instr.set_address(2);
+	jgt_instr.emit(bytecode);
+
+	for (DISPATCH dispatch : { DISPATCH::SWITCH, DISPATCH::THREADED }) {
+		ProgramState state(bytecode.size());
+		BytecodeEngine engine(dispatch);
+		engine.execute(bytecode, state);
+
+		EXPECT_EQ(state.get_register_value(REGISTER::R0), 0);
+		EXPECT_EQ(state.get_register_value(REGISTER::R1), 15);
+		EXPECT_EQ(state.get_pc(), 5);
+	}
+}
+
+TEST(InstructionTests, BytecodeEngineRuntimeError) {
+	Bytecode bytecode;
+
+	SetImmInstr{ REGISTER::R0, -1 }.emit(bytecode);
+	LdiInstr{ REGISTER::R1, REGISTER::R0 }.emit(bytecode);
+
+	for (DISPATCH dispatch : { DISPATCH::SWITCH, DISPATCH::THREADED }) {
+		ProgramState state(bytecode.size());
+		BytecodeEngine engine(dispatch);
+
+		ASSERT_THROW(engine.execute(bytecode, state), RuntimeError);
+		EXPECT_EQ(state.get_pc(), 1);
+	}
+}
+
+TEST(InstructionTests, FusionDecrementAndBranch) {
+	Bytecode bytecode;
+
+	// r0 = 5; r1 = 0; loop: r1 += r0; r0 -= 1; jgt loop, r0, r2
+	SetImmInstr{ REGISTER::R0, 5 }.emit(bytecode);
+	SetImmInstr{ REGISTER::R1, 0 }.emit(bytecode);
+	AddRegInstr{ REGISTER::R1, REGISTER::R0 }.emit(bytecode);
+	SubImmInstr{ REGISTER::R0, 1 }.emit(bytecode);
+	JgtInstr jgt_instr{ "loop", REGISTER::R0, REGISTER::R2 };
+	jgt_instr.set_address(2);
+	jgt_instr.emit(bytecode);
+
+	std::vector<Fusion> fusions;
+	FusionPass fusion_pass;
+	fusion_pass.apply(bytecode, fusions);
+
+	ASSERT_EQ(fusions.size(), 1);
+	EXPECT_EQ(fusions[0].address, 3);
+	EXPECT_EQ(fusions[0].length, 2);
+	EXPECT_EQ(bytecode.size(), 5);
+	EXPECT_EQ(bytecode.get_instr(3).opcode, OPCODE::SUB_IMM_JGT);
+
+	for (DISPATCH dispatch : { DISPATCH::SWITCH, DISPATCH::THREADED }) {
+		ProgramState state(bytecode.size());
+		BytecodeEngine engine(dispatch);
+		engine.execute(bytecode, state);
+
+		EXPECT_EQ(state.get_register_value(REGISTER::R0), 0);
+		EXPECT_EQ(state.get_register_value(REGISTER::R1), 15);
+		EXPECT_EQ(state.get_pc(), 5);
+	}
+}
+
+TEST(InstructionTests, FusionReadModifyWrite) {
+	Bytecode bytecode;
+
+	// r1 = 100; memory[r1] = 7; r0 = memory[r1]; r0 += 3; memory[r1] = r0
+	SetImmInstr{ REGISTER::R1, 100 }.emit(bytecode);
+	SetImmInstr{ REGISTER::R2, 7 }.emit(bytecode);
+	StiInstr{ REGISTER::R1, REGISTER::R2 }.emit(bytecode);
+	LdiInstr{ REGISTER::R0, REGISTER::R1 }.emit(bytecode);
+	AddImmInstr{ REGISTER::R0, 3 }.emit(bytecode);
+	StiInstr{ REGISTER::R1, REGISTER::R0 }.emit(bytecode);
+
+	std::vector<Fusion> fusions;
+	FusionPass fusion_pass;
+	fusion_pass.apply(bytecode, fusions);
+
+	ASSERT_EQ(fusions.size(), 1);
+	EXPECT_EQ(bytecode.get_instr(3).opcode, OPCODE::LDI_ADD_IMM_STI);
+
+	ProgramState state(bytecode.size());
+	BytecodeEngine engine;
+	engine.execute(bytecode, state);
+
+	EXPECT_EQ(state.get_register_value(REGISTER::R0), 10);
+	EXPECT_EQ(state.get_memory_value(100), 10);
+}
+
+TEST(InstructionTests, FusionRuntimeErrorPointsToFusedInstruction) {
+	Bytecode bytecode;
+
+	// Строка "text" занимает всю память и не заканчивается нулем, поэтому ошибку вызывает "call puts"
+	std::vector<int> text(DEFAULT_MEMORY_SIZE, 'a');
+	DataInstr data_instr{ "text", text };
+	data_instr.set_data_address(0);
+	data_instr.emit(bytecode);
+	LdInstr ld_instr{ REGISTER::R0, "text" };
+	ld_instr.set_line_number(2);
+	ld_instr.set_data_address(0);
+	ld_instr.emit(bytecode);
+	CallInstr call_instr{ "puts" };
+	call_instr.set_line_number(3);
+	call_instr.emit(bytecode);
+
+	std::vector<Fusion> fusions;
+	FusionPass fusion_pass;
+	fusion_pass.apply(bytecode, fusions);
+
+	ASSERT_EQ(fusions.size(), 1);
+	EXPECT_EQ(fusions[0].line_number, 2);
+
+	ProgramState state(bytecode.size());
+	state.load_memory_image(text, { { "text", 0 } });
+	BytecodeEngine engine;
+
+	ASSERT_THROW(engine.execute(bytecode, state), RuntimeError);
+	EXPECT_EQ(bytecode.get_line_number(state.get_pc()), 3);
+}
+
+TEST(InstructionTests, CustomBuiltinSubroutine) {
+	BuiltinRegistry::instance().add("twice", [](ProgramState& state) {
+		state.set_register_value(REGISTER::R0, state.get_register_value(REGISTER::R0) * 2);
+	});
+
+	CallInstr instr{ "twice" };
+	ASSERT_TRUE(instr.is_builtin());
+
+	ProgramState state(1);
+	state.set_register_value(REGISTER::R0, 21);
+	instr.execute(state);
+
+	EXPECT_EQ(state.get_register_value(REGISTER::R0), 42);
+	EXPECT_EQ(state.get_pc(), 1);
+
+	Bytecode bytecode;
+	instr.emit(bytecode);
+	EXPECT_EQ(bytecode.get_instr(0).opcode, OPCODE::CALL_BUILTIN);
+	EXPECT_EQ(bytecode.get_instr(0).imm_value, instr.get_builtin_id());
+}
+
+TEST(InstructionTests, OutputBufferModes) {
+	std::ostringstream stream;
+	StreamPort port(std::cin, stream);
+
+	OutputBuffer line_buffer(port, BUFFERING::LINE);
+	line_buffer.write(42);
+	EXPECT_EQ(stream.str(), "");
+	line_buffer.write('\n');
+	EXPECT_EQ(stream.str(), "42\n");
+
+	stream.str("");
+	OutputBuffer full_buffer(port, BUFFERING::FULL, 4);
+	full_buffer.write(std::string("ab\n"));
+	EXPECT_EQ(stream.str(), "");
+	full_buffer.write('c');
+	EXPECT_EQ(stream.str(), "ab\nc");
+
+	stream.str("");
+	{
+		OutputBuffer exit_buffer(port, BUFFERING::FULL);
+		exit_buffer.write(std::string("done"));
+		EXPECT_EQ(stream.str(), "");
+	}
+	EXPECT_EQ(stream.str(), "done");
+}
+
+TEST(InstructionTests, ProfilerCountsInstructionsAndCalls) {
+	BuiltinRegistry::instance().add("profiled", [](ProgramState& state) {
+	});
+
+	// r0 = 3; loop: call profiled; r0 -= 1; jgt loop, r0, r1
+	std::vector<std::shared_ptr<Instr>> instrs{
+		std::make_shared<SetImmInstr>(REGISTER::R0, 3),
+		std::make_shared<CallInstr>("profiled"),
+		std::make_shared<SubImmInstr>(REGISTER::R0, 1),
+		std::make_shared<JgtInstr>("loop", REGISTER::R0, REGISTER::R1),
+	};
+	dynamic_cast<JgtInstr*>(instrs[3].get())->set_address(1);
+	for (int i = 0; i < instrs.size(); i++) {
+		instrs[i]->set_line_number(i + 1);
+	}
+
+	ProgramState state(instrs.size());
+	Profiler profiler(instrs);
+	profiler.execute(instrs, state);
+	EXPECT_EQ(state.get_register_value(REGISTER::R0), 0);
+
+	std::ostringstream csv;
+	profiler.write_csv(csv);
+	EXPECT_NE(csv.str().find("instruction,0,1,"), std::string::npos);
+	EXPECT_NE(csv.str().find("line,2,3,"), std::string::npos);
+	EXPECT_NE(csv.str().find("line,4,3,"), std::string::npos);
+	EXPECT_NE(csv.str().find("builtin,profiled,3,"), std::string::npos);
+
+	std::ostringstream json;
+	profiler.write_json(json);
+	EXPECT_NE(json.str().find("{ \"name\": \"profiled\", \"calls\": 3,"), std::string::npos);
+}
+
+TEST(InstructionTests, BytecodeRejectsInvalidRegister) {
+	Bytecode bytecode;
+	AddRegInstr{ REGISTER::SP, REGISTER::R0 }.emit(bytecode);
+	EXPECT_EQ(bytecode.size(), 1);
+
+	EXPECT_THROW(bytecode.emit(BytecodeInstr{ OPCODE::ADD_REG, REGISTER_COUNT, 0, 0, 0, 0 }, 1), RuntimeError);
+	EXPECT_THROW(bytecode.replace(0, BytecodeInstr{ OPCODE::SET_REG, 0, 255, 0, 0, 0 }), RuntimeError);
+	EXPECT_EQ(bytecode.size(), 1);
+	EXPECT_EQ(bytecode.get_instr(0).opcode, OPCODE::ADD_REG);
+}
+
+TEST(InstructionTests, ConfigurableMemorySize) {
+	ProgramState state(0, 16);
+	EXPECT_EQ(state.get_memory_size(), 16);
+
+	state.set_memory_value(15, 7);
+	EXPECT_EQ(state.get_memory_value(15), 7);
+	EXPECT_THROW(state.set_memory_value(16, 7), RuntimeError);
+	EXPECT_THROW(state.get_memory_value(-1), RuntimeError);
+
+	EXPECT_THROW(state.load_memory_image(std::vector<int>(17, 0), {}), RuntimeError);
+	EXPECT_THROW(ProgramState(0, 0), RuntimeError);
+}
+
+TEST(InstructionTests, GrowableMemory) {
+	const int size = 16 * 1024 * 1024;
+	ProgramState state(0, size, MEMORY_MODE::GROWABLE);
+	EXPECT_EQ(state.get_memory_size(), size);
+
+	// Ни разу не записанные ячейки, в том числе далеко от начала памяти, равны нулю
+	EXPECT_EQ(state.get_memory_value(size - 1), 0);
+	state.set_memory_value(size - 1, 42);
+	state.set_memory_value(1000000, -5);
+	EXPECT_EQ(state.get_memory_value(size - 1), 42);
+	EXPECT_EQ(state.get_memory_value(1000000), -5);
+	EXPECT_EQ(state.get_memory_value(1000001), 0);
+	EXPECT_THROW(state.get_memory_value(size), RuntimeError);
+
+	state.load_memory_image({ 'h', 'i', 0 }, { { "text", 0 } });
+	std::string str;
+	state.extract_string(str, 0);
+	EXPECT_EQ(str, "hi");
+	EXPECT_EQ(state.get_data_value(1), 'i');
+}
+
+TEST(InstructionTests, SnapshotRestoresOnlyDirtyPages) {
+	ProgramState state(4, 8 * MEMORY_PAGE_SIZE);
+	state.add_label("start", 0);
+	state.load_memory_image({ 1, 2, 3 }, { { "data", 0 } });
+	state.set_register_value(REGISTER::R1, 10);
+	ProgramStateSnapshot initial = state.snapshot();
+	EXPECT_EQ(state.get_dirty_page_count(), 0);
+
+	for (int run = 0; run < 2; run++) {
+		state.set_register_value(REGISTER::R1, 20);
+		state.set_memory_value_by_name("data", 100);
+		state.set_memory_value(5 * MEMORY_PAGE_SIZE + 1, 7);
+		state.allocate_memory("extra", { 9 });
+		state.call_subroutine(2);
+		EXPECT_EQ(state.get_dirty_page_count(), 2);
+
+		state.restore(initial);
+		EXPECT_EQ(state.get_dirty_page_count(), 0);
+		EXPECT_EQ(state.get_register_value(REGISTER::R1), 10);
+		EXPECT_EQ(state.get_memory_value(0), 1);
+		EXPECT_EQ(state.get_memory_value(3), 0);
+		EXPECT_EQ(state.get_memory_value(5 * MEMORY_PAGE_SIZE + 1), 0);
+		EXPECT_EQ(state.get_pc(), 0);
+		EXPECT_EQ(state.get_label_address("start"), 0);
+		EXPECT_THROW(state.get_address_of_data_label("extra"), RuntimeError);
+		EXPECT_THROW(state.return_from_subroutine(), RuntimeError);
+	}
+
+	// Снимок, сделанный другим состоянием, восстанавливается целиком
+	ProgramState other(4, 8 * MEMORY_PAGE_SIZE, MEMORY_MODE::GROWABLE);
+	other.set_memory_value(7 * MEMORY_PAGE_SIZE, 3);
+	other.restore(initial);
+	EXPECT_EQ(other.get_memory_value(2), 3);
+	EXPECT_EQ(other.get_memory_value(7 * MEMORY_PAGE_SIZE), 0);
+	EXPECT_EQ(other.get_memory_value_by_name("data"), 1);
+	EXPECT_EQ(other.get_register_value(REGISTER::R1), 10);
+}
+
+TEST(InstructionTests, BatchRunnerRunsAreIndependent) {
+	// call geti; add r0, r1; set r1, r0; call puti; st total, r0
+	TranslatedProgram translated;
+	translated.instrs = {
+		std::make_shared<CallInstr>("geti"),
+		std::make_shared<AddRegInstr>(REGISTER::R0, REGISTER::R1),
+		std::make_shared<SetRegInstr>(REGISTER::R1, REGISTER::R0),
+		std::make_shared<CallInstr>("puti"),
+		std::make_shared<StInstr>("total", REGISTER::R0),
+	};
+	dynamic_cast<StInstr*>(translated.instrs[4].get())->set_data_address(0);
+	translated.data_addresses = { { "total", 0 } };
+	translated.memory_image = { 100 };
+	for (const auto& instr : translated.instrs) {
+		instr->emit(translated.bytecode);
+	}
+	const Program program(std::move(translated));
+
+	std::vector<BatchRun> runs(6);
+	for (int i = 0; i < runs.size(); i++) {
+		runs[i].input_file = "batch_input_" + std::to_string(i) + ".txt";
+		std::ofstream(runs[i].input_file) << i * 10;
+	}
+	runs.push_back(BatchRun{ "batch_input_missing.txt" });
+
+	for (ENGINE engine : { ENGINE::INSTR, ENGINE::THREADED }) {
+		InterpreterOptions options;
+		options.engine = engine;
+		BatchRunner batch_runner(program, options);
+		batch_runner.run(runs, 3);
+
+		// Каждый запуск начинается с начального состояния, поэтому регистр r1 не накапливает значения
+		for (int i = 0; i < 6; i++) {
+			EXPECT_EQ(runs[i].output, std::to_string(i * 10) + "\n");
+			EXPECT_FALSE(runs[i].failed);
+		}
+		EXPECT_EQ(runs[6].output, "Ошибка: файл \"batch_input_missing.txt\" не может быть открыт\n");
+		EXPECT_TRUE(runs[6].failed);
+	}
+
+	// Запуск, вывод которого не удалось записать, считается неудачным
+	std::vector<BatchRun> unwritable_runs = { BatchRun{ runs[0].input_file, "batch_missing_directory/out.txt" } };
+	BatchRunner(program, InterpreterOptions()).run(unwritable_runs, 1);
+	EXPECT_TRUE(unwritable_runs[0].failed);
+
+	for (int i = 0; i < 6; i++) {
+		std::remove(runs[i].input_file.c_str());
+	}
+}
+
+TEST(InstructionTests, ProgramIsSharedByStates) {
+	// loop: sub r0, 1; jgt loop, r0, r7; call finish; ret; finish: st total, r0 (ссылки по именам не разрешены)
+	TranslatedProgram translated;
+	translated.instrs = {
+		std::make_shared<SubImmInstr>(REGISTER::R0, 1),
+		std::make_shared<CallInstr>("finish"),
+		std::make_shared<StInstr>("total", REGISTER::R1),
+	};
+	for (int i = 0; i < translated.instrs.size(); i++) {
+		translated.instrs[i]->set_line_number(i + 3);
+	}
+	translated.labels = { { "finish", 2 } };
+	translated.data_addresses = { { "total", 1 } };
+	translated.memory_image = { 7, 8 };
+
+	const Program program(std::move(translated));
+	EXPECT_EQ(program.size(), 3);
+	EXPECT_EQ(program.get_line_number(2), 5);
+	EXPECT_TRUE(translated.labels.empty());
+
+	// Состояния не копируют таблицы программы и не влияют друг на друга
+	ProgramState first(program);
+	ProgramState second(program);
+	first.set_register_value(REGISTER::R1, 42);
+	while (first.is_running()) {
+		program.get_instrs()[first.get_pc()]->execute(first);
+	}
+
+	EXPECT_EQ(first.get_memory_value_by_name("total"), 42);
+	EXPECT_EQ(second.get_memory_value_by_name("total"), 8);
+	EXPECT_EQ(second.get_label_address("finish"), 2);
+	EXPECT_EQ(second.get_memory_value(0), 7);
+	EXPECT_THROW(second.get_label_address("missing"), RuntimeError);
+	EXPECT_THROW(second.allocate_memory("total", { 1 }), RuntimeError);
+
+	// Метки, объявленные при выполнении, хранятся в состоянии
+	second.add_label("extra", 1);
+	EXPECT_EQ(second.get_label_address("extra"), 1);
+	EXPECT_THROW(first.get_label_address("extra"), RuntimeError);
+}
+
+TEST(InstructionTests, ProgramDecodesThreadedCodeOnce) {
+	// set r0, 5; add r0, 2; st total, r0
+	TranslatedProgram translated;
+	translated.instrs = {
+		std::make_shared<SetImmInstr>(REGISTER::R0, 5),
+		std::make_shared<AddImmInstr>(REGISTER::R0, 2),
+		std::make_shared<StInstr>("total", REGISTER::R0),
+	};
+	dynamic_cast<StInstr*>(translated.instrs[2].get())->set_data_address(0);
+	translated.data_addresses = { { "total", 0 } };
+	translated.memory_image = { 0 };
+	for (const auto& instr : translated.instrs) {
+		instr->emit(translated.bytecode);
+	}
+	const Program program(std::move(translated));
+
+	if (BytecodeEngine::is_threaded_dispatch_supported()) {
+		ASSERT_EQ(program.get_threaded_code().size(), program.get_bytecode().size() + 1);
+	}
+	else {
+		EXPECT_TRUE(program.get_threaded_code().empty());
+	}
+
+	// Шитый код программы используется всеми запусками без повторного декодирования
+	const void* const* threaded_code = program.get_threaded_code().data();
+	for (DISPATCH dispatch : { DISPATCH::THREADED, DISPATCH::SWITCH, DISPATCH::THREADED }) {
+		ProgramState state(program);
+		BytecodeEngine(dispatch).execute(program, state);
+		EXPECT_EQ(state.get_memory_value_by_name("total"), 7);
+		EXPECT_EQ(state.get_pc(), 3);
+	}
+	EXPECT_EQ(program.get_threaded_code().data(), threaded_code);
+}
+
+TEST(InstructionTests, IoPortsReadLikeStreams) {
+	const char* input = "  x 42\n-17 99999999999\nsecond line\nlast";
+
+	std::istringstream stream(input);
+	std::ostringstream output;
+	StreamPort stream_port(stream, output);
+	StringPort string_port(input);
+
+	for (IoPort* port : { (IoPort*)&stream_port, (IoPort*)&string_port }) {
+		char ch;
+		int value;
+		std::string line;
+
+		EXPECT_TRUE(port->read_char(ch));
+		EXPECT_EQ(ch, 'x');
+		EXPECT_TRUE(port->read_int(value));
+		EXPECT_EQ(value, 42);
+		EXPECT_TRUE(port->read_line(line));
+		EXPECT_EQ(line, "");
+		EXPECT_TRUE(port->read_int(value));
+		EXPECT_EQ(value, -17);
+		port->read_int(value);
+		EXPECT_EQ(value, INT_MAX);
+	}
+
+	std::string line;
+	EXPECT_TRUE(string_port.read_line(line));
+	EXPECT_EQ(line, "");
+	EXPECT_TRUE(string_port.read_line(line));
+	EXPECT_EQ(line, "second line");
+	EXPECT_TRUE(string_port.read_line(line));
+	EXPECT_EQ(line, "last");
+	EXPECT_FALSE(string_port.read_line(line));
+
+	char ch;
+	EXPECT_FALSE(string_port.read_char(ch));
+	EXPECT_EQ(ch, '\0');
+}
+
+TEST(InstructionTests, BuiltinsUseInjectedIoPort) {
+	StringPort port("7\n");
+	ProgramState state(1);
+	state.set_io_port(port);
+
+	state.call_subroutine("geti");
+	state.set_register_value(REGISTER::R0, state.get_register_value(REGISTER::R0) * 2);
+	state.call_subroutine("puti");
+	state.get_output().flush();
+
+	EXPECT_EQ(port.get_output(), "14\n");
+}
+
+TEST(InstructionTests, ProgramImageRoundTrip) {
+	BuiltinRegistry::instance().add("imaged", [](ProgramState& state) {
+		state.set_register_value(REGISTER::R1, 5);
+	});
+
+	// loop: call imaged; sub r0, 1; jgt loop, r0, r2; st total, r1
+	TranslatedProgram program;
+	program.bytecode.emit(BytecodeInstr{ OPCODE::CALL_BUILTIN, 0, 0, 0, BuiltinRegistry::instance().find("imaged"), 0 }, 1);
+	program.bytecode.emit(BytecodeInstr{ OPCODE::SUB_IMM, 0, 0, 0, 1, 0 }, 2);
+	program.bytecode.emit(BytecodeInstr{ OPCODE::JGT, 0, 0, 2, 0, 0 }, 3);
+	program.bytecode.emit(BytecodeInstr{ OPCODE::ST, 0, 1, 0, 1, 0 }, 5);
+	program.labels = { { "loop", 0 } };
+	program.data_addresses = { { "text", 0 }, { "total", 1 } };
+	program.memory_image = { 'a', -7 };
+
+	std::ostringstream image;
+	ProgramImage::write(program, image);
+	std::string data = image.str();
+	ASSERT_TRUE(ProgramImage::is_image(data));
+
+	TranslatedProgram loaded;
+	ProgramImage::read(data, loaded);
+	ASSERT_EQ(loaded.size(), 4);
+	EXPECT_EQ(loaded.bytecode.get_instr(0).imm_value, BuiltinRegistry::instance().find("imaged"));
+	EXPECT_EQ(loaded.bytecode.get_instr(2).opcode, OPCODE::JGT);
+	EXPECT_EQ(loaded.bytecode.get_line_number(3), 5);
+	EXPECT_EQ(loaded.labels, program.labels);
+	EXPECT_EQ(loaded.data_addresses, program.data_addresses);
+	EXPECT_EQ(loaded.memory_image, program.memory_image);
+
+	ProgramState state(loaded.size());
+	state.set_register_value(REGISTER::R0, 3);
+	state.load_memory_image(loaded.memory_image, loaded.data_addresses);
+	BytecodeEngine engine;
+	engine.execute(loaded.bytecode, state);
+	EXPECT_EQ(state.get_memory_value_by_name("total"), 5);
+
+	// Повреждение содержимого, другая версия и переход за пределы программы обнаруживаются при загрузке
+	std::string corrupted = data;
+	corrupted[PROGRAM_IMAGE_HEADER_SIZE + 8] ^= 1;
+	TranslatedProgram rejected;
+	EXPECT_THROW(ProgramImage::read(corrupted, rejected), ImageError);
+
+	std::string other_version = data;
+	other_version[sizeof(PROGRAM_IMAGE_MAGIC)] ^= 1;
+	EXPECT_THROW(ProgramImage::read(other_version, rejected), ImageError);
+
+	EXPECT_THROW(ProgramImage::read(data.substr(0, data.size() - 1), rejected), ImageError);
+
+	TranslatedProgram bad_jump;
+	bad_jump.bytecode.emit(BytecodeInstr{ OPCODE::JMP, 0, 0, 0, 0, 2 }, 1);
+	std::ostringstream bad_image;
+	ProgramImage::write(bad_jump, bad_image);
+	EXPECT_THROW(ProgramImage::read(bad_image.str(), rejected), ImageError);
+}
+
+TEST(InstructionTests, TranslationCacheKeyedBySourceAndOptions) {
+	std::string directory = (std::filesystem::temp_directory_path() / "knpo-cache-test").string();
+	std::filesystem::remove_all(directory);
+	TranslationCache cache(directory);
+
+	InterpreterOptions options;
+	TranslatedProgram program;
+	program.bytecode.emit(BytecodeInstr{ OPCODE::ADD_IMM, 0, 0, 0, 7, 0 }, 1);
+	program.bytecode.emit(BytecodeInstr{ OPCODE::ST, 0, 0, 0, 0, 0 }, 2);
+	program.data_addresses = { { "x", 0 } };
+	program.memory_image = { 0 };
+
+	std::string source = "add r0, 7\nst x, r0\n";
+	TranslatedProgram loaded;
+	EXPECT_FALSE(cache.load(source, options, loaded));
+	ASSERT_TRUE(cache.store(source, options, program));
+	ASSERT_TRUE(cache.load(source, options, loaded));
+	EXPECT_EQ(loaded.size(), 2);
+	EXPECT_EQ(loaded.bytecode.get_instr(0).imm_value, 7);
+	EXPECT_EQ(loaded.data_addresses, program.data_addresses);
+
+	// Другой текст или другие параметры трансляции дают другую запись
+	TranslatedProgram missed;
+	EXPECT_FALSE(cache.load(source + " ", options, missed));
+	InterpreterOptions unfused = options;
+	unfused.fuse = false;
+	EXPECT_FALSE(cache.load(source, unfused, missed));
+	InterpreterOptions larger = options;
+	larger.memory_size = options.memory_size * 2;
+	EXPECT_FALSE(cache.load(source, larger, missed));
+
+	// Поврежденная запись считается отсутствующей
+	for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+		std::fstream entry_file(entry.path(), std::ios::in | std::ios::out | std::ios::binary);
+		entry_file.seekp(PROGRAM_IMAGE_HEADER_SIZE);
+		entry_file.put('\x7F');
+	}
+	TranslatedProgram corrupted;
+	EXPECT_FALSE(cache.load(source, options, corrupted));
+	EXPECT_EQ(corrupted.size(), 0);
+
+	std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,139 @@
+#include <string>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <fstream>
+#include <memory>
+#include <functional>
+#include <iostream>
+
+#include "BatchRunner.h"
+#include "BytecodeEngine.h"
+#include "SourceFile.h"
+#include "IoPort.h"
+
+
+/*!
+Конструктор пакетного исполнителя
+\param[in] program Оттранслированная программа. Если выполнение идет через байт-код, он уже должен быть записан
+\param[in] options Параметры интерпретатора
+*/
+BatchRunner::BatchRunner(const Program& program, const InterpreterOptions& options)
+	: program{ program }, options{ options } {
+}
+
+/*!
+Выполняет программу до завершения. Ошибка выполнения выводится в порт ввода-вывода состояния
+\param[in|out] state Состояние программы
+*/
+void BatchRunner::execute(ProgramState& state) const {
+	std::string error;
+
+	if (options.engine == ENGINE::INSTR) {
+		try {
+			while (state.is_running()) {
+				program.get_instrs().at(state.get_pc())->execute(state);
+			}
+		}
+		catch (RuntimeError& err) {
+			error = "Строка " + std::to_string(program.get_line_number(state.get_pc())) + ": " + err.what() + "\n";
+		}
+	}
+	else {
+		try {
+			BytecodeEngine bytecode_engine(options.engine == ENGINE::SWITCH ? DISPATCH::SWITCH : DISPATCH::THREADED);
+			bytecode_engine.execute(program, state);
+		}
+		catch (RuntimeError& err) {
+			error = "Строка " + std::to_string(program.get_line_number(state.get_pc())) + ": " + err.what() + "\n";
+		}
+	}
+
+	// Сообщение об ошибке должно следовать за уже напечатанным программой
+	state.get_output().flush();
+	state.get_io_port().write(error.data(), error.size());
+}
+
+/*!
+Выполняет запуски, пока они не закончатся. Ошибка записи файла вывода выводится в стандартный поток ошибок
+\param[in|out] runs Запуски
+\param[in|out] next_run Индекс следующего невыполненного запуска, общий для всех потоков
+*/
+void BatchRunner::run_worker(std::vector<BatchRun>& runs, std::atomic<int>& next_run) const {
+	// Порт объявлен до состояния программы, так как буфер вывода состояния ссылается на него до конца
+	StringPort port;
+	std::unique_ptr<ProgramState> state;
+	ProgramStateSnapshot initial;
+	std::string state_error;
+
+	try {
+		state = std::make_unique<ProgramState>(program, options.memory_size, options.memory_mode, options.stack_size);
+		state->set_io_port(port);
+		state->get_output().set_buffering(options.output_buffering, options.output_buffer_size);
+
+		initial = state->snapshot();
+	}
+	catch (RuntimeError& err) {
+		state_error = err.what();
+	}
+
+	for (int i = next_run++; i < runs.size(); i = next_run++) {
+		BatchRun& run = runs[i];
+
+		// Ввод запуска читается целиком, а вывод накапливается в памяти
+		SourceFile input_file;
+		if (!input_file.open(run.input_file)) {
+			run.output = "Ошибка: файл \"" + run.input_file + "\" не может быть открыт\n";
+			run.failed = true;
+		}
+		else if (state == nullptr) {
+			run.output = state_error + "\n";
+			run.failed = true;
+		}
+		else {
+			state->restore(initial);
+			port.set_input(input_file.get_text());
+			port.clear_output();
+
+			execute(*state);
+			run.output = port.get_output();
+		}
+
+		if (!run.output_file.empty()) {
+			std::ofstream output_file(run.output_file, std::ios::binary);
+			output_file << run.output;
+			output_file.close();
+			if (!output_file) {
+				// Сообщение собирается целиком, чтобы сообщения разных потоков не перемешивались
+				std::cerr << "Ошибка: файл \"" + run.output_file + "\" не может быть записан\n";
+				run.failed = true;
+				continue;
+			}
+			run.output.clear();
+		}
+	}
+}
+
+/*!
+Выполняет все запуски
+\param[in|out] runs Запуски
+\param[in] thread_count Количество потоков
+*/
+void BatchRunner::run(std::vector<BatchRun>& runs, int thread_count) const {
+	std::atomic<int> next_run{ 0 };
+
+	// Потоков больше, чем запусков, не нужно
+	if (thread_count > (int)runs.size()) {
+		thread_count = runs.size();
+	}
+
+	std::vector<std::thread> workers;
+	for (int i = 1; i < thread_count; i++) {
+		workers.emplace_back(&BatchRunner::run_worker, this, std::ref(runs), std::ref(next_run));
+	}
+	run_worker(runs, next_run);
+
+	for (auto& worker : workers) {
+		worker.join();
+	}
+}
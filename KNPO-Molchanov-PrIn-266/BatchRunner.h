@@ -0,0 +1,69 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <atomic>
+
+#include "Interpreter.h"
+#include "ProgramState.h"
+#include "Program.h"
+
+/*!
+Один запуск программы в пакетном режиме
+*/
+struct BatchRun {
+	/// Файл, из которого программа читает ввод
+	std::string input_file;
+	/// Файл для вывода программы. Если пуст, вывод сохраняется в output
+	std::string output_file;
+	/// Вывод программы, если файл для вывода не указан
+	std::string output;
+	/// Флаг, не удалось ли открыть файл ввода, создать состояние программы или записать файл вывода
+	bool failed = false;
+};
+
+/*!
+\brief Пакетный исполнитель программы на псевдо-ассемблере
+
+Выполняет одну оттранслированную программу для многих входных файлов в пуле потоков.
+Программа не изменяется при выполнении, поэтому все потоки используют её без копирования.
+Каждый поток создает одно состояние программы и перед каждым запуском восстанавливает
+его из снимка, сделанного после загрузки данных. Встроенные подпрограммы работают
+с портом StringPort потока, а не со стандартными потоками ввода и вывода
+*/
+class BatchRunner {
+private:
+	/// Оттранслированная программа
+	const Program& program;
+
+	/// Параметры интерпретатора
+	InterpreterOptions options;
+
+	/*!
+	Выполняет программу до завершения. Ошибка выполнения выводится в порт ввода-вывода состояния
+	\param[in|out] state Состояние программы
+	*/
+	void execute(ProgramState& state) const;
+
+	/*!
+	Выполняет запуски, пока они не закончатся. Ошибка записи файла вывода выводится в стандартный поток ошибок
+	\param[in|out] runs Запуски
+	\param[in|out] next_run Индекс следующего невыполненного запуска, общий для всех потоков
+	*/
+	void run_worker(std::vector<BatchRun>& runs, std::atomic<int>& next_run) const;
+
+public:
+	/*!
+	Конструктор пакетного исполнителя
+	\param[in] program Оттранслированная программа. Если выполнение идет через байт-код, он уже должен быть записан
+	\param[in] options Параметры интерпретатора
+	*/
+	BatchRunner(const Program& program, const InterpreterOptions& options);
+
+	/*!
+	Выполняет все запуски
+	\param[in|out] runs Запуски
+	\param[in] thread_count Количество потоков
+	*/
+	void run(std::vector<BatchRun>& runs, int thread_count) const;
+};
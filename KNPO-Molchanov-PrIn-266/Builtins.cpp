@@ -0,0 +1,162 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <map>
+
+#include "Builtins.h"
+#include "ProgramState.h"
+
+
+static void builtin_putc(ProgramState& state) {
+	char r0_value = (char)state.get_register_value(REGISTER::R0);
+	state.get_output().write(r0_value);
+	state.get_output().write('\n');
+}
+
+static void builtin_puts(ProgramState& state) {
+	std::string str;
+	int str_address = state.get_register_value(REGISTER::R0);
+	state.extract_string(str, str_address);
+
+	state.get_output().write(str);
+	state.get_output().write('\n');
+}
+
+static void builtin_puti(ProgramState& state) {
+	int r0_value = state.get_register_value(REGISTER::R0);
+	state.get_output().write(r0_value);
+	state.get_output().write('\n');
+}
+
+static void builtin_getc(ProgramState& state) {
+	// Перед чтением ввода выводится всё, что программа успела напечатать
+	state.get_output().flush();
+
+	char input;
+	state.get_io_port().read_char(input);
+	state.set_register_value(REGISTER::R0, input);
+}
+
+static void builtin_geti(ProgramState& state) {
+	state.get_output().flush();
+
+	int input;
+	state.get_io_port().read_int(input);
+	state.set_register_value(REGISTER::R0, input);
+}
+
+static void builtin_getline(ProgramState& state) {
+	state.get_output().flush();
+
+	std::string line;
+	state.get_io_port().read_line(line);
+
+	state.set_register_value(REGISTER::R0, state.allocate_string(line));
+}
+
+static void builtin_find(ProgramState& state) {
+	int str_address = state.get_register_value(REGISTER::R0);
+	int substr_address = state.get_register_value(REGISTER::R1);
+	std::string str, substr;
+	state.extract_string(str, str_address);
+	state.extract_string(substr, substr_address);
+	state.set_register_value(REGISTER::R2, str.find(substr));
+}
+
+static void builtin_length(ProgramState& state) {
+	std::string str;
+	int str_address = state.get_register_value(REGISTER::R0);
+	state.extract_string(str, str_address);
+	state.set_register_value(REGISTER::R1, str.length());
+}
+
+static void builtin_ispalindrom(ProgramState& state) {
+	std::string str;
+	int str_address = state.get_register_value(REGISTER::R0);
+	state.extract_string(str, str_address);
+	if (str == std::string(str.rbegin(), str.rend())) {
+		state.set_register_value(REGISTER::R1, 1);
+	}
+	else {
+		state.set_register_value(REGISTER::R1, 0);
+	}
+}
+
+/*!
+Конструктор реестра, регистрирующий стандартные подпрограммы
+*/
+BuiltinRegistry::BuiltinRegistry() {
+	add("putc", builtin_putc);
+	add("puts", builtin_puts);
+	add("puti", builtin_puti);
+	add("getc", builtin_getc);
+	add("geti", builtin_geti);
+	add("getline", builtin_getline);
+	add("find", builtin_find);
+	add("length", builtin_length);
+	add("ispalindrom", builtin_ispalindrom);
+}
+
+/*!
+Возвращает общий реестр встроенных подпрограмм
+\return Реестр встроенных подпрограмм
+*/
+BuiltinRegistry& BuiltinRegistry::instance() {
+	static BuiltinRegistry registry;
+	return registry;
+}
+
+/*!
+Регистрирует встроенную подпрограмму. Если подпрограмма с таким именем
+уже зарегистрирована, её реализация заменяется
+\param[in] name Имя подпрограммы
+\param[in] function Функция, реализующая подпрограмму
+\return Идентификатор подпрограммы
+*/
+int BuiltinRegistry::add(const std::string& name, BuiltinFunction function) {
+	auto found = ids.find(name);
+	if (found != ids.end()) {
+		functions[found->second] = function;
+		return found->second;
+	}
+
+	int id = names.size();
+	names.push_back(name);
+	functions.push_back(function);
+	ids[name] = id;
+
+	return id;
+}
+
+/*!
+Ищет встроенную подпрограмму по имени
+\param[in] name Имя подпрограммы
+\return Идентификатор подпрограммы или -1, если подпрограмма не найдена
+*/
+int BuiltinRegistry::find(const std::string& name) const {
+	auto found = ids.find(name);
+	if (found == ids.end()) {
+		return -1;
+	}
+
+	return found->second;
+}
+
+/*!
+Возвращает имя встроенной подпрограммы
+\param[in] id Идентификатор подпрограммы
+\return Имя подпрограммы
+*/
+const std::string& BuiltinRegistry::get_name(int id) const {
+	return names.at(id);
+}
+
+/*!
+Выполняет встроенную подпрограмму
+\param[in] id Идентификатор подпрограммы
+\param[in|out] state Состояние программы
+\throw RuntimeError В случае ошибки выполнения подпрограммы
+*/
+void BuiltinRegistry::call(int id, ProgramState& state) const {
+	functions[id](state);
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <map>
+
+class ProgramState;
+
+/// Функция, реализующая встроенную подпрограмму. Аргументы и результаты передаются через регистры
+typedef void (*BuiltinFunction)(ProgramState& state);
+
+/*!
+\brief Реестр встроенных подпрограмм
+
+Сопоставляет именам встроенных подпрограмм числовые идентификаторы, которые вычисляются
+один раз при трансляции, и хранит указатели на функции, реализующие подпрограммы.
+Реестр содержит стандартные подпрограммы putc, puts, puti, getc, geti, getline, find, length
+и ispalindrom и может быть дополнен собственными подпрограммами до трансляции программы
+*/
+class BuiltinRegistry {
+private:
+	/// Имена подпрограмм в порядке их идентификаторов
+	std::vector<std::string> names;
+
+	/// Функции, реализующие подпрограммы
+	std::vector<BuiltinFunction> functions;
+
+	/// Идентификаторы подпрограмм по именам
+	std::map<std::string, int> ids;
+
+	/*!
+	Конструктор реестра, регистрирующий стандартные подпрограммы
+	*/
+	BuiltinRegistry();
+
+public:
+	/*!
+	Возвращает общий реестр встроенных подпрограмм
+	\return Реестр встроенных подпрограмм
+	*/
+	static BuiltinRegistry& instance();
+
+	/*!
+	Регистрирует встроенную подпрограмму. Если подпрограмма с таким именем
+	уже зарегистрирована, её реализация заменяется
+	\param[in] name Имя подпрограммы
+	\param[in] function Функция, реализующая подпрограмму
+	\return Идентификатор подпрограммы
+	*/
+	int add(const std::string& name, BuiltinFunction function);
+
+	/*!
+	Ищет встроенную подпрограмму по имени
+	\param[in] name Имя подпрограммы
+	\return Идентификатор подпрограммы или -1, если подпрограмма не найдена
+	*/
+	int find(const std::string& name) const;
+
+	/*!
+	Возвращает имя встроенной подпрограммы
+	\param[in] id Идентификатор подпрограммы
+	\return Имя подпрограммы
+	*/
+	const std::string& get_name(int id) const;
+
+	/*!
+	Выполняет встроенную подпрограмму
+	\param[in] id Идентификатор подпрограммы
+	\param[in|out] state Состояние программы
+	\throw RuntimeError В случае ошибки выполнения подпрограммы
+	*/
+	void call(int id, ProgramState& state) const;
+};
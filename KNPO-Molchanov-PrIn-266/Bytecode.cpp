@@ -0,0 +1,76 @@
+#include <vector>
+#include <string>
+
+#include "Bytecode.h"
+
+
+/*!
+Проверяет, что регистры инструкции существуют, чтобы исполнитель байт-кода
+мог обращаться к ним без проверок
+\param[in] instr Инструкция
+\throw RuntimeError В случае, если инструкция ссылается на несуществующий регистр
+*/
+void Bytecode::check_registers(const BytecodeInstr& instr) const {
+	for (uint8_t r : { instr.dest, instr.src1, instr.src2 }) {
+		if (r >= REGISTER_COUNT) {
+			throw RuntimeError("Недопустимый регистр r" + std::to_string(r));
+		}
+	}
+}
+
+/*!
+Добавляет инструкцию в конец байт-кода
+\param[in] instr Инструкция
+\param[in] line_number Номер строки, на которой расположена инструкция
+\throw RuntimeError В случае, если инструкция ссылается на несуществующий регистр
+*/
+void Bytecode::emit(const BytecodeInstr& instr, int line_number) {
+	check_registers(instr);
+	instrs.push_back(instr);
+	line_numbers.push_back(line_number);
+}
+
+/*!
+Заменяет инструкцию байт-кода
+\param[in] address Индекс инструкции
+\param[in] instr Новая инструкция
+\throw RuntimeError В случае, если инструкция ссылается на несуществующий регистр
+*/
+void Bytecode::replace(int address, const BytecodeInstr& instr) {
+	check_registers(instr);
+	instrs.at(address) = instr;
+}
+
+/*!
+Возвращает количество инструкций
+\return Количество инструкций
+*/
+int Bytecode::size() const {
+	return instrs.size();
+}
+
+/*!
+Возвращает указатель на первую инструкцию байт-кода
+\return Указатель на первую инструкцию
+*/
+const BytecodeInstr* Bytecode::get_instrs() const {
+	return instrs.data();
+}
+
+/*!
+Возвращает инструкцию байт-кода
+\param[in] address Индекс инструкции
+\return Инструкция
+*/
+const BytecodeInstr& Bytecode::get_instr(int address) const {
+	return instrs.at(address);
+}
+
+/*!
+Возвращает номер строки, на которой расположена инструкция
+\param[in] address Индекс инструкции
+\return Номер строки
+*/
+int Bytecode::get_line_number(int address) const {
+	return line_numbers.at(address);
+}
\ No newline at end of file
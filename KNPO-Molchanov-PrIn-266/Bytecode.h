@@ -0,0 +1,197 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include <string>
+
+#include "ProgramState.h"
+
+
+/// Коды операций байт-кода псевдо-ассемблера
+enum class OPCODE : uint8_t {
+	ADD_REG, ///< dest += src1
+	ADD_IMM, ///< dest += imm_value
+	SUB_REG, ///< dest -= src1
+	SUB_IMM, ///< dest -= imm_value
+	AND_REG, ///< dest &= src1
+	AND_IMM, ///< dest &= imm_value
+	OR_REG, ///< dest |= src1
+	OR_IMM, ///< dest |= imm_value
+	XOR_REG, ///< dest ^= src1
+	XOR_IMM, ///< dest ^= imm_value
+	NOT, ///< dest = ~dest
+	SHR_REG, ///< dest >>= src1
+	SHR_IMM, ///< dest >>= imm_value
+	SHL_REG, ///< dest <<= src1
+	SHL_IMM, ///< dest <<= imm_value
+	MUL_REG, ///< dest *= src1
+	MUL_IMM, ///< dest *= imm_value
+	DIV_REG, ///< dest /= src1
+	DIV_IMM, ///< dest /= imm_value
+	MOD_REG, ///< dest %= src1
+	MOD_IMM, ///< dest %= imm_value
+
+	SET_REG, ///< dest = src1
+	SET_IMM, ///< dest = imm_value
+	SET_MEM, ///< dest = memory[imm_value], адрес ячейки вычислен при размещении данных
+
+	LD, ///< dest = imm_value, адрес ячейки вычислен при размещении данных
+	ST, ///< memory[imm_value] = src1
+	LDI, ///< dest = memory[src1]
+	STI, ///< memory[dest] = src1
+	LDI_OFFSET, ///< dest = memory[src1 + imm_value]
+	LDI_INDEX, ///< dest = memory[src1 + src2]
+	STI_OFFSET, ///< memory[dest + imm_value] = src1
+	STI_INDEX, ///< memory[dest + src2] = src1
+	PUSH, ///< Помещает src1 в стек данных
+	POP, ///< Извлекает dest из стека данных
+
+	JMP, ///< Переход на инструкцию address
+	JEQ, ///< Переход на инструкцию address, если src1 == src2
+	JNE, ///< Переход на инструкцию address, если src1 != src2
+	JGT, ///< Переход на инструкцию address, если src1 > src2
+	JLT, ///< Переход на инструкцию address, если src1 < src2
+	JGE, ///< Переход на инструкцию address, если src1 >= src2
+	JLE, ///< Переход на инструкцию address, если src1 <= src2
+	JEQ_IMM, ///< Переход на инструкцию address, если src1 == imm_value
+	JNE_IMM, ///< Переход на инструкцию address, если src1 != imm_value
+	JGT_IMM, ///< Переход на инструкцию address, если src1 > imm_value
+	JLT_IMM, ///< Переход на инструкцию address, если src1 < imm_value
+	JGE_IMM, ///< Переход на инструкцию address, если src1 >= imm_value
+	JLE_IMM, ///< Переход на инструкцию address, если src1 <= imm_value
+
+	CALL, ///< Вызов подпрограммы пользователя, начинающейся с инструкции address
+	CALL_BUILTIN, ///< Вызов встроенной подпрограммы с идентификатором imm_value из реестра встроенных подпрограмм
+	RET, ///< Возврат из подпрограммы
+
+	DATA, ///< Данные по адресу address, записанные в память при загрузке программы. Ничего не делает
+
+	// Суперинструкции, заменяющие первую инструкцию последовательности.
+	// Остальные инструкции последовательности остаются на своих местах
+	// и выполняются только при переходе на них
+
+	SUB_IMM_JGT, ///< dest -= imm_value; переход на инструкцию address, если src1 > src2
+	SET_MEM_CALL, ///< dest = memory[imm_value]; вызов встроенной подпрограммы с идентификатором address
+	LD_CALL, ///< dest = imm_value; вызов встроенной подпрограммы с идентификатором address
+	LDI_ADD_IMM_STI, ///< dest = memory[src1] + imm_value; memory[src1] = dest
+	LDI_ADD_REG_STI, ///< dest = memory[src1] + src2; memory[src1] = dest
+};
+
+/*!
+Делит одно число на другое с округлением к нулю. Частное INT_MIN / -1
+не помещается в int, поэтому, как и при сложении, результат берется по модулю 2^32
+\param[in] dividend Делимое
+\param[in] divisor Делитель
+\return Частное
+\throw RuntimeError В случае деления на ноль
+*/
+inline int divide(int dividend, int divisor) {
+	if (divisor == 0) {
+		throw RuntimeError("Деление на ноль");
+	}
+	if (divisor == -1) {
+		return (int)(0u - (unsigned)dividend);
+	}
+	return dividend / divisor;
+}
+
+/*!
+Вычисляет остаток от деления одного числа на другое. Знак остатка совпадает со знаком делимого
+\param[in] dividend Делимое
+\param[in] divisor Делитель
+\return Остаток
+\throw RuntimeError В случае деления на ноль
+*/
+inline int modulo(int dividend, int divisor) {
+	if (divisor == 0) {
+		throw RuntimeError("Деление на ноль");
+	}
+	if (divisor == -1) {
+		return 0;
+	}
+	return dividend % divisor;
+}
+
+/*!
+Инструкция байт-кода фиксированной длины
+*/
+struct BytecodeInstr {
+	/// Код операции
+	OPCODE opcode;
+	/// Регистр приемник
+	uint8_t dest;
+	/// Регистр источник первого операнда
+	uint8_t src1;
+	/// Регистр источник второго операнда
+	uint8_t src2;
+	/// Непосредственный числовой аргумент, адрес ячейки памяти или идентификатор встроенной подпрограммы
+	int32_t imm_value;
+	/// Индекс инструкции, на которую передается управление, или адрес данных
+	int32_t address;
+};
+
+/// Шитый код: адрес обработчика для каждой инструкции байт-кода и адрес выхода последним элементом
+using ThreadedCode = std::vector<const void*>;
+
+/*!
+Программа на псевдо-ассемблере, записанная в виде непрерывного массива инструкций байт-кода
+*/
+class Bytecode {
+private:
+	/// Инструкции байт-кода
+	std::vector<BytecodeInstr> instrs;
+
+	/// Номера строк, на которых расположены инструкции
+	std::vector<int> line_numbers;
+
+	/*!
+	Проверяет, что регистры инструкции существуют, чтобы исполнитель байт-кода
+	мог обращаться к ним без проверок
+	\param[in] instr Инструкция
+	\throw RuntimeError В случае, если инструкция ссылается на несуществующий регистр
+	*/
+	void check_registers(const BytecodeInstr& instr) const;
+
+public:
+	/*!
+	Добавляет инструкцию в конец байт-кода
+	\param[in] instr Инструкция
+	\param[in] line_number Номер строки, на которой расположена инструкция
+	\throw RuntimeError В случае, если инструкция ссылается на несуществующий регистр
+	*/
+	void emit(const BytecodeInstr& instr, int line_number);
+
+	/*!
+	Заменяет инструкцию байт-кода
+	\param[in] address Индекс инструкции
+	\param[in] instr Новая инструкция
+	\throw RuntimeError В случае, если инструкция ссылается на несуществующий регистр
+	*/
+	void replace(int address, const BytecodeInstr& instr);
+
+	/*!
+	Возвращает количество инструкций
+	\return Количество инструкций
+	*/
+	int size() const;
+
+	/*!
+	Возвращает указатель на первую инструкцию байт-кода
+	\return Указатель на первую инструкцию
+	*/
+	const BytecodeInstr* get_instrs() const;
+
+	/*!
+	Возвращает инструкцию байт-кода
+	\param[in] address Индекс инструкции
+	\return Инструкция
+	*/
+	const BytecodeInstr& get_instr(int address) const;
+
+	/*!
+	Возвращает номер строки, на которой расположена инструкция
+	\param[in] address Индекс инструкции
+	\return Номер строки
+	*/
+	int get_line_number(int address) const;
+};
\ No newline at end of file
@@ -0,0 +1,202 @@
+#include <string>
+#include <vector>
+
+#include "BytecodeEngine.h"
+#include "Program.h"
+
+// Адреса меток (labels as values) поддерживаются только GCC и Clang
+#if defined(__GNUC__) || defined(__clang__)
+#define KNPO_THREADED_DISPATCH 1
+#endif
+
+
+// Регистры инструкций проверены при записи в Bytecode, поэтому обращения к ним встраиваются без проверок
+static inline int reg(const ProgramState& state, uint8_t r) {
+	return state.get_register_value((REGISTER)r);
+}
+
+static inline void set_reg(ProgramState& state, uint8_t r, int value) {
+	state.set_register_value((REGISTER)r, value);
+}
+
+/*!
+Конструктор исполнителя байт-кода
+\param[in] dispatch Способ диспетчеризации инструкций. Если компилятор не поддерживает
+адреса меток, вместо DISPATCH::THREADED используется DISPATCH::SWITCH
+*/
+BytecodeEngine::BytecodeEngine(DISPATCH dispatch) : dispatch{ dispatch } {
+}
+
+/*!
+Проверяет, поддерживается ли диспетчеризация DISPATCH::THREADED текущим компилятором
+\return Флаг поддержки прямого шитого кода
+*/
+bool BytecodeEngine::is_threaded_dispatch_supported() {
+#ifdef KNPO_THREADED_DISPATCH
+	return true;
+#else
+	return false;
+#endif
+}
+
+/*!
+Записывает для каждой инструкции байт-кода адрес её обработчика. Шитый код
+декодируется один раз и используется при каждом выполнении программы
+\param[in] bytecode Байт-код
+\return Шитый код или пустой массив, если прямой шитый код не поддерживается
+*/
+ThreadedCode BytecodeEngine::decode_threaded(const Bytecode& bytecode) {
+	if (!is_threaded_dispatch_supported()) {
+		return {};
+	}
+
+	const void* const* opcode_handlers = execute_threaded(bytecode, nullptr, nullptr);
+	const BytecodeInstr* instrs = bytecode.get_instrs();
+	const int instr_count = bytecode.size();
+
+	// Дополнительный последний элемент указывает на выход, поэтому достижение
+	// конца программы не требует отдельной проверки
+	ThreadedCode threaded_code(instr_count + 1);
+	for (int i = 0; i < instr_count; i++) {
+		threaded_code[i] = opcode_handlers[(int)instrs[i].opcode];
+	}
+	threaded_code[instr_count] = opcode_handlers[(int)OPCODE::LDI_ADD_REG_STI + 1];
+	return threaded_code;
+}
+
+/*!
+Выполняет байт-код, пока не будет достигнут его конец
+\param[in] bytecode Байт-код
+\param[in|out] state Состояние программы
+\throw RuntimeError В случае ошибки выполнения. Индекс инструкции, вызвавшей ошибку, сохраняется в состоянии программы
+*/
+void BytecodeEngine::execute(const Bytecode& bytecode, ProgramState& state) const {
+	if (dispatch == DISPATCH::THREADED && is_threaded_dispatch_supported()) {
+		ThreadedCode threaded_code = decode_threaded(bytecode);
+		execute_threaded(bytecode, threaded_code.data(), &state);
+	}
+	else {
+		execute_switch(bytecode, state);
+	}
+}
+
+/*!
+Выполняет байт-код программы, пока не будет достигнут его конец. Используется шитый код,
+декодированный при создании программы
+\param[in] program Программа
+\param[in|out] state Состояние программы
+\throw RuntimeError В случае ошибки выполнения. Индекс инструкции, вызвавшей ошибку, сохраняется в состоянии программы
+*/
+void BytecodeEngine::execute(const Program& program, ProgramState& state) const {
+	if (dispatch == DISPATCH::THREADED && !program.get_threaded_code().empty()) {
+		execute_threaded(program.get_bytecode(), program.get_threaded_code().data(), &state);
+	}
+	else {
+		execute_switch(program.get_bytecode(), state);
+	}
+}
+
+/*!
+Выполняет байт-код в цикле с оператором switch
+\param[in] bytecode Байт-код
+\param[in|out] state Состояние программы
+\throw RuntimeError В случае ошибки выполнения
+*/
+void BytecodeEngine::execute_switch(const Bytecode& bytecode, ProgramState& state) const {
+	const BytecodeInstr* instrs = bytecode.get_instrs();
+	const int instr_count = bytecode.size();
+
+	// Индекс текущей инструкции хранится локально и записывается в состояние
+	// программы только при вызовах подпрограмм и ошибках
+	int pc = state.get_pc();
+
+	try {
+		while (pc < instr_count) {
+			switch (instrs[pc].opcode) {
+#define HANDLER(op) case OPCODE::op:
+#define NEXT pc++; break
+#define JUMP(address) pc = (address); break
+#define INSTR (instrs[pc])
+#include "BytecodeHandlers.inl"
+#undef HANDLER
+#undef NEXT
+#undef JUMP
+#undef INSTR
+			}
+		}
+	}
+	catch (RuntimeError&) {
+		state.set_pc(pc);
+		throw;
+	}
+
+	state.set_pc(pc);
+}
+
+/*!
+Выполняет байт-код, переходя по адресам обработчиков, заранее записанным для каждой инструкции.
+Если состояние программы не передано, ничего не выполняет
+\param[in] bytecode Байт-код
+\param[in] threaded_code Шитый код байт-кода
+\param[in|out] program_state Состояние программы или nullptr
+\return Адреса обработчиков в порядке перечисления OPCODE и адрес выхода последним элементом
+\throw RuntimeError В случае ошибки выполнения
+*/
+const void* const* BytecodeEngine::execute_threaded(const Bytecode& bytecode, const void* const* threaded_code, ProgramState* program_state) {
+#ifdef KNPO_THREADED_DISPATCH
+	// Адреса обработчиков в порядке перечисления OPCODE. Адреса меток доступны только
+	// внутри этой функции, поэтому decode_threaded получает их отсюда
+	static const void* const opcode_handlers[] = {
+		&&op_ADD_REG, &&op_ADD_IMM, &&op_SUB_REG, &&op_SUB_IMM,
+		&&op_AND_REG, &&op_AND_IMM, &&op_OR_REG, &&op_OR_IMM,
+		&&op_XOR_REG, &&op_XOR_IMM, &&op_NOT,
+		&&op_SHR_REG, &&op_SHR_IMM, &&op_SHL_REG, &&op_SHL_IMM,
+		&&op_MUL_REG, &&op_MUL_IMM, &&op_DIV_REG, &&op_DIV_IMM, &&op_MOD_REG, &&op_MOD_IMM,
+		&&op_SET_REG, &&op_SET_IMM, &&op_SET_MEM,
+		&&op_LD, &&op_ST, &&op_LDI, &&op_STI,
+		&&op_LDI_OFFSET, &&op_LDI_INDEX, &&op_STI_OFFSET, &&op_STI_INDEX,
+		&&op_PUSH, &&op_POP,
+		&&op_JMP, &&op_JEQ, &&op_JNE, &&op_JGT, &&op_JLT, &&op_JGE, &&op_JLE,
+		&&op_JEQ_IMM, &&op_JNE_IMM, &&op_JGT_IMM, &&op_JLT_IMM, &&op_JGE_IMM, &&op_JLE_IMM,
+		&&op_CALL, &&op_CALL_BUILTIN, &&op_RET,
+		&&op_DATA,
+		&&op_SUB_IMM_JGT, &&op_SET_MEM_CALL, &&op_LD_CALL,
+		&&op_LDI_ADD_IMM_STI, &&op_LDI_ADD_REG_STI,
+		&&halt,
+	};
+	static_assert(sizeof(opcode_handlers) / sizeof(opcode_handlers[0]) == (int)OPCODE::LDI_ADD_REG_STI + 2, "Для каждого кода операции должен быть задан обработчик");
+
+	if (program_state == nullptr) {
+		return opcode_handlers;
+	}
+
+	ProgramState& state = *program_state;
+	const BytecodeInstr* instrs = bytecode.get_instrs();
+	const void* const* handlers = threaded_code;
+
+	int pc = state.get_pc();
+
+	try {
+		goto *handlers[pc];
+
+#define HANDLER(op) op_##op:
+#define NEXT pc++; goto *handlers[pc]
+#define JUMP(address) pc = (address); goto *handlers[pc]
+#define INSTR (instrs[pc])
+#include "BytecodeHandlers.inl"
+#undef HANDLER
+#undef NEXT
+#undef JUMP
+#undef INSTR
+
+	halt:;
+	}
+	catch (RuntimeError&) {
+		state.set_pc(pc);
+		throw;
+	}
+
+	state.set_pc(pc);
+#endif
+	return nullptr;
+}
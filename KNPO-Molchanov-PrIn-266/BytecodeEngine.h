@@ -0,0 +1,79 @@
+#pragma once
+
+#include "Bytecode.h"
+#include "ProgramState.h"
+
+class Program;
+
+/// Способы диспетчеризации инструкций байт-кода
+enum class DISPATCH {
+	SWITCH, ///< Переносимый цикл с оператором switch по коду операции
+	THREADED, ///< Прямой шитый код: каждый обработчик переходит сразу к обработчику следующей инструкции
+};
+
+/*!
+Исполнитель байт-кода псевдо-ассемблера
+*/
+class BytecodeEngine {
+private:
+	/// Способ диспетчеризации инструкций
+	DISPATCH dispatch;
+
+	/*!
+	Выполняет байт-код в цикле с оператором switch
+	\param[in] bytecode Байт-код
+	\param[in|out] state Состояние программы
+	\throw RuntimeError В случае ошибки выполнения
+	*/
+	void execute_switch(const Bytecode& bytecode, ProgramState& state) const;
+
+	/*!
+	Выполняет байт-код, переходя по адресам обработчиков, заранее записанным для каждой инструкции.
+	Если состояние программы не передано, ничего не выполняет
+	\param[in] bytecode Байт-код
+	\param[in] threaded_code Шитый код байт-кода
+	\param[in|out] program_state Состояние программы или nullptr
+	\return Адреса обработчиков в порядке перечисления OPCODE и адрес выхода последним элементом
+	\throw RuntimeError В случае ошибки выполнения
+	*/
+	static const void* const* execute_threaded(const Bytecode& bytecode, const void* const* threaded_code, ProgramState* program_state);
+
+public:
+	/*!
+	Конструктор исполнителя байт-кода
+	\param[in] dispatch Способ диспетчеризации инструкций. Если компилятор не поддерживает
+	адреса меток, вместо DISPATCH::THREADED используется DISPATCH::SWITCH
+	*/
+	BytecodeEngine(DISPATCH dispatch = DISPATCH::THREADED);
+
+	/*!
+	Проверяет, поддерживается ли диспетчеризация DISPATCH::THREADED текущим компилятором
+	\return Флаг поддержки прямого шитого кода
+	*/
+	static bool is_threaded_dispatch_supported();
+
+	/*!
+	Записывает для каждой инструкции байт-кода адрес её обработчика. Шитый код
+	декодируется один раз и используется при каждом выполнении программы
+	\param[in] bytecode Байт-код
+	\return Шитый код или пустой массив, если прямой шитый код не поддерживается
+	*/
+	static ThreadedCode decode_threaded(const Bytecode& bytecode);
+
+	/*!
+	Выполняет байт-код, пока не будет достигнут его конец
+	\param[in] bytecode Байт-код
+	\param[in|out] state Состояние программы
+	\throw RuntimeError В случае ошибки выполнения. Индекс инструкции, вызвавшей ошибку, сохраняется в состоянии программы
+	*/
+	void execute(const Bytecode& bytecode, ProgramState& state) const;
+
+	/*!
+	Выполняет байт-код программы, пока не будет достигнут его конец. Используется шитый код,
+	декодированный при создании программы
+	\param[in] program Программа
+	\param[in|out] state Состояние программы
+	\throw RuntimeError В случае ошибки выполнения. Индекс инструкции, вызвавшей ошибку, сохраняется в состоянии программы
+	*/
+	void execute(const Program& program, ProgramState& state) const;
+};
@@ -0,0 +1,245 @@
+// Обработчики инструкций байт-кода, общие для всех способов диспетчеризации.
+// Перед включением файла должны быть определены макросы:
+//   HANDLER(op) - начало обработчика инструкции с кодом операции OPCODE::op
+//   NEXT - переход к следующей инструкции
+//   JUMP(address) - переход к инструкции с индексом address
+//   INSTR - текущая инструкция байт-кода
+
+HANDLER(ADD_REG) {
+	set_reg(state, INSTR.dest, reg(state, INSTR.dest) + reg(state, INSTR.src1));
+	NEXT;
+}
+HANDLER(ADD_IMM) {
+	set_reg(state, INSTR.dest, reg(state, INSTR.dest) + INSTR.imm_value);
+	NEXT;
+}
+HANDLER(SUB_REG) {
+	set_reg(state, INSTR.dest, reg(state, INSTR.dest) - reg(state, INSTR.src1));
+	NEXT;
+}
+HANDLER(SUB_IMM) {
+	set_reg(state, INSTR.dest, reg(state, INSTR.dest) - INSTR.imm_value);
+	NEXT;
+}
+HANDLER(AND_REG) {
+	set_reg(state, INSTR.dest, reg(state, INSTR.dest) & reg(state, INSTR.src1));
+	NEXT;
+}
+HANDLER(AND_IMM) {
+	set_reg(state, INSTR.dest, reg(state, INSTR.dest) & INSTR.imm_value);
+	NEXT;
+}
+HANDLER(OR_REG) {
+	set_reg(state, INSTR.dest, reg(state, INSTR.dest) | reg(state, INSTR.src1));
+	NEXT;
+}
+HANDLER(OR_IMM) {
+	set_reg(state, INSTR.dest, reg(state, INSTR.dest) | INSTR.imm_value);
+	NEXT;
+}
+HANDLER(XOR_REG) {
+	set_reg(state, INSTR.dest, reg(state, INSTR.dest) ^ reg(state, INSTR.src1));
+	NEXT;
+}
+HANDLER(XOR_IMM) {
+	set_reg(state, INSTR.dest, reg(state, INSTR.dest) ^ INSTR.imm_value);
+	NEXT;
+}
+HANDLER(NOT) {
+	set_reg(state, INSTR.dest, ~reg(state, INSTR.dest));
+	NEXT;
+}
+HANDLER(SHR_REG) {
+	set_reg(state, INSTR.dest, reg(state, INSTR.dest) >> reg(state, INSTR.src1));
+	NEXT;
+}
+HANDLER(SHR_IMM) {
+	set_reg(state, INSTR.dest, reg(state, INSTR.dest) >> INSTR.imm_value);
+	NEXT;
+}
+HANDLER(SHL_REG) {
+	int shift_count = reg(state, INSTR.src1);
+	if (shift_count < 0) {
+		throw RuntimeError("Количество сдвигов не может быть отрицательным");
+	}
+	set_reg(state, INSTR.dest, reg(state, INSTR.dest) << shift_count);
+	NEXT;
+}
+HANDLER(SHL_IMM) {
+	if (INSTR.imm_value < 0) {
+		throw RuntimeError("Количество сдвигов не может быть отрицательным");
+	}
+	set_reg(state, INSTR.dest, reg(state, INSTR.dest) << INSTR.imm_value);
+	NEXT;
+}
+HANDLER(MUL_REG) {
+	set_reg(state, INSTR.dest, reg(state, INSTR.dest) * reg(state, INSTR.src1));
+	NEXT;
+}
+HANDLER(MUL_IMM) {
+	set_reg(state, INSTR.dest, reg(state, INSTR.dest) * INSTR.imm_value);
+	NEXT;
+}
+HANDLER(DIV_REG) {
+	set_reg(state, INSTR.dest, divide(reg(state, INSTR.dest), reg(state, INSTR.src1)));
+	NEXT;
+}
+HANDLER(DIV_IMM) {
+	set_reg(state, INSTR.dest, divide(reg(state, INSTR.dest), INSTR.imm_value));
+	NEXT;
+}
+HANDLER(MOD_REG) {
+	set_reg(state, INSTR.dest, modulo(reg(state, INSTR.dest), reg(state, INSTR.src1)));
+	NEXT;
+}
+HANDLER(MOD_IMM) {
+	set_reg(state, INSTR.dest, modulo(reg(state, INSTR.dest), INSTR.imm_value));
+	NEXT;
+}
+HANDLER(SET_REG) {
+	set_reg(state, INSTR.dest, reg(state, INSTR.src1));
+	NEXT;
+}
+HANDLER(SET_IMM) {
+	set_reg(state, INSTR.dest, INSTR.imm_value);
+	NEXT;
+}
+HANDLER(SET_MEM) {
+	set_reg(state, INSTR.dest, state.get_data_value(INSTR.imm_value));
+	NEXT;
+}
+HANDLER(LD) {
+	set_reg(state, INSTR.dest, INSTR.imm_value);
+	NEXT;
+}
+HANDLER(ST) {
+	state.set_data_value(INSTR.imm_value, reg(state, INSTR.src1));
+	NEXT;
+}
+HANDLER(LDI) {
+	set_reg(state, INSTR.dest, state.get_memory_value(reg(state, INSTR.src1)));
+	NEXT;
+}
+HANDLER(STI) {
+	state.set_memory_value(reg(state, INSTR.dest), reg(state, INSTR.src1));
+	NEXT;
+}
+HANDLER(LDI_OFFSET) {
+	set_reg(state, INSTR.dest, state.get_memory_value(reg(state, INSTR.src1) + INSTR.imm_value));
+	NEXT;
+}
+HANDLER(LDI_INDEX) {
+	set_reg(state, INSTR.dest, state.get_memory_value(reg(state, INSTR.src1) + reg(state, INSTR.src2)));
+	NEXT;
+}
+HANDLER(STI_OFFSET) {
+	state.set_memory_value(reg(state, INSTR.dest) + INSTR.imm_value, reg(state, INSTR.src1));
+	NEXT;
+}
+HANDLER(STI_INDEX) {
+	state.set_memory_value(reg(state, INSTR.dest) + reg(state, INSTR.src2), reg(state, INSTR.src1));
+	NEXT;
+}
+HANDLER(PUSH) {
+	state.push(reg(state, INSTR.src1));
+	NEXT;
+}
+HANDLER(POP) {
+	set_reg(state, INSTR.dest, state.pop());
+	NEXT;
+}
+HANDLER(JMP) {
+	JUMP(INSTR.address);
+}
+HANDLER(JEQ) {
+	JUMP(reg(state, INSTR.src1) == reg(state, INSTR.src2) ? INSTR.address : pc + 1);
+}
+HANDLER(JNE) {
+	JUMP(reg(state, INSTR.src1) != reg(state, INSTR.src2) ? INSTR.address : pc + 1);
+}
+HANDLER(JGT) {
+	JUMP(reg(state, INSTR.src1) > reg(state, INSTR.src2) ? INSTR.address : pc + 1);
+}
+HANDLER(JLT) {
+	JUMP(reg(state, INSTR.src1) < reg(state, INSTR.src2) ? INSTR.address : pc + 1);
+}
+HANDLER(JGE) {
+	JUMP(reg(state, INSTR.src1) >= reg(state, INSTR.src2) ? INSTR.address : pc + 1);
+}
+HANDLER(JLE) {
+	JUMP(reg(state, INSTR.src1) <= reg(state, INSTR.src2) ? INSTR.address : pc + 1);
+}
+HANDLER(JEQ_IMM) {
+	JUMP(reg(state, INSTR.src1) == INSTR.imm_value ? INSTR.address : pc + 1);
+}
+HANDLER(JNE_IMM) {
+	JUMP(reg(state, INSTR.src1) != INSTR.imm_value ? INSTR.address : pc + 1);
+}
+HANDLER(JGT_IMM) {
+	JUMP(reg(state, INSTR.src1) > INSTR.imm_value ? INSTR.address : pc + 1);
+}
+HANDLER(JLT_IMM) {
+	JUMP(reg(state, INSTR.src1) < INSTR.imm_value ? INSTR.address : pc + 1);
+}
+HANDLER(JGE_IMM) {
+	JUMP(reg(state, INSTR.src1) >= INSTR.imm_value ? INSTR.address : pc + 1);
+}
+HANDLER(JLE_IMM) {
+	JUMP(reg(state, INSTR.src1) <= INSTR.imm_value ? INSTR.address : pc + 1);
+}
+HANDLER(CALL) {
+	state.set_pc(pc);
+	state.call_subroutine(INSTR.address);
+	JUMP(state.get_pc());
+}
+HANDLER(CALL_BUILTIN) {
+	// Встроенные подпрограммы не меняют индекс текущей инструкции,
+	// поэтому синхронизировать его с состоянием программы не нужно
+	state.call_builtin(INSTR.imm_value);
+	NEXT;
+}
+HANDLER(RET) {
+	state.set_pc(pc);
+	state.return_from_subroutine();
+	JUMP(state.get_pc());
+}
+HANDLER(DATA) {
+	// Данные записаны в память при загрузке программы
+	NEXT;
+}
+HANDLER(SUB_IMM_JGT) {
+	const BytecodeInstr& instr = INSTR;
+	set_reg(state, instr.dest, reg(state, instr.dest) - instr.imm_value);
+	JUMP(reg(state, instr.src1) > reg(state, instr.src2) ? instr.address : pc + 2);
+}
+HANDLER(SET_MEM_CALL) {
+	const BytecodeInstr& instr = INSTR;
+	set_reg(state, instr.dest, state.get_data_value(instr.imm_value));
+	// Ошибка вызова должна указывать на строку инструкции "call"
+	pc++;
+	state.call_builtin(instr.address);
+	NEXT;
+}
+HANDLER(LD_CALL) {
+	const BytecodeInstr& instr = INSTR;
+	set_reg(state, instr.dest, instr.imm_value);
+	pc++;
+	state.call_builtin(instr.address);
+	NEXT;
+}
+HANDLER(LDI_ADD_IMM_STI) {
+	const BytecodeInstr& instr = INSTR;
+	set_reg(state, instr.dest, state.get_memory_value(reg(state, instr.src1)) + instr.imm_value);
+	// Ошибка записи должна указывать на строку инструкции "sti"
+	pc += 2;
+	state.set_memory_value(reg(state, instr.src1), reg(state, instr.dest));
+	NEXT;
+}
+HANDLER(LDI_ADD_REG_STI) {
+	const BytecodeInstr& instr = INSTR;
+	set_reg(state, instr.dest, state.get_memory_value(reg(state, instr.src1)));
+	set_reg(state, instr.dest, reg(state, instr.dest) + reg(state, instr.src2));
+	pc += 2;
+	state.set_memory_value(reg(state, instr.src1), reg(state, instr.dest));
+	NEXT;
+}
@@ -0,0 +1,275 @@
+#include <vector>
+#include <string>
+#include <string_view>
+#include <cstring>
+
+#include "DfaTokenizer.h"
+
+
+static inline bool is_letter(unsigned char ch) {
+	return (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') || ch == '_';
+}
+
+static inline bool is_digit(unsigned char ch) {
+	return ch >= '0' && ch <= '9';
+}
+
+static inline bool is_word_char(unsigned char ch) {
+	return is_letter(ch) || is_digit(ch);
+}
+
+static inline bool is_hex_digit(unsigned char ch) {
+	return is_digit(ch) || (ch >= 'a' && ch <= 'f') || (ch >= 'A' && ch <= 'F');
+}
+
+static inline bool is_octal_digit(unsigned char ch) {
+	return ch >= '0' && ch <= '7';
+}
+
+static inline bool is_binary_digit(unsigned char ch) {
+	return ch == '0' || ch == '1';
+}
+
+static inline bool is_space(unsigned char ch) {
+	return ch == ' ' || ch == '\t' || ch == '\n' || ch == '\v' || ch == '\f' || ch == '\r';
+}
+
+// Символы, с которыми не сопоставляется "." в регулярных выражениях Tokenizer
+static inline bool is_line_terminator(unsigned char ch) {
+	return ch == '\n' || ch == '\r';
+}
+
+/*!
+Определяет, является ли идентификатор зарезервированным словом
+\param[in] str Строка
+\param[in] start_index Индекс начала идентификатора
+\param[in] length Длина идентификатора
+\return Тип зарезервированного слова или TOKEN_TYPE::NAME
+*/
+TOKEN_TYPE DfaTokenizer::classify_word(std::string_view str, int start_index, int length) const {
+	const char* word = str.data() + start_index;
+
+	// Зарезервированные слова различаются длиной и первым символом,
+	// поэтому достаточно одного сравнения на идентификатор
+	switch (length) {
+	case 2:
+		switch (word[0]) {
+		case 'o':
+			return word[1] == 'r' ? TOKEN_TYPE::OR : TOKEN_TYPE::NAME;
+		case 'l':
+			return word[1] == 'd' ? TOKEN_TYPE::LD : TOKEN_TYPE::NAME;
+		case 's':
+			if (word[1] == 't') return TOKEN_TYPE::ST;
+			if (word[1] == 'p') return TOKEN_TYPE::SP;
+			return TOKEN_TYPE::NAME;
+		case 'r':
+			if (word[1] >= '0' && word[1] <= '7') {
+				return (TOKEN_TYPE)((int)TOKEN_TYPE::R0 + (word[1] - '0'));
+			}
+			return TOKEN_TYPE::NAME;
+		}
+		return TOKEN_TYPE::NAME;
+	case 3:
+		switch (word[0]) {
+		case 'a':
+			if (std::memcmp(word, "add", 3) == 0) return TOKEN_TYPE::ADD;
+			if (std::memcmp(word, "and", 3) == 0) return TOKEN_TYPE::AND;
+			break;
+		case 's':
+			if (std::memcmp(word, "sub", 3) == 0) return TOKEN_TYPE::SUB;
+			if (std::memcmp(word, "shr", 3) == 0) return TOKEN_TYPE::SHR;
+			if (std::memcmp(word, "shl", 3) == 0) return TOKEN_TYPE::SHL;
+			if (std::memcmp(word, "set", 3) == 0) return TOKEN_TYPE::SET;
+			if (std::memcmp(word, "sti", 3) == 0) return TOKEN_TYPE::STI;
+			break;
+		case 'x':
+			if (std::memcmp(word, "xor", 3) == 0) return TOKEN_TYPE::XOR;
+			break;
+		case 'n':
+			if (std::memcmp(word, "not", 3) == 0) return TOKEN_TYPE::NOT;
+			break;
+		case 'm':
+			if (std::memcmp(word, "mul", 3) == 0) return TOKEN_TYPE::MUL;
+			if (std::memcmp(word, "mod", 3) == 0) return TOKEN_TYPE::MOD;
+			break;
+		case 'd':
+			if (std::memcmp(word, "div", 3) == 0) return TOKEN_TYPE::DIV;
+			break;
+		case 'l':
+			if (std::memcmp(word, "ldi", 3) == 0) return TOKEN_TYPE::LDI;
+			break;
+		case 'p':
+			if (std::memcmp(word, "pop", 3) == 0) return TOKEN_TYPE::POP;
+			break;
+		case 'j':
+			if (std::memcmp(word, "jmp", 3) == 0) return TOKEN_TYPE::JMP;
+			if (std::memcmp(word, "jeq", 3) == 0) return TOKEN_TYPE::JEQ;
+			if (std::memcmp(word, "jne", 3) == 0) return TOKEN_TYPE::JNE;
+			if (std::memcmp(word, "jgt", 3) == 0) return TOKEN_TYPE::JGT;
+			if (std::memcmp(word, "jlt", 3) == 0) return TOKEN_TYPE::JLT;
+			if (std::memcmp(word, "jge", 3) == 0) return TOKEN_TYPE::JGE;
+			if (std::memcmp(word, "jle", 3) == 0) return TOKEN_TYPE::JLE;
+			break;
+		case 'r':
+			if (std::memcmp(word, "ret", 3) == 0) return TOKEN_TYPE::RET;
+			break;
+		}
+		return TOKEN_TYPE::NAME;
+	case 4:
+		if (std::memcmp(word, "call", 4) == 0) return TOKEN_TYPE::CALL;
+		if (std::memcmp(word, "data", 4) == 0) return TOKEN_TYPE::DATA;
+		if (std::memcmp(word, "push", 4) == 0) return TOKEN_TYPE::PUSH;
+		return TOKEN_TYPE::NAME;
+	default:
+		return TOKEN_TYPE::NAME;
+	}
+}
+
+/*!
+Определяет длину токена, начинающегося с заданного индекса
+\param[in] str Строка
+\param[in] start_index Индекс начала токена
+\param[out] type Тип токена
+\return Индекс символа, следующего за токеном
+\throw TokenizerError В случае, если токен не был распознан
+*/
+int DfaTokenizer::scan_token(std::string_view str, int start_index, TOKEN_TYPE& type) const {
+	const int n = str.size();
+	int i = start_index;
+	unsigned char ch = str[i];
+
+	// Имя или зарезервированное слово
+	if (is_letter(ch)) {
+		i++;
+		while (i < n && is_word_char(str[i])) {
+			i++;
+		}
+		type = classify_word(str, start_index, i - start_index);
+		return i;
+	}
+
+	// Число
+	if (is_digit(ch)) {
+		if (ch == '0' && i + 2 < n) {
+			unsigned char prefix = str[i + 1];
+			bool (*is_base_digit)(unsigned char) = nullptr;
+
+			if (prefix == 'x' || prefix == 'X') {
+				is_base_digit = is_hex_digit;
+				type = TOKEN_TYPE::HEX_NUMBER;
+			}
+			else if (prefix == 'o' || prefix == 'O') {
+				is_base_digit = is_octal_digit;
+				type = TOKEN_TYPE::OCTAL_NUMBER;
+			}
+			else if (prefix == 'b' || prefix == 'B') {
+				is_base_digit = is_binary_digit;
+				type = TOKEN_TYPE::BINARY_NUMBER;
+			}
+
+			// Префикс системы счисления учитывается, только если за ним есть хотя бы одна цифра
+			if (is_base_digit != nullptr && is_base_digit(str[i + 2])) {
+				i += 3;
+				while (i < n && is_base_digit(str[i])) {
+					i++;
+				}
+				return i;
+			}
+		}
+
+		while (i < n && is_digit(str[i])) {
+			i++;
+		}
+		type = TOKEN_TYPE::DECIMAL_NUMBER;
+		return i;
+	}
+
+	// Пробельные символы
+	if (is_space(ch)) {
+		while (i < n && is_space(str[i])) {
+			i++;
+		}
+		type = TOKEN_TYPE::SPACE;
+		return i;
+	}
+
+	switch (ch) {
+	case '"': {
+		// Строка заканчивается последней кавычкой до конца строки
+		int closing_index = -1;
+		for (int j = i + 1; j < n && !is_line_terminator(str[j]); j++) {
+			if (str[j] == '"') {
+				closing_index = j;
+			}
+		}
+		if (closing_index < 0) {
+			break;
+		}
+		type = TOKEN_TYPE::STRING;
+		return closing_index + 1;
+	}
+	case '\'': {
+		// Управляющие последовательности \n, \t, \' и \\ проверяются раньше одиночного символа
+		if (i + 3 < n && str[i + 1] == '\\' && str[i + 3] == '\'') {
+			char escaped = str[i + 2];
+			if (escaped == 'n' || escaped == 't' || escaped == '\'' || escaped == '\\') {
+				type = TOKEN_TYPE::CHAR;
+				return i + 4;
+			}
+		}
+		if (i + 2 < n && !is_line_terminator(str[i + 1]) && str[i + 2] == '\'') {
+			type = TOKEN_TYPE::CHAR;
+			return i + 3;
+		}
+		break;
+	}
+	case '+':
+		type = TOKEN_TYPE::PLUS;
+		return i + 1;
+	case '-':
+		type = TOKEN_TYPE::MINUS;
+		return i + 1;
+	case ',':
+		type = TOKEN_TYPE::COMMA;
+		return i + 1;
+	case ':':
+		type = TOKEN_TYPE::COLON;
+		return i + 1;
+	case ';':
+		i++;
+		while (i < n && !is_line_terminator(str[i])) {
+			i++;
+		}
+		type = TOKEN_TYPE::COMMENT;
+		return i;
+	}
+
+	throw TokenizerError("Синтаксическая ошибка");
+}
+
+/*!
+\brief Выделяет токены языка псевдо-ассемблера из строки
+
+Выделяет токены языка псевдо-ассемблера из строки, добавляя их во входной вектор
+\param[in] str Входная строка
+\param[out] tokens Считанные токены
+\throw TokenizerError В случае, если в строке встретился недопустимый токен
+*/
+void DfaTokenizer::tokenize(std::string_view str, std::vector<Token>& tokens) {
+	int i = 0;
+	const int n = str.size();
+
+	// Пока не пройдена вся строка...
+	while (i < n) {
+		// ...извлечь очередной токен
+		TOKEN_TYPE type = TOKEN_TYPE::UNSPECIFIED;
+		int end = scan_token(str, i, type);
+
+		// Пробелы и комментарии в список токенов не попадают
+		if (type != TOKEN_TYPE::SPACE && type != TOKEN_TYPE::COMMENT) {
+			tokens.push_back(Token{ type, str.substr(i, end - i), i, end - 1 });
+		}
+
+		i = end;
+	}
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <string_view>
+
+#include "Tokenizer.h"
+
+
+/*!
+\brief Токенайзер для языка псевдо-ассемблера в виде конечного автомата
+
+Выделяет токены за один проход по строке без использования регулярных выражений.
+Возвращает те же токены и бросает те же ошибки, что и Tokenizer
+*/
+class DfaTokenizer : public AbstractTokenizer {
+private:
+	/*!
+	Определяет, является ли идентификатор зарезервированным словом
+	\param[in] str Строка
+	\param[in] start_index Индекс начала идентификатора
+	\param[in] length Длина идентификатора
+	\return Тип зарезервированного слова или TOKEN_TYPE::NAME
+	*/
+	TOKEN_TYPE classify_word(std::string_view str, int start_index, int length) const;
+
+	/*!
+	Определяет длину токена, начинающегося с заданного индекса
+	\param[in] str Строка
+	\param[in] start_index Индекс начала токена
+	\param[out] type Тип токена
+	\return Индекс символа, следующего за токеном
+	\throw TokenizerError В случае, если токен не был распознан
+	*/
+	int scan_token(std::string_view str, int start_index, TOKEN_TYPE& type) const;
+
+public:
+	/*!
+	\brief Выделяет токены языка псевдо-ассемблера из строки
+
+	Выделяет токены языка псевдо-ассемблера из строки
+	\param[in] str Входная строка
+	\param[out] tokens Считанные токены
+	\throw TokenizerError В случае, если в строке встретился недопустимый токен
+	*/
+	void tokenize(std::string_view str, std::vector<Token>& tokens) override;
+};
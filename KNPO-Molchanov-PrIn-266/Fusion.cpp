@@ -0,0 +1,87 @@
+#include <vector>
+#include <string>
+
+#include "Fusion.h"
+#include "Builtins.h"
+
+
+/*!
+Пытается объединить последовательность инструкций, начинающуюся с заданной
+\param[in|out] bytecode Байт-код
+\param[in] address Индекс первой инструкции последовательности
+\param[out] fusions Примененные объединения
+\return Количество объединенных инструкций или 0, если объединение невозможно
+*/
+int FusionPass::fuse_at(Bytecode& bytecode, int address, std::vector<Fusion>& fusions) const {
+	const int instr_count = bytecode.size();
+	if (address + 1 >= instr_count) {
+		return 0;
+	}
+
+	const BytecodeInstr first = bytecode.get_instr(address);
+	const BytecodeInstr second = bytecode.get_instr(address + 1);
+	int line_number = bytecode.get_line_number(address);
+
+	// sub rX, imm + jgt label, rA, rB -> уменьшение и переход
+	if (first.opcode == OPCODE::SUB_IMM && second.opcode == OPCODE::JGT) {
+		bytecode.replace(address, BytecodeInstr{ OPCODE::SUB_IMM_JGT, first.dest, second.src1, second.src2, first.imm_value, second.address });
+		fusions.push_back(Fusion{ address, line_number, 2, "sub + jgt -> SUB_IMM_JGT" });
+		return 2;
+	}
+
+	// set rX, name / ld rX, name + call <встроенная подпрограмма>
+	if ((first.opcode == OPCODE::SET_MEM || first.opcode == OPCODE::LD) && second.opcode == OPCODE::CALL_BUILTIN) {
+		if (first.opcode == OPCODE::SET_MEM) {
+			bytecode.replace(address, BytecodeInstr{ OPCODE::SET_MEM_CALL, first.dest, 0, 0, first.imm_value, second.imm_value });
+			fusions.push_back(Fusion{ address, line_number, 2, "set + call " + BuiltinRegistry::instance().get_name(second.imm_value) + " -> SET_MEM_CALL" });
+		}
+		else {
+			bytecode.replace(address, BytecodeInstr{ OPCODE::LD_CALL, first.dest, 0, 0, first.imm_value, second.imm_value });
+			fusions.push_back(Fusion{ address, line_number, 2, "ld + call " + BuiltinRegistry::instance().get_name(second.imm_value) + " -> LD_CALL" });
+		}
+		return 2;
+	}
+
+	// ldi rD, rA + add rD, x + sti rA, rD -> чтение, изменение и запись ячейки памяти
+	if (first.opcode == OPCODE::LDI && address + 2 < instr_count) {
+		const BytecodeInstr third = bytecode.get_instr(address + 2);
+		uint8_t value_reg = first.dest;
+		uint8_t address_reg = first.src1;
+
+		// Если регистр адреса совпадает с регистром значения, адрес теряется после чтения
+		bool is_read_modify_write = value_reg != address_reg
+			&& (second.opcode == OPCODE::ADD_IMM || second.opcode == OPCODE::ADD_REG)
+			&& second.dest == value_reg
+			&& third.opcode == OPCODE::STI && third.dest == address_reg && third.src1 == value_reg;
+
+		if (is_read_modify_write) {
+			if (second.opcode == OPCODE::ADD_IMM) {
+				bytecode.replace(address, BytecodeInstr{ OPCODE::LDI_ADD_IMM_STI, value_reg, address_reg, 0, second.imm_value, 0 });
+				fusions.push_back(Fusion{ address, line_number, 3, "ldi + add + sti -> LDI_ADD_IMM_STI" });
+			}
+			else {
+				bytecode.replace(address, BytecodeInstr{ OPCODE::LDI_ADD_REG_STI, value_reg, address_reg, second.src1, 0, 0 });
+				fusions.push_back(Fusion{ address, line_number, 3, "ldi + add + sti -> LDI_ADD_REG_STI" });
+			}
+			return 3;
+		}
+	}
+
+	return 0;
+}
+
+/*!
+Объединяет последовательности инструкций байт-кода в суперинструкции
+\param[in|out] bytecode Байт-код
+\param[out] fusions Примененные объединения
+*/
+void FusionPass::apply(Bytecode& bytecode, std::vector<Fusion>& fusions) const {
+	int address = 0;
+
+	while (address < bytecode.size()) {
+		int fused_count = fuse_at(bytecode, address, fusions);
+
+		// Объединенные инструкции не могут начинать новую последовательность
+		address += fused_count > 0 ? fused_count : 1;
+	}
+}
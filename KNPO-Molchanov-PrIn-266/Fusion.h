@@ -0,0 +1,49 @@
+#pragma once
+
+#include <vector>
+#include <string>
+
+#include "Bytecode.h"
+
+/*!
+Сведения о последовательности инструкций, объединенной в суперинструкцию
+*/
+struct Fusion {
+	/// Индекс первой инструкции последовательности
+	int address;
+	/// Номер строки первой инструкции последовательности
+	int line_number;
+	/// Количество объединенных инструкций
+	int length;
+	/// Описание объединения, например "sub + jgt -> SUB_IMM_JGT"
+	std::string description;
+};
+
+/*!
+\brief Проход, объединяющий часто встречающиеся последовательности инструкций в суперинструкции
+
+Суперинструкция записывается на место первой инструкции последовательности, остальные
+инструкции не удаляются. Поэтому индексы инструкций, а значит и адреса переходов, не меняются,
+а переход в середину последовательности выполняет исходные инструкции. Если ошибка возникает
+в одной из объединенных инструкций, суперинструкция сохраняет индекс именно этой инструкции,
+поэтому сообщение об ошибке указывает на правильную строку
+*/
+class FusionPass {
+private:
+	/*!
+	Пытается объединить последовательность инструкций, начинающуюся с заданной
+	\param[in|out] bytecode Байт-код
+	\param[in] address Индекс первой инструкции последовательности
+	\param[out] fusions Примененные объединения
+	\return Количество объединенных инструкций или 0, если объединение невозможно
+	*/
+	int fuse_at(Bytecode& bytecode, int address, std::vector<Fusion>& fusions) const;
+
+public:
+	/*!
+	Объединяет последовательности инструкций байт-кода в суперинструкции
+	\param[in|out] bytecode Байт-код
+	\param[out] fusions Примененные объединения
+	*/
+	void apply(Bytecode& bytecode, std::vector<Fusion>& fusions) const;
+};
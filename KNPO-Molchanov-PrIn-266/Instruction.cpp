@@ -4,6 +4,7 @@
 
 #include "Instruction.h"
 #include "ProgramState.h"
+#include "Builtins.h"
 
 
 /*
@@ -23,6 +24,81 @@ int Instr::get_line_number() const {
 }
 
 
+BranchInstr::BranchInstr(const std::string& label_name) : label_name{ label_name } {
+}
+
+std::string BranchInstr::get_label_name() const {
+	return label_name;
+}
+
+/*!
+Устанавливает индекс инструкции, на которую указывает метка
+\param[in] new_address Индекс инструкции
+*/
+void BranchInstr::set_address(int new_address) {
+	address = new_address;
+}
+
+/*!
+Возвращает индекс инструкции, на которую указывает метка
+\return Индекс инструкции или -1, если метка ещё не разрешена
+*/
+int BranchInstr::get_address() const {
+	return address;
+}
+
+/*!
+Возвращает флаг, была ли метка разрешена при компоновке
+\return Флаг, была ли метка разрешена
+*/
+bool BranchInstr::is_linked() const {
+	return address >= 0;
+}
+
+
+DataAccessInstr::DataAccessInstr(const std::string& var_name) : var_name{ var_name } {
+}
+
+std::string DataAccessInstr::get_var_name() const {
+	return var_name;
+}
+
+/*!
+Устанавливает адрес ячейки памяти
+\param[in] new_data_address Адрес ячейки памяти
+*/
+void DataAccessInstr::set_data_address(int new_data_address) {
+	data_address = new_data_address;
+}
+
+/*!
+Возвращает адрес ячейки памяти
+\return Адрес ячейки памяти или -1, если данные ещё не размещены
+*/
+int DataAccessInstr::get_data_address() const {
+	return data_address;
+}
+
+/*!
+Возвращает флаг, был ли вычислен адрес ячейки памяти при размещении данных
+\return Флаг, был ли вычислен адрес
+*/
+bool DataAccessInstr::is_data_placed() const {
+	return data_address >= 0;
+}
+
+/*!
+Проверяет, что адрес ячейки памяти вычислен, перед записью инструкции в байт-код
+\param[in] instr Инструкция
+\throw RuntimeError В случае, если данные ещё не размещены
+*/
+static void check_data_placed(const DataAccessInstr& instr) {
+	if (!instr.is_data_placed()) {
+		throw RuntimeError("Ячейка памяти \"" + instr.get_var_name() + "\" не размещена");
+	}
+}
+
+
 AddRegInstr::AddRegInstr(REGISTER dest, REGISTER src) : dest{ dest }, src{ src } {
 }
 
@@ -32,6 +108,10 @@ void AddRegInstr::execute(ProgramState& state) const {
 	state.inc_pc();
 }
 
+void AddRegInstr::emit(Bytecode& bytecode) const {
+	bytecode.emit(BytecodeInstr{ OPCODE::ADD_REG, (uint8_t)dest, (uint8_t)src, 0, 0, 0 }, get_line_number());
+}
+
 REGISTER AddRegInstr::get_dest() const {
 	return dest;
 }
@@ -50,6 +130,10 @@ void AddImmInstr::execute(ProgramState& state) const {
 	state.inc_pc();
 }
 
+void AddImmInstr::emit(Bytecode& bytecode) const {
+	bytecode.emit(BytecodeInstr{ OPCODE::ADD_IMM, (uint8_t)dest, 0, 0, imm_value, 0 }, get_line_number());
+}
+
 REGISTER AddImmInstr::get_dest() const {
 	return dest;
 }
@@ -68,6 +152,10 @@ void SubRegInstr::execute(ProgramState& state) const {
 	state.inc_pc();
 }
 
+void SubRegInstr::emit(Bytecode& bytecode) const {
+	bytecode.emit(BytecodeInstr{ OPCODE::SUB_REG, (uint8_t)dest, (uint8_t)src, 0, 0, 0 }, get_line_number());
+}
+
 REGISTER SubRegInstr::get_dest() const {
 	return dest;
 }
@@ -86,6 +174,10 @@ void SubImmInstr::execute(ProgramState& state) const {
 	state.inc_pc();
 }
 
+void SubImmInstr::emit(Bytecode& bytecode) const {
+	bytecode.emit(BytecodeInstr{ OPCODE::SUB_IMM, (uint8_t)dest, 0, 0, imm_value, 0 }, get_line_number());
+}
+
 REGISTER SubImmInstr::get_dest() const {
 	return dest;
 }
@@ -104,6 +196,10 @@ void AndRegInstr::execute(ProgramState& state) const {
 	state.inc_pc();
 }
 
+void AndRegInstr::emit(Bytecode& bytecode) const {
+	bytecode.emit(BytecodeInstr{ OPCODE::AND_REG, (uint8_t)dest, (uint8_t)src, 0, 0, 0 }, get_line_number());
+}
+
 REGISTER AndRegInstr::get_dest() const {
 	return dest;
 }
@@ -122,6 +218,10 @@ void AndImmInstr::execute(ProgramState& state) const {
 	state.inc_pc();
 }
 
+void AndImmInstr::emit(Bytecode& bytecode) const {
+	bytecode.emit(BytecodeInstr{ OPCODE::AND_IMM, (uint8_t)dest, 0, 0, imm_value, 0 }, get_line_number());
+}
+
 REGISTER AndImmInstr::get_dest() const {
 	return dest;
 }
@@ -140,6 +240,10 @@ void OrRegInstr::execute(ProgramState& state) const {
 	state.inc_pc();
 }
 
+void OrRegInstr::emit(Bytecode& bytecode) const {
+	bytecode.emit(BytecodeInstr{ OPCODE::OR_REG, (uint8_t)dest, (uint8_t)src, 0, 0, 0 }, get_line_number());
+}
+
 REGISTER OrRegInstr::get_dest() const {
 	return dest;
 }
@@ -158,6 +262,10 @@ void OrImmInstr::execute(ProgramState& state) const {
 	state.inc_pc();
 }
 
+void OrImmInstr::emit(Bytecode& bytecode) const {
+	bytecode.emit(BytecodeInstr{ OPCODE::OR_IMM, (uint8_t)dest, 0, 0, imm_value, 0 }, get_line_number());
+}
+
 REGISTER OrImmInstr::get_dest() const {
 	return dest;
 }
@@ -176,6 +284,10 @@ void XorRegInstr::execute(ProgramState& state) const {
 	state.inc_pc();
 }
 
+void XorRegInstr::emit(Bytecode& bytecode) const {
+	bytecode.emit(BytecodeInstr{ OPCODE::XOR_REG, (uint8_t)dest, (uint8_t)src, 0, 0, 0 }, get_line_number());
+}
+
 REGISTER XorRegInstr::get_dest() const {
 	return dest;
 }
@@ -194,6 +306,10 @@ void XorImmInstr::execute(ProgramState& state) const {
 	state.inc_pc();
 }
 
+void XorImmInstr::emit(Bytecode& bytecode) const {
+	bytecode.emit(BytecodeInstr{ OPCODE::XOR_IMM, (uint8_t)dest, 0, 0, imm_value, 0 }, get_line_number());
+}
+
 REGISTER XorImmInstr::get_dest() const {
 	return dest;
 }
@@ -212,6 +328,10 @@ void NotInstr::execute(ProgramState& state) const {
 	state.inc_pc();
 }
 
+void NotInstr::emit(Bytecode& bytecode) const {
+	bytecode.emit(BytecodeInstr{ OPCODE::NOT, (uint8_t)reg, 0, 0, 0, 0 }, get_line_number());
+}
+
 REGISTER NotInstr::get_reg() {
 	return reg;
 }
@@ -226,6 +346,10 @@ void ShrRegInstr::execute(ProgramState& state) const {
 	state.inc_pc();
 }
 
+void ShrRegInstr::emit(Bytecode& bytecode) const {
+	bytecode.emit(BytecodeInstr{ OPCODE::SHR_REG, (uint8_t)dest, (uint8_t)src, 0, 0, 0 }, get_line_number());
+}
+
 REGISTER ShrRegInstr::get_dest() const {
 	return dest;
 }
@@ -244,6 +368,10 @@ void ShrImmInstr::execute(ProgramState& state) const {
 	state.inc_pc();
 }
 
+void ShrImmInstr::emit(Bytecode& bytecode) const {
+	bytecode.emit(BytecodeInstr{ OPCODE::SHR_IMM, (uint8_t)dest, 0, 0, imm_value, 0 }, get_line_number());
+}
+
 REGISTER ShrImmInstr::get_dest() const {
 	return dest;
 }
@@ -266,6 +394,10 @@ void ShlRegInstr::execute(ProgramState& state) const {
 	state.inc_pc();
 }
 
+void ShlRegInstr::emit(Bytecode& bytecode) const {
+	bytecode.emit(BytecodeInstr{ OPCODE::SHL_REG, (uint8_t)dest, (uint8_t)src, 0, 0, 0 }, get_line_number());
+}
+
 REGISTER ShlRegInstr::get_dest() const {
 	return dest;
 }
@@ -287,6 +419,10 @@ void ShlImmInstr::execute(ProgramState& state) const {
 	state.inc_pc();
 }
 
+void ShlImmInstr::emit(Bytecode& bytecode) const {
+	bytecode.emit(BytecodeInstr{ OPCODE::SHL_IMM, (uint8_t)dest, 0, 0, imm_value, 0 }, get_line_number());
+}
+
 REGISTER ShlImmInstr::get_dest() const {
 	return dest;
 }
@@ -295,6 +431,135 @@ int ShlImmInstr::get_imm_value() const {
 	return imm_value;
 }
 
+MulRegInstr::MulRegInstr(REGISTER dest, REGISTER src) : dest{ dest }, src{ src } {
+}
+
+void MulRegInstr::execute(ProgramState& state) const {
+	int result = state.get_register_value(dest) * state.get_register_value(src);
+	state.set_register_value(dest, result);
+	state.inc_pc();
+}
+
+void MulRegInstr::emit(Bytecode& bytecode) const {
+	bytecode.emit(BytecodeInstr{ OPCODE::MUL_REG, (uint8_t)dest, (uint8_t)src, 0, 0, 0 }, get_line_number());
+}
+
+REGISTER MulRegInstr::get_dest() const {
+	return dest;
+}
+
+REGISTER MulRegInstr::get_src() const {
+	return src;
+}
+
+
+MulImmInstr::MulImmInstr(REGISTER dest, int imm_value) : dest{ dest }, imm_value{ imm_value } {
+}
+
+void MulImmInstr::execute(ProgramState& state) const {
+	int result = state.get_register_value(dest) * imm_value;
+	state.set_register_value(dest, result);
+	state.inc_pc();
+}
+
+void MulImmInstr::emit(Bytecode& bytecode) const {
+	bytecode.emit(BytecodeInstr{ OPCODE::MUL_IMM, (uint8_t)dest, 0, 0, imm_value, 0 }, get_line_number());
+}
+
+REGISTER MulImmInstr::get_dest() const {
+	return dest;
+}
+
+int MulImmInstr::get_imm_value() const {
+	return imm_value;
+}
+
+DivRegInstr::DivRegInstr(REGISTER dest, REGISTER src) : dest{ dest }, src{ src } {
+}
+
+void DivRegInstr::execute(ProgramState& state) const {
+	int result = divide(state.get_register_value(dest), state.get_register_value(src));
+	state.set_register_value(dest, result);
+	state.inc_pc();
+}
+
+void DivRegInstr::emit(Bytecode& bytecode) const {
+	bytecode.emit(BytecodeInstr{ OPCODE::DIV_REG, (uint8_t)dest, (uint8_t)src, 0, 0, 0 }, get_line_number());
+}
+
+REGISTER DivRegInstr::get_dest() const {
+	return dest;
+}
+
+REGISTER DivRegInstr::get_src() const {
+	return src;
+}
+
+
+DivImmInstr::DivImmInstr(REGISTER dest, int imm_value) : dest{ dest }, imm_value{ imm_value } {
+}
+
+void DivImmInstr::execute(ProgramState& state) const {
+	int result = divide(state.get_register_value(dest), imm_value);
+	state.set_register_value(dest, result);
+	state.inc_pc();
+}
+
+void DivImmInstr::emit(Bytecode& bytecode) const {
+	bytecode.emit(BytecodeInstr{ OPCODE::DIV_IMM, (uint8_t)dest, 0, 0, imm_value, 0 }, get_line_number());
+}
+
+REGISTER DivImmInstr::get_dest() const {
+	return dest;
+}
+
+int DivImmInstr::get_imm_value() const {
+	return imm_value;
+}
+
+ModRegInstr::ModRegInstr(REGISTER dest, REGISTER src) : dest{ dest }, src{ src } {
+}
+
+void ModRegInstr::execute(ProgramState& state) const {
+	int result = modulo(state.get_register_value(dest), state.get_register_value(src));
+	state.set_register_value(dest, result);
+	state.inc_pc();
+}
+
+void ModRegInstr::emit(Bytecode& bytecode) const {
+	bytecode.emit(BytecodeInstr{ OPCODE::MOD_REG, (uint8_t)dest, (uint8_t)src, 0, 0, 0 }, get_line_number());
+}
+
+REGISTER ModRegInstr::get_dest() const {
+	return dest;
+}
+
+REGISTER ModRegInstr::get_src() const {
+	return src;
+}
+
+
+ModImmInstr::ModImmInstr(REGISTER dest, int imm_value) : dest{ dest }, imm_value{ imm_value } {
+}
+
+void ModImmInstr::execute(ProgramState& state) const {
+	int result = modulo(state.get_register_value(dest), imm_value);
+	state.set_register_value(dest, result);
+	state.inc_pc();
+}
+
+void ModImmInstr::emit(Bytecode& bytecode) const {
+	bytecode.emit(BytecodeInstr{ OPCODE::MOD_IMM, (uint8_t)dest, 0, 0, imm_value, 0 }, get_line_number());
+}
+
+REGISTER ModImmInstr::get_dest() const {
+	return dest;
+}
+
+int ModImmInstr::get_imm_value() const {
+	return imm_value;
+}
+
 
 SetRegInstr::SetRegInstr(REGISTER dest, REGISTER src) : dest{ dest }, src{ src } {
 }
@@ -304,6 +569,10 @@ void SetRegInstr::execute(ProgramState& state) const {
 	state.inc_pc();
 }
 
+void SetRegInstr::emit(Bytecode& bytecode) const {
+	bytecode.emit(BytecodeInstr{ OPCODE::SET_REG, (uint8_t)dest, (uint8_t)src, 0, 0, 0 }, get_line_number());
+}
+
 REGISTER SetRegInstr::get_dest() const {
 	return dest;
 }
@@ -321,6 +590,10 @@ void SetImmInstr::execute(ProgramState& state) const {
 	state.inc_pc();
 }
 
+void SetImmInstr::emit(Bytecode& bytecode) const {
+	bytecode.emit(BytecodeInstr{ OPCODE::SET_IMM, (uint8_t)dest, 0, 0, imm_value, 0 }, get_line_number());
+}
+
 REGISTER SetImmInstr::get_dest() const {
 	return dest;
 }
@@ -330,57 +603,65 @@ int SetImmInstr::get_imm_value() const {
 }
 
 
-SetNameInstr::SetNameInstr(REGISTER dest, const std::string& var_name) : dest{ dest }, var_name{ var_name } {
+SetNameInstr::SetNameInstr(REGISTER dest, const std::string& var_name) : DataAccessInstr{ var_name }, dest{ dest } {
 }
 
 void SetNameInstr::execute(ProgramState& state) const {
-	int value = state.get_memory_value_by_name(var_name);
+	int value = is_data_placed() ? state.get_data_value(get_data_address()) : state.get_memory_value_by_name(get_var_name());
 	state.set_register_value(dest, value);
 	state.inc_pc();
 }
 
-REGISTER SetNameInstr::get_dest() const {
-	return dest;
+void SetNameInstr::emit(Bytecode& bytecode) const {
+	check_data_placed(*this);
+	bytecode.emit(BytecodeInstr{ OPCODE::SET_MEM, (uint8_t)dest, 0, 0, get_data_address(), 0 }, get_line_number());
 }
 
-std::string SetNameInstr::get_var_name() const {
-	return var_name;
+REGISTER SetNameInstr::get_dest() const {
+	return dest;
 }
 
 
-LdInstr::LdInstr(REGISTER dest, const std::string& var_name) : dest{ dest }, var_name{ var_name } {
+LdInstr::LdInstr(REGISTER dest, const std::string& var_name) : DataAccessInstr{ var_name }, dest{ dest } {
 }
 
 void LdInstr::execute(ProgramState& state) const {
-	int address = state.get_address_of_data_label(var_name);
+	int address = is_data_placed() ? get_data_address() : state.get_address_of_data_label(get_var_name());
 	state.set_register_value(dest, address);
 	state.inc_pc();
 }
 
-REGISTER LdInstr::get_dest() const {
-	return dest;
+void LdInstr::emit(Bytecode& bytecode) const {
+	check_data_placed(*this);
+	bytecode.emit(BytecodeInstr{ OPCODE::LD, (uint8_t)dest, 0, 0, get_data_address(), 0 }, get_line_number());
 }
 
-std::string LdInstr::get_var_name() const {
-	return var_name;
+REGISTER LdInstr::get_dest() const {
+	return dest;
 }
 
 
-StInstr::StInstr(const std::string& var_name, REGISTER src) : var_name{ var_name }, src{ src } {
+StInstr::StInstr(const std::string& var_name, REGISTER src) : DataAccessInstr{ var_name }, src{ src } {
 }
 
 void StInstr::execute(ProgramState& state) const {
 	int value = state.get_register_value(src);
-	state.set_memory_value_by_name(var_name, value);
+	if (is_data_placed()) {
+		state.set_data_value(get_data_address(), value);
+	}
+	else {
+		state.set_memory_value_by_name(get_var_name(), value);
+	}
 	state.inc_pc();
 }
 
-REGISTER StInstr::get_src() const {
-	return src;
+void StInstr::emit(Bytecode& bytecode) const {
+	check_data_placed(*this);
+	bytecode.emit(BytecodeInstr{ OPCODE::ST, 0, (uint8_t)src, 0, get_data_address(), 0 }, get_line_number());
 }
 
-std::string StInstr::get_var_name() const {
-	return var_name;
+REGISTER StInstr::get_src() const {
+	return src;
 }
 
 
@@ -394,6 +675,10 @@ void LdiInstr::execute(ProgramState& state) const {
 	state.inc_pc();
 }
 
+void LdiInstr::emit(Bytecode& bytecode) const {
+	bytecode.emit(BytecodeInstr{ OPCODE::LDI, (uint8_t)dest, (uint8_t)src, 0, 0, 0 }, get_line_number());
+}
+
 REGISTER LdiInstr::get_dest() const {
 	return dest;
 }
@@ -412,6 +697,10 @@ void StiInstr::execute(ProgramState& state) const {
 	state.inc_pc();
 }
 
+void StiInstr::emit(Bytecode& bytecode) const {
+	bytecode.emit(BytecodeInstr{ OPCODE::STI, (uint8_t)dest, (uint8_t)src, 0, 0, 0 }, get_line_number());
+}
+
 REGISTER StiInstr::get_dest() const {
 	return dest;
 }
@@ -421,20 +710,161 @@ REGISTER StiInstr::get_src() const {
 }
 
 
-JmpInstr::JmpInstr(const std::string& label_name) : label_name{ label_name } {
+LdiOffsetInstr::LdiOffsetInstr(REGISTER dest, REGISTER src, int offset) : dest{ dest }, src{ src }, offset{ offset } {
+}
+
+void LdiOffsetInstr::execute(ProgramState& state) const {
+	int address = state.get_register_value(src) + offset;
+	int value = state.get_memory_value(address);
+	state.set_register_value(dest, value);
+	state.inc_pc();
+}
+
+void LdiOffsetInstr::emit(Bytecode& bytecode) const {
+	bytecode.emit(BytecodeInstr{ OPCODE::LDI_OFFSET, (uint8_t)dest, (uint8_t)src, 0, offset, 0 }, get_line_number());
+}
+
+REGISTER LdiOffsetInstr::get_dest() const {
+	return dest;
+}
+
+REGISTER LdiOffsetInstr::get_src() const {
+	return src;
+}
+
+int LdiOffsetInstr::get_offset() const {
+	return offset;
+}
+
+
+LdiIndexInstr::LdiIndexInstr(REGISTER dest, REGISTER src, REGISTER index) : dest{ dest }, src{ src }, index{ index } {
+}
+
+void LdiIndexInstr::execute(ProgramState& state) const {
+	int address = state.get_register_value(src) + state.get_register_value(index);
+	int value = state.get_memory_value(address);
+	state.set_register_value(dest, value);
+	state.inc_pc();
+}
+
+void LdiIndexInstr::emit(Bytecode& bytecode) const {
+	bytecode.emit(BytecodeInstr{ OPCODE::LDI_INDEX, (uint8_t)dest, (uint8_t)src, (uint8_t)index, 0, 0 }, get_line_number());
+}
+
+REGISTER LdiIndexInstr::get_dest() const {
+	return dest;
+}
+
+REGISTER LdiIndexInstr::get_src() const {
+	return src;
+}
+
+REGISTER LdiIndexInstr::get_index() const {
+	return index;
+}
+
+
+StiOffsetInstr::StiOffsetInstr(REGISTER dest, int offset, REGISTER src) : dest{ dest }, offset{ offset }, src{ src } {
+}
+
+void StiOffsetInstr::execute(ProgramState& state) const {
+	int address = state.get_register_value(dest) + offset;
+	int value = state.get_register_value(src);
+	state.set_memory_value(address, value);
+	state.inc_pc();
+}
+
+void StiOffsetInstr::emit(Bytecode& bytecode) const {
+	bytecode.emit(BytecodeInstr{ OPCODE::STI_OFFSET, (uint8_t)dest, (uint8_t)src, 0, offset, 0 }, get_line_number());
+}
+
+REGISTER StiOffsetInstr::get_dest() const {
+	return dest;
+}
+
+int StiOffsetInstr::get_offset() const {
+	return offset;
+}
+
+REGISTER StiOffsetInstr::get_src() const {
+	return src;
+}
+
+
+StiIndexInstr::StiIndexInstr(REGISTER dest, REGISTER index, REGISTER src) : dest{ dest }, index{ index }, src{ src } {
+}
+
+void StiIndexInstr::execute(ProgramState& state) const {
+	int address = state.get_register_value(dest) + state.get_register_value(index);
+	int value = state.get_register_value(src);
+	state.set_memory_value(address, value);
+	state.inc_pc();
+}
+
+void StiIndexInstr::emit(Bytecode& bytecode) const {
+	bytecode.emit(BytecodeInstr{ OPCODE::STI_INDEX, (uint8_t)dest, (uint8_t)src, (uint8_t)index, 0, 0 }, get_line_number());
+}
+
+REGISTER StiIndexInstr::get_dest() const {
+	return dest;
+}
+
+REGISTER StiIndexInstr::get_index() const {
+	return index;
+}
+
+REGISTER StiIndexInstr::get_src() const {
+	return src;
+}
+
+
+PushInstr::PushInstr(REGISTER src) : src{ src } {
+}
+
+void PushInstr::execute(ProgramState& state) const {
+	state.push(state.get_register_value(src));
+	state.inc_pc();
+}
+
+void PushInstr::emit(Bytecode& bytecode) const {
+	bytecode.emit(BytecodeInstr{ OPCODE::PUSH, 0, (uint8_t)src, 0, 0, 0 }, get_line_number());
+}
+
+REGISTER PushInstr::get_src() const {
+	return src;
+}
+
+
+PopInstr::PopInstr(REGISTER dest) : dest{ dest } {
+}
+
+void PopInstr::execute(ProgramState& state) const {
+	state.set_register_value(dest, state.pop());
+	state.inc_pc();
+}
+
+void PopInstr::emit(Bytecode& bytecode) const {
+	bytecode.emit(BytecodeInstr{ OPCODE::POP, (uint8_t)dest, 0, 0, 0, 0 }, get_line_number());
+}
+
+REGISTER PopInstr::get_dest() const {
+	return dest;
+}
+
+
+JmpInstr::JmpInstr(const std::string& label_name) : BranchInstr{ label_name } {
 }
 
 void JmpInstr::execute(ProgramState& state) const {
-	int address = state.get_label_address(label_name);
-	state.set_pc(address);
+	state.set_pc(get_address());
 }
 
-std::string JmpInstr::get_label_name() {
-	return label_name;
+void JmpInstr::emit(Bytecode& bytecode) const {
+	bytecode.emit(BytecodeInstr{ OPCODE::JMP, 0, 0, 0, 0, get_address() }, get_line_number());
 }
 
 
-JeqInstr::JeqInstr(const std::string& label_name, REGISTER src1, REGISTER src2) : label_name{ label_name }, src1{ src1 }, src2{ src2 } {
+JeqInstr::JeqInstr(const std::string& label_name, REGISTER src1, REGISTER src2) : BranchInstr{ label_name }, src1{ src1 }, src2{ src2 } {
 }
 
 void JeqInstr::execute(ProgramState& state) const {
@@ -442,14 +872,17 @@ void JeqInstr::execute(ProgramState& state) const {
 	int b = state.get_register_value(src2);
 
 	if (a == b) {
-		int address = state.get_label_address(label_name);
-		state.set_pc(address);
+		state.set_pc(get_address());
 	}
 	else {
 		state.inc_pc();
 	}
 }
 
+void JeqInstr::emit(Bytecode& bytecode) const {
+	bytecode.emit(BytecodeInstr{ OPCODE::JEQ, 0, (uint8_t)src1, (uint8_t)src2, 0, get_address() }, get_line_number());
+}
+
 REGISTER JeqInstr::get_src1() const {
 	return src1;
 }
@@ -458,12 +891,90 @@ REGISTER JeqInstr::get_src2() const {
 	return src2;
 }
 
-std::string JeqInstr::get_label_name() {
-	return label_name;
+
+JeqImmInstr::JeqImmInstr(const std::string& label_name, REGISTER src1, int imm_value) : BranchInstr{ label_name }, src1{ src1 }, imm_value{ imm_value } {
+}
+
+void JeqImmInstr::execute(ProgramState& state) const {
+	int a = state.get_register_value(src1);
+
+	if (a == imm_value) {
+		state.set_pc(get_address());
+	}
+	else {
+		state.inc_pc();
+	}
+}
+
+void JeqImmInstr::emit(Bytecode& bytecode) const {
+	bytecode.emit(BytecodeInstr{ OPCODE::JEQ_IMM, 0, (uint8_t)src1, 0, imm_value, get_address() }, get_line_number());
+}
+
+REGISTER JeqImmInstr::get_src1() const {
+	return src1;
+}
+
+int JeqImmInstr::get_imm_value() const {
+	return imm_value;
+}
+
+
+JneInstr::JneInstr(const std::string& label_name, REGISTER src1, REGISTER src2) : BranchInstr{ label_name }, src1{ src1 }, src2{ src2 } {
+}
+
+void JneInstr::execute(ProgramState& state) const {
+	int a = state.get_register_value(src1);
+	int b = state.get_register_value(src2);
+
+	if (a != b) {
+		state.set_pc(get_address());
+	}
+	else {
+		state.inc_pc();
+	}
+}
+
+void JneInstr::emit(Bytecode& bytecode) const {
+	bytecode.emit(BytecodeInstr{ OPCODE::JNE, 0, (uint8_t)src1, (uint8_t)src2, 0, get_address() }, get_line_number());
+}
+
+REGISTER JneInstr::get_src1() const {
+	return src1;
+}
+
+REGISTER JneInstr::get_src2() const {
+	return src2;
+}
+
+
+JneImmInstr::JneImmInstr(const std::string& label_name, REGISTER src1, int imm_value) : BranchInstr{ label_name }, src1{ src1 }, imm_value{ imm_value } {
+}
+
+void JneImmInstr::execute(ProgramState& state) const {
+	int a = state.get_register_value(src1);
+
+	if (a != imm_value) {
+		state.set_pc(get_address());
+	}
+	else {
+		state.inc_pc();
+	}
 }
 
+void JneImmInstr::emit(Bytecode& bytecode) const {
+	bytecode.emit(BytecodeInstr{ OPCODE::JNE_IMM, 0, (uint8_t)src1, 0, imm_value, get_address() }, get_line_number());
+}
 
-JgtInstr::JgtInstr(const std::string& label_name, REGISTER src1, REGISTER src2) : label_name{ label_name }, src1{ src1 }, src2{ src2 } {
+REGISTER JneImmInstr::get_src1() const {
+	return src1;
+}
+
+int JneImmInstr::get_imm_value() const {
+	return imm_value;
+}
+
+
+JgtInstr::JgtInstr(const std::string& label_name, REGISTER src1, REGISTER src2) : BranchInstr{ label_name }, src1{ src1 }, src2{ src2 } {
 }
 
 void JgtInstr::execute(ProgramState& state) const {
@@ -471,14 +982,17 @@ void JgtInstr::execute(ProgramState& state) const {
 	int b = state.get_register_value(src2);
 
 	if (a > b) {
-		int address = state.get_label_address(label_name);
-		state.set_pc(address);
+		state.set_pc(get_address());
 	}
 	else {
 		state.inc_pc();
 	}
 }
 
+void JgtInstr::emit(Bytecode& bytecode) const {
+	bytecode.emit(BytecodeInstr{ OPCODE::JGT, 0, (uint8_t)src1, (uint8_t)src2, 0, get_address() }, get_line_number());
+}
+
 REGISTER JgtInstr::get_src1() const {
 	return src1;
 }
@@ -487,20 +1001,235 @@ REGISTER JgtInstr::get_src2() const {
 	return src2;
 }
 
-std::string JgtInstr::get_label_name() {
-	return label_name;
+
+JgtImmInstr::JgtImmInstr(const std::string& label_name, REGISTER src1, int imm_value) : BranchInstr{ label_name }, src1{ src1 }, imm_value{ imm_value } {
+}
+
+void JgtImmInstr::execute(ProgramState& state) const {
+	int a = state.get_register_value(src1);
+
+	if (a > imm_value) {
+		state.set_pc(get_address());
+	}
+	else {
+		state.inc_pc();
+	}
+}
+
+void JgtImmInstr::emit(Bytecode& bytecode) const {
+	bytecode.emit(BytecodeInstr{ OPCODE::JGT_IMM, 0, (uint8_t)src1, 0, imm_value, get_address() }, get_line_number());
+}
+
+REGISTER JgtImmInstr::get_src1() const {
+	return src1;
+}
+
+int JgtImmInstr::get_imm_value() const {
+	return imm_value;
+}
+
+
+JltInstr::JltInstr(const std::string& label_name, REGISTER src1, REGISTER src2) : BranchInstr{ label_name }, src1{ src1 }, src2{ src2 } {
+}
+
+void JltInstr::execute(ProgramState& state) const {
+	int a = state.get_register_value(src1);
+	int b = state.get_register_value(src2);
+
+	if (a < b) {
+		state.set_pc(get_address());
+	}
+	else {
+		state.inc_pc();
+	}
+}
+
+void JltInstr::emit(Bytecode& bytecode) const {
+	bytecode.emit(BytecodeInstr{ OPCODE::JLT, 0, (uint8_t)src1, (uint8_t)src2, 0, get_address() }, get_line_number());
+}
+
+REGISTER JltInstr::get_src1() const {
+	return src1;
+}
+
+REGISTER JltInstr::get_src2() const {
+	return src2;
+}
+
+
+JltImmInstr::JltImmInstr(const std::string& label_name, REGISTER src1, int imm_value) : BranchInstr{ label_name }, src1{ src1 }, imm_value{ imm_value } {
+}
+
+void JltImmInstr::execute(ProgramState& state) const {
+	int a = state.get_register_value(src1);
+
+	if (a < imm_value) {
+		state.set_pc(get_address());
+	}
+	else {
+		state.inc_pc();
+	}
+}
+
+void JltImmInstr::emit(Bytecode& bytecode) const {
+	bytecode.emit(BytecodeInstr{ OPCODE::JLT_IMM, 0, (uint8_t)src1, 0, imm_value, get_address() }, get_line_number());
+}
+
+REGISTER JltImmInstr::get_src1() const {
+	return src1;
+}
+
+int JltImmInstr::get_imm_value() const {
+	return imm_value;
+}
+
+
+JgeInstr::JgeInstr(const std::string& label_name, REGISTER src1, REGISTER src2) : BranchInstr{ label_name }, src1{ src1 }, src2{ src2 } {
+}
+
+void JgeInstr::execute(ProgramState& state) const {
+	int a = state.get_register_value(src1);
+	int b = state.get_register_value(src2);
+
+	if (a >= b) {
+		state.set_pc(get_address());
+	}
+	else {
+		state.inc_pc();
+	}
+}
+
+void JgeInstr::emit(Bytecode& bytecode) const {
+	bytecode.emit(BytecodeInstr{ OPCODE::JGE, 0, (uint8_t)src1, (uint8_t)src2, 0, get_address() }, get_line_number());
+}
+
+REGISTER JgeInstr::get_src1() const {
+	return src1;
+}
+
+REGISTER JgeInstr::get_src2() const {
+	return src2;
+}
+
+
+JgeImmInstr::JgeImmInstr(const std::string& label_name, REGISTER src1, int imm_value) : BranchInstr{ label_name }, src1{ src1 }, imm_value{ imm_value } {
+}
+
+void JgeImmInstr::execute(ProgramState& state) const {
+	int a = state.get_register_value(src1);
+
+	if (a >= imm_value) {
+		state.set_pc(get_address());
+	}
+	else {
+		state.inc_pc();
+	}
+}
+
+void JgeImmInstr::emit(Bytecode& bytecode) const {
+	bytecode.emit(BytecodeInstr{ OPCODE::JGE_IMM, 0, (uint8_t)src1, 0, imm_value, get_address() }, get_line_number());
+}
+
+REGISTER JgeImmInstr::get_src1() const {
+	return src1;
+}
+
+int JgeImmInstr::get_imm_value() const {
+	return imm_value;
+}
+
+
+JleInstr::JleInstr(const std::string& label_name, REGISTER src1, REGISTER src2) : BranchInstr{ label_name }, src1{ src1 }, src2{ src2 } {
+}
+
+void JleInstr::execute(ProgramState& state) const {
+	int a = state.get_register_value(src1);
+	int b = state.get_register_value(src2);
+
+	if (a <= b) {
+		state.set_pc(get_address());
+	}
+	else {
+		state.inc_pc();
+	}
+}
+
+void JleInstr::emit(Bytecode& bytecode) const {
+	bytecode.emit(BytecodeInstr{ OPCODE::JLE, 0, (uint8_t)src1, (uint8_t)src2, 0, get_address() }, get_line_number());
+}
+
+REGISTER JleInstr::get_src1() const {
+	return src1;
+}
+
+REGISTER JleInstr::get_src2() const {
+	return src2;
+}
+
+
+JleImmInstr::JleImmInstr(const std::string& label_name, REGISTER src1, int imm_value) : BranchInstr{ label_name }, src1{ src1 }, imm_value{ imm_value } {
+}
+
+void JleImmInstr::execute(ProgramState& state) const {
+	int a = state.get_register_value(src1);
+
+	if (a <= imm_value) {
+		state.set_pc(get_address());
+	}
+	else {
+		state.inc_pc();
+	}
+}
+
+void JleImmInstr::emit(Bytecode& bytecode) const {
+	bytecode.emit(BytecodeInstr{ OPCODE::JLE_IMM, 0, (uint8_t)src1, 0, imm_value, get_address() }, get_line_number());
+}
+
+REGISTER JleImmInstr::get_src1() const {
+	return src1;
 }
 
+int JleImmInstr::get_imm_value() const {
+	return imm_value;
+}
 
-CallInstr::CallInstr(const std::string& subroutine_name) : subroutine_name{ subroutine_name } {
+
+CallInstr::CallInstr(const std::string& subroutine_name) : BranchInstr{ subroutine_name } {
+	builtin_id = BuiltinRegistry::instance().find(subroutine_name);
 }
 
 void CallInstr::execute(ProgramState& state) const {
-	state.call_subroutine(subroutine_name);
+	// Встроенные подпрограммы разрешаются при трансляции, подпрограммы пользователя - при компоновке
+	if (is_builtin()) {
+		state.call_builtin(builtin_id);
+	}
+	else if (is_linked()) {
+		state.call_subroutine(get_address());
+	}
+	else {
+		state.call_subroutine(get_label_name());
+	}
+}
+
+void CallInstr::emit(Bytecode& bytecode) const {
+	if (is_builtin()) {
+		bytecode.emit(BytecodeInstr{ OPCODE::CALL_BUILTIN, 0, 0, 0, builtin_id, 0 }, get_line_number());
+	}
+	else {
+		bytecode.emit(BytecodeInstr{ OPCODE::CALL, 0, 0, 0, 0, get_address() }, get_line_number());
+	}
 }
 
 std::string CallInstr::get_subroutine_name() {
-	return subroutine_name;
+	return get_label_name();
+}
+
+bool CallInstr::is_builtin() const {
+	return builtin_id >= 0;
+}
+
+int CallInstr::get_builtin_id() const {
+	return builtin_id;
 }
 
 
@@ -511,19 +1240,58 @@ void RetInstr::execute(ProgramState& state) const {
 	state.return_from_subroutine();
 }
 
+void RetInstr::emit(Bytecode& bytecode) const {
+	bytecode.emit(BytecodeInstr{ OPCODE::RET, 0, 0, 0, 0, 0 }, get_line_number());
+}
+
 
 DataInstr::DataInstr(const std::string& data_label_name, const std::vector<int> data) : data_label_name{ data_label_name }, data{ data } {
 }
 
 void DataInstr::execute(ProgramState& state) const {
-	state.allocate_memory(data_label_name, data);
+	// Размещенные заранее данные уже записаны в память
+	if (!is_data_placed()) {
+		state.allocate_memory(data_label_name, data);
+	}
 	state.inc_pc();
 }
 
+void DataInstr::emit(Bytecode& bytecode) const {
+	if (!is_data_placed()) {
+		throw RuntimeError("Данные \"" + data_label_name + "\" не размещены");
+	}
+	bytecode.emit(BytecodeInstr{ OPCODE::DATA, 0, 0, 0, 0, get_data_address() }, get_line_number());
+}
+
 std::string DataInstr::get_data_label_name() {
 	return data_label_name;
 }
 
 std::vector<int> DataInstr::get_data() {
 	return data;
+}
+
+/*!
+Устанавливает адрес первой ячейки данных
+\param[in] new_data_address Адрес первой ячейки данных
+*/
+void DataInstr::set_data_address(int new_data_address) {
+	data_address = new_data_address;
+}
+
+/*!
+Возвращает адрес первой ячейки данных
+\return Адрес первой ячейки данных или -1, если данные ещё не размещены
+*/
+int DataInstr::get_data_address() const {
+	return data_address;
+}
+
+/*!
+Возвращает флаг, были ли данные размещены заранее. Такие данные уже записаны
+в память при загрузке программы, и инструкция ничего не делает
+\return Флаг, были ли данные размещены
+*/
+bool DataInstr::is_data_placed() const {
+	return data_address >= 0;
 }
\ No newline at end of file
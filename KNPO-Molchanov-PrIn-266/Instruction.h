@@ -4,6 +4,7 @@
 #include <vector>
 
 #include "ProgramState.h"
+#include "Bytecode.h"
 
 /*!
 Базовый абстрактный класс для каждой инструкции псевдо-ассемблера
@@ -21,6 +22,12 @@ public:
 	*/
 	virtual void execute(ProgramState& state) const = 0;
 
+	/*
+	Записывает инструкцию в байт-код
+	\param[out] bytecode Байт-код
+	*/
+	virtual void emit(Bytecode& bytecode) const = 0;
+
 	/*
 	Устанавливает номер строки, на которой расположена инструкция
 	\param[in] new_line_number Номер строки
@@ -34,6 +41,76 @@ public:
 	int get_line_number() const;
 };
 
+/*!
+Базовый класс для инструкций псевдо-ассемблера, передающих управление на метку
+*/
+class BranchInstr : public Instr {
+private:
+	/// Имя метки
+	std::string label_name;
+
+	/// Индекс инструкции, на которую указывает метка. Вычисляется при компоновке
+	int address = -1;
+
+public:
+	BranchInstr(const std::string& label_name);
+
+	std::string get_label_name() const;
+
+	/*!
+	Устанавливает индекс инструкции, на которую указывает метка
+	\param[in] new_address Индекс инструкции
+	*/
+	void set_address(int new_address);
+
+	/*!
+	Возвращает индекс инструкции, на которую указывает метка
+	\return Индекс инструкции или -1, если метка ещё не разрешена
+	*/
+	int get_address() const;
+
+	/*!
+	Возвращает флаг, была ли метка разрешена при компоновке
+	\return Флаг, была ли метка разрешена
+	*/
+	bool is_linked() const;
+};
+
+/*!
+Базовый класс для инструкций псевдо-ассемблера, обращающихся к ячейке памяти по имени
+*/
+class DataAccessInstr : public Instr {
+private:
+	/// Имя ячейки памяти
+	std::string var_name;
+
+	/// Адрес ячейки памяти. Вычисляется при размещении данных
+	int data_address = -1;
+
+public:
+	DataAccessInstr(const std::string& var_name);
+
+	std::string get_var_name() const;
+
+	/*!
+	Устанавливает адрес ячейки памяти
+	\param[in] new_data_address Адрес ячейки памяти
+	*/
+	void set_data_address(int new_data_address);
+
+	/*!
+	Возвращает адрес ячейки памяти
+	\return Адрес ячейки памяти или -1, если данные ещё не размещены
+	*/
+	int get_data_address() const;
+
+	/*!
+	Возвращает флаг, был ли вычислен адрес ячейки памяти при размещении данных
+	\return Флаг, был ли вычислен адрес
+	*/
+	bool is_data_placed() const;
+};
+
 /*!
 Класс регистрового варианта инструкции "add" псевдо-ассемблера
 */
@@ -50,6 +127,8 @@ public:
 
 	void execute(ProgramState& state) const override;
 
+	void emit(Bytecode& bytecode) const override;
+
 	REGISTER get_dest() const;
 
 	REGISTER get_src() const;
@@ -71,6 +150,8 @@ public:
 
 	void execute(ProgramState& state) const override;
 
+	void emit(Bytecode& bytecode) const override;
+
 	REGISTER get_dest() const;
 
 	int get_imm_value() const;
@@ -92,6 +173,8 @@ public:
 
 	void execute(ProgramState& state) const override;
 
+	void emit(Bytecode& bytecode) const override;
+
 	REGISTER get_dest() const;
 
 	REGISTER get_src() const;
@@ -113,6 +196,8 @@ public:
 
 	void execute(ProgramState& state) const override;
 
+	void emit(Bytecode& bytecode) const override;
+
 	REGISTER get_dest() const;
 
 	int get_imm_value() const;
@@ -134,6 +219,8 @@ public:
 
 	void execute(ProgramState& state) const override;
 
+	void emit(Bytecode& bytecode) const override;
+
 	REGISTER get_dest() const;
 
 	REGISTER get_src() const;
@@ -155,6 +242,8 @@ public:
 
 	void execute(ProgramState& state) const override;
 
+	void emit(Bytecode& bytecode) const override;
+
 	REGISTER get_dest() const;
 
 	int get_imm_value() const;
@@ -176,6 +265,8 @@ public:
 
 	void execute(ProgramState& state) const override;
 
+	void emit(Bytecode& bytecode) const override;
+
 	REGISTER get_dest() const;
 
 	REGISTER get_src() const;
@@ -197,6 +288,8 @@ public:
 
 	void execute(ProgramState& state) const override;
 
+	void emit(Bytecode& bytecode) const override;
+
 	REGISTER get_dest() const;
 
 	int get_imm_value() const;
@@ -219,6 +312,8 @@ public:
 
 	void execute(ProgramState& state) const override;
 
+	void emit(Bytecode& bytecode) const override;
+
 	REGISTER get_dest() const;
 
 	REGISTER get_src() const;
@@ -240,6 +335,8 @@ public:
 
 	void execute(ProgramState& state) const override;
 
+	void emit(Bytecode& bytecode) const override;
+
 	REGISTER get_dest() const;
 
 	int get_imm_value() const;
@@ -258,6 +355,8 @@ public:
 
 	void execute(ProgramState& state) const override;
 
+	void emit(Bytecode& bytecode) const override;
+
 	REGISTER get_reg();
 };
 
@@ -277,6 +376,8 @@ public:
 
 	void execute(ProgramState& state) const override;
 
+	void emit(Bytecode& bytecode) const override;
+
 	REGISTER get_dest() const;
 
 	REGISTER get_src() const;
@@ -298,6 +399,8 @@ public:
 
 	void execute(ProgramState& state) const override;
 
+	void emit(Bytecode& bytecode) const override;
+
 	REGISTER get_dest() const;
 
 	int get_imm_value() const;
@@ -319,6 +422,8 @@ public:
 
 	void execute(ProgramState& state) const override;
 
+	void emit(Bytecode& bytecode) const override;
+
 	REGISTER get_dest() const;
 
 	REGISTER get_src() const;
@@ -340,6 +445,146 @@ public:
 
 	void execute(ProgramState& state) const override;
 
+	void emit(Bytecode& bytecode) const override;
+
+	REGISTER get_dest() const;
+
+	int get_imm_value() const;
+};
+
+/*!
+Класс регистрового варианта инструкции "mul" псевдо-ассемблера
+*/
+class MulRegInstr : public Instr {
+private:
+	/// Регистр приемник
+	REGISTER dest;
+
+	/// Регистр источник
+	REGISTER src;
+
+public:
+	MulRegInstr(REGISTER dest, REGISTER src);
+
+	void execute(ProgramState& state) const override;
+
+	void emit(Bytecode& bytecode) const override;
+
+	REGISTER get_dest() const;
+
+	REGISTER get_src() const;
+};
+
+/*!
+Класс числового варианта инструкции "mul" псевдо-ассемблера
+*/
+class MulImmInstr : public Instr {
+private:
+	/// Регистр приемник
+	REGISTER dest;
+
+	/// Непосредственный числовой аргумент
+	int imm_value;
+
+public:
+	MulImmInstr(REGISTER dest, int imm_value);
+
+	void execute(ProgramState& state) const override;
+
+	void emit(Bytecode& bytecode) const override;
+
+	REGISTER get_dest() const;
+
+	int get_imm_value() const;
+};
+
+/*!
+Класс регистрового варианта инструкции "div" псевдо-ассемблера
+*/
+class DivRegInstr : public Instr {
+private:
+	/// Регистр приемник
+	REGISTER dest;
+
+	/// Регистр источник
+	REGISTER src;
+
+public:
+	DivRegInstr(REGISTER dest, REGISTER src);
+
+	void execute(ProgramState& state) const override;
+
+	void emit(Bytecode& bytecode) const override;
+
+	REGISTER get_dest() const;
+
+	REGISTER get_src() const;
+};
+
+/*!
+Класс числового варианта инструкции "div" псевдо-ассемблера
+*/
+class DivImmInstr : public Instr {
+private:
+	/// Регистр приемник
+	REGISTER dest;
+
+	/// Непосредственный числовой аргумент
+	int imm_value;
+
+public:
+	DivImmInstr(REGISTER dest, int imm_value);
+
+	void execute(ProgramState& state) const override;
+
+	void emit(Bytecode& bytecode) const override;
+
+	REGISTER get_dest() const;
+
+	int get_imm_value() const;
+};
+
+/*!
+Класс регистрового варианта инструкции "mod" псевдо-ассемблера
+*/
+class ModRegInstr : public Instr {
+private:
+	/// Регистр приемник
+	REGISTER dest;
+
+	/// Регистр источник
+	REGISTER src;
+
+public:
+	ModRegInstr(REGISTER dest, REGISTER src);
+
+	void execute(ProgramState& state) const override;
+
+	void emit(Bytecode& bytecode) const override;
+
+	REGISTER get_dest() const;
+
+	REGISTER get_src() const;
+};
+
+/*!
+Класс числового варианта инструкции "mod" псевдо-ассемблера
+*/
+class ModImmInstr : public Instr {
+private:
+	/// Регистр приемник
+	REGISTER dest;
+
+	/// Непосредственный числовой аргумент
+	int imm_value;
+
+public:
+	ModImmInstr(REGISTER dest, int imm_value);
+
+	void execute(ProgramState& state) const override;
+
+	void emit(Bytecode& bytecode) const override;
+
 	REGISTER get_dest() const;
 
 	int get_imm_value() const;
@@ -361,6 +606,8 @@ public:
 
 	void execute(ProgramState& state) const override;
 
+	void emit(Bytecode& bytecode) const override;
+
 	REGISTER get_dest() const;
 
 	REGISTER get_src() const;
@@ -382,6 +629,8 @@ public:
 
 	void execute(ProgramState& state) const override;
 
+	void emit(Bytecode& bytecode) const override;
+
 	REGISTER get_dest() const;
 
 	int get_imm_value() const;
@@ -390,53 +639,44 @@ public:
 /*!
 Класс варианта инструкции "set" с именем ячейки памяти псевдо-ассемблера
 */
-class SetNameInstr : public Instr {
+class SetNameInstr : public DataAccessInstr {
 private:
 	/// Регистр приемник
 	REGISTER dest;
 
-	/// Имя ячейки памяти
-	std::string var_name;
-
 public:
 	SetNameInstr(REGISTER dest, const std::string& var_name);
 
 	void execute(ProgramState& state) const override;
 
-	REGISTER get_dest() const;
+	void emit(Bytecode& bytecode) const override;
 
-	std::string get_var_name() const;
+	REGISTER get_dest() const;
 };
 
 /*!
 Класс инструкции "ld" псевдо-ассемблера
 */
-class LdInstr : public Instr {
+class LdInstr : public DataAccessInstr {
 private:
 	/// Регистр приемник
 	REGISTER dest;
 
-	/// Имя ячейки памяти
-	std::string var_name;
-
 public:
 	LdInstr(REGISTER dest, const std::string& var_name);
 
 	void execute(ProgramState& state) const override;
 
-	REGISTER get_dest() const;
+	void emit(Bytecode& bytecode) const override;
 
-	std::string get_var_name() const;
+	REGISTER get_dest() const;
 };
 
 /*!
 Класс инструкции "st" псевдо-ассемблера
 */
-class StInstr : public Instr {
+class StInstr : public DataAccessInstr {
 private:
-	/// Имя ячейки памяти
-	std::string var_name;
-
 	/// Регистр источник
 	REGISTER src;
 
@@ -445,9 +685,9 @@ public:
 
 	void execute(ProgramState& state) const override;
 
-	REGISTER get_src() const;
+	void emit(Bytecode& bytecode) const override;
 
-	std::string get_var_name() const;
+	REGISTER get_src() const;
 };
 
 /*!
@@ -466,6 +706,8 @@ public:
 
 	void execute(ProgramState& state) const override;
 
+	void emit(Bytecode& bytecode) const override;
+
 	REGISTER get_dest() const;
 
 	REGISTER get_src() const;
@@ -487,35 +729,178 @@ public:
 
 	void execute(ProgramState& state) const override;
 
+	void emit(Bytecode& bytecode) const override;
+
 	REGISTER get_dest() const;
 
 	REGISTER get_src() const;
 };
 
 /*!
-Класс инструкции "jmp" псевдо-ассемблера
+Класс варианта инструкции "ldi" псевдо-ассемблера со смещением адреса на число
 */
-class JmpInstr : public Instr {
+class LdiOffsetInstr : public Instr {
 private:
-	/// Имя метки
-	std::string label_name;
+	/// Регистр приемник
+	REGISTER dest;
+
+	/// Регистр, содержащий базовый адрес
+	REGISTER src;
+
+	/// Смещение относительно базового адреса
+	int offset;
 
 public:
-	JmpInstr(const std::string& label_name);
+	LdiOffsetInstr(REGISTER dest, REGISTER src, int offset);
 
 	void execute(ProgramState& state) const override;
 
-	std::string get_label_name();
+	void emit(Bytecode& bytecode) const override;
+
+	REGISTER get_dest() const;
+
+	REGISTER get_src() const;
+
+	int get_offset() const;
 };
 
 /*!
-Класс инструкции "jeq" псевдо-ассемблера
+Класс варианта инструкции "ldi" псевдо-ассемблера со смещением адреса на значение регистра
 */
-class JeqInstr : public Instr {
+class LdiIndexInstr : public Instr {
 private:
-	/// Имя метки
-	std::string label_name;
+	/// Регистр приемник
+	REGISTER dest;
+
+	/// Регистр, содержащий базовый адрес
+	REGISTER src;
+
+	/// Регистр, содержащий смещение относительно базового адреса
+	REGISTER index;
+
+public:
+	LdiIndexInstr(REGISTER dest, REGISTER src, REGISTER index);
+
+	void execute(ProgramState& state) const override;
+
+	void emit(Bytecode& bytecode) const override;
+
+	REGISTER get_dest() const;
+
+	REGISTER get_src() const;
+
+	REGISTER get_index() const;
+};
+
+/*!
+Класс варианта инструкции "sti" псевдо-ассемблера со смещением адреса на число
+*/
+class StiOffsetInstr : public Instr {
+private:
+	/// Регистр, содержащий базовый адрес
+	REGISTER dest;
+
+	/// Смещение относительно базового адреса
+	int offset;
+
+	/// Регистр источник
+	REGISTER src;
+
+public:
+	StiOffsetInstr(REGISTER dest, int offset, REGISTER src);
 
+	void execute(ProgramState& state) const override;
+
+	void emit(Bytecode& bytecode) const override;
+
+	REGISTER get_dest() const;
+
+	int get_offset() const;
+
+	REGISTER get_src() const;
+};
+
+/*!
+Класс варианта инструкции "sti" псевдо-ассемблера со смещением адреса на значение регистра
+*/
+class StiIndexInstr : public Instr {
+private:
+	/// Регистр, содержащий базовый адрес
+	REGISTER dest;
+
+	/// Регистр, содержащий смещение относительно базового адреса
+	REGISTER index;
+
+	/// Регистр источник
+	REGISTER src;
+
+public:
+	StiIndexInstr(REGISTER dest, REGISTER index, REGISTER src);
+
+	void execute(ProgramState& state) const override;
+
+	void emit(Bytecode& bytecode) const override;
+
+	REGISTER get_dest() const;
+
+	REGISTER get_index() const;
+
+	REGISTER get_src() const;
+};
+
+/*!
+Класс инструкции "push" псевдо-ассемблера
+*/
+class PushInstr : public Instr {
+private:
+	/// Регистр источник
+	REGISTER src;
+
+public:
+	PushInstr(REGISTER src);
+
+	void execute(ProgramState& state) const override;
+
+	void emit(Bytecode& bytecode) const override;
+
+	REGISTER get_src() const;
+};
+
+/*!
+Класс инструкции "pop" псевдо-ассемблера
+*/
+class PopInstr : public Instr {
+private:
+	/// Регистр приемник
+	REGISTER dest;
+
+public:
+	PopInstr(REGISTER dest);
+
+	void execute(ProgramState& state) const override;
+
+	void emit(Bytecode& bytecode) const override;
+
+	REGISTER get_dest() const;
+};
+
+/*!
+Класс инструкции "jmp" псевдо-ассемблера
+*/
+class JmpInstr : public BranchInstr {
+public:
+	JmpInstr(const std::string& label_name);
+
+	void execute(ProgramState& state) const override;
+
+	void emit(Bytecode& bytecode) const override;
+};
+
+/*!
+Класс регистрового варианта инструкции "jeq" псевдо-ассемблера
+*/
+class JeqInstr : public BranchInstr {
+private:
 	/// Регистр источник первого операнда
 	REGISTER src1;
 
@@ -527,22 +912,87 @@ public:
 
 	void execute(ProgramState& state) const override;
 
+	void emit(Bytecode& bytecode) const override;
+
 	REGISTER get_src1() const;
 
 	REGISTER get_src2() const;
+};
+
+/*!
+Класс числового варианта инструкции "jeq" псевдо-ассемблера
+*/
+class JeqImmInstr : public BranchInstr {
+private:
+	/// Регистр источник первого операнда
+	REGISTER src1;
+
+	/// Непосредственный числовой аргумент, с которым сравнивается первый операнд
+	int imm_value;
+
+public:
+	JeqImmInstr(const std::string& label_name, REGISTER src1, int imm_value);
 
-	std::string get_label_name();
+	void execute(ProgramState& state) const override;
+
+	void emit(Bytecode& bytecode) const override;
+
+	REGISTER get_src1() const;
+
+	int get_imm_value() const;
 };
 
+/*!
+Класс регистрового варианта инструкции "jne" псевдо-ассемблера
+*/
+class JneInstr : public BranchInstr {
+private:
+	/// Регистр источник первого операнда
+	REGISTER src1;
+
+	/// Регистр источник второго операнда
+	REGISTER src2;
+
+public:
+	JneInstr(const std::string& label_name, REGISTER src1, REGISTER src2);
+
+	void execute(ProgramState& state) const override;
+
+	void emit(Bytecode& bytecode) const override;
+
+	REGISTER get_src1() const;
+
+	REGISTER get_src2() const;
+};
 
 /*!
-Класс инструкции "jgt" псевдо-ассемблера
+Класс числового варианта инструкции "jne" псевдо-ассемблера
 */
-class JgtInstr : public Instr {
+class JneImmInstr : public BranchInstr {
 private:
-	/// Имя метки
-	std::string label_name;
+	/// Регистр источник первого операнда
+	REGISTER src1;
+
+	/// Непосредственный числовой аргумент, с которым сравнивается первый операнд
+	int imm_value;
+
+public:
+	JneImmInstr(const std::string& label_name, REGISTER src1, int imm_value);
+
+	void execute(ProgramState& state) const override;
+
+	void emit(Bytecode& bytecode) const override;
+
+	REGISTER get_src1() const;
+
+	int get_imm_value() const;
+};
 
+/*!
+Класс регистрового варианта инструкции "jgt" псевдо-ассемблера
+*/
+class JgtInstr : public BranchInstr {
+private:
 	/// Регистр источник первого операнда
 	REGISTER src1;
 
@@ -554,27 +1004,206 @@ public:
 
 	void execute(ProgramState& state) const override;
 
+	void emit(Bytecode& bytecode) const override;
+
+	REGISTER get_src1() const;
+
+	REGISTER get_src2() const;
+};
+
+/*!
+Класс числового варианта инструкции "jgt" псевдо-ассемблера
+*/
+class JgtImmInstr : public BranchInstr {
+private:
+	/// Регистр источник первого операнда
+	REGISTER src1;
+
+	/// Непосредственный числовой аргумент, с которым сравнивается первый операнд
+	int imm_value;
+
+public:
+	JgtImmInstr(const std::string& label_name, REGISTER src1, int imm_value);
+
+	void execute(ProgramState& state) const override;
+
+	void emit(Bytecode& bytecode) const override;
+
+	REGISTER get_src1() const;
+
+	int get_imm_value() const;
+};
+
+/*!
+Класс регистрового варианта инструкции "jlt" псевдо-ассемблера
+*/
+class JltInstr : public BranchInstr {
+private:
+	/// Регистр источник первого операнда
+	REGISTER src1;
+
+	/// Регистр источник второго операнда
+	REGISTER src2;
+
+public:
+	JltInstr(const std::string& label_name, REGISTER src1, REGISTER src2);
+
+	void execute(ProgramState& state) const override;
+
+	void emit(Bytecode& bytecode) const override;
+
 	REGISTER get_src1() const;
 
 	REGISTER get_src2() const;
+};
+
+/*!
+Класс числового варианта инструкции "jlt" псевдо-ассемблера
+*/
+class JltImmInstr : public BranchInstr {
+private:
+	/// Регистр источник первого операнда
+	REGISTER src1;
+
+	/// Непосредственный числовой аргумент, с которым сравнивается первый операнд
+	int imm_value;
+
+public:
+	JltImmInstr(const std::string& label_name, REGISTER src1, int imm_value);
+
+	void execute(ProgramState& state) const override;
 
-	std::string get_label_name();
+	void emit(Bytecode& bytecode) const override;
+
+	REGISTER get_src1() const;
+
+	int get_imm_value() const;
+};
+
+/*!
+Класс регистрового варианта инструкции "jge" псевдо-ассемблера
+*/
+class JgeInstr : public BranchInstr {
+private:
+	/// Регистр источник первого операнда
+	REGISTER src1;
+
+	/// Регистр источник второго операнда
+	REGISTER src2;
+
+public:
+	JgeInstr(const std::string& label_name, REGISTER src1, REGISTER src2);
+
+	void execute(ProgramState& state) const override;
+
+	void emit(Bytecode& bytecode) const override;
+
+	REGISTER get_src1() const;
+
+	REGISTER get_src2() const;
+};
+
+/*!
+Класс числового варианта инструкции "jge" псевдо-ассемблера
+*/
+class JgeImmInstr : public BranchInstr {
+private:
+	/// Регистр источник первого операнда
+	REGISTER src1;
+
+	/// Непосредственный числовой аргумент, с которым сравнивается первый операнд
+	int imm_value;
+
+public:
+	JgeImmInstr(const std::string& label_name, REGISTER src1, int imm_value);
+
+	void execute(ProgramState& state) const override;
+
+	void emit(Bytecode& bytecode) const override;
+
+	REGISTER get_src1() const;
+
+	int get_imm_value() const;
+};
+
+/*!
+Класс регистрового варианта инструкции "jle" псевдо-ассемблера
+*/
+class JleInstr : public BranchInstr {
+private:
+	/// Регистр источник первого операнда
+	REGISTER src1;
+
+	/// Регистр источник второго операнда
+	REGISTER src2;
+
+public:
+	JleInstr(const std::string& label_name, REGISTER src1, REGISTER src2);
+
+	void execute(ProgramState& state) const override;
+
+	void emit(Bytecode& bytecode) const override;
+
+	REGISTER get_src1() const;
+
+	REGISTER get_src2() const;
+};
+
+/*!
+Класс числового варианта инструкции "jle" псевдо-ассемблера
+*/
+class JleImmInstr : public BranchInstr {
+private:
+	/// Регистр источник первого операнда
+	REGISTER src1;
+
+	/// Непосредственный числовой аргумент, с которым сравнивается первый операнд
+	int imm_value;
+
+public:
+	JleImmInstr(const std::string& label_name, REGISTER src1, int imm_value);
+
+	void execute(ProgramState& state) const override;
+
+	void emit(Bytecode& bytecode) const override;
+
+	REGISTER get_src1() const;
+
+	int get_imm_value() const;
 };
 
 /*!
 Класс инструкции "call" псевдо-ассемблера
 */
-class CallInstr : public Instr {
+class CallInstr : public BranchInstr {
 private:
-	/// Имя подпрограммы
-	std::string subroutine_name;
+	/// Идентификатор встроенной подпрограммы или -1, если вызывается подпрограмма пользователя
+	int builtin_id = -1;
 
 public:
+	/*!
+	Конструктор инструкции. Имя встроенной подпрограммы сразу разрешается в её идентификатор
+	\param[in] subroutine_name Имя подпрограммы
+	*/
 	CallInstr(const std::string& subroutine_name);
 
 	void execute(ProgramState& state) const override;
 
+	void emit(Bytecode& bytecode) const override;
+
 	std::string get_subroutine_name();
+
+	/*!
+	Возвращает флаг, вызывается ли встроенная подпрограмма
+	\return Флаг, вызывается ли встроенная подпрограмма
+	*/
+	bool is_builtin() const;
+
+	/*!
+	Возвращает идентификатор встроенной подпрограммы
+	\return Идентификатор подпрограммы или -1, если вызывается подпрограмма пользователя
+	*/
+	int get_builtin_id() const;
 };
 
 /*!
@@ -585,6 +1214,8 @@ public:
 	RetInstr();
 
 	void execute(ProgramState& state) const override;
+
+	void emit(Bytecode& bytecode) const override;
 };
 
 /*!
@@ -595,12 +1226,36 @@ private:
 	std::string data_label_name;
 	std::vector<int> data;
 
+	/// Адрес первой ячейки данных. Вычисляется при размещении данных
+	int data_address = -1;
+
 public:
 	DataInstr(const std::string& data_label_name, const std::vector<int> data);
 
 	void execute(ProgramState& state) const override;
 
+	void emit(Bytecode& bytecode) const override;
+
 	std::string get_data_label_name();
 
 	std::vector<int> get_data();
+
+	/*!
+	Устанавливает адрес первой ячейки данных
+	\param[in] new_data_address Адрес первой ячейки данных
+	*/
+	void set_data_address(int new_data_address);
+
+	/*!
+	Возвращает адрес первой ячейки данных
+	\return Адрес первой ячейки данных или -1, если данные ещё не размещены
+	*/
+	int get_data_address() const;
+
+	/*!
+	Возвращает флаг, были ли данные размещены заранее. Такие данные уже записаны
+	в память при загрузке программы, и инструкция ничего не делает
+	\return Флаг, были ли данные размещены
+	*/
+	bool is_data_placed() const;
 };
\ No newline at end of file
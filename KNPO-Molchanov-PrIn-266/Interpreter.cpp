@@ -1,22 +1,47 @@
 #include <fstream>
+#include <filesystem>
 #include <map>
 #include <vector>
+#include <utility>
 
 #include "Interpreter.h"
 #include "MnemonicTranslator.h"
 #include "Tokenizer.h"
+#include "Bytecode.h"
+#include "BytecodeEngine.h"
+#include "Fusion.h"
+#include "SourceFile.h"
+#include "Profiler.h"
+#include "BatchRunner.h"
+#include "IoPort.h"
+#include "ProgramImage.h"
+#include "TranslationCache.h"
+
+/*!
+Конструктор интерпретатора
+\param[in] options Параметры интерпретатора
+*/
+Interpreter::Interpreter(const InterpreterOptions& options) : options{ options } {
+}
 
 /*!
 Выполняет интерпретацию инструкций на языке псевдо-ассемблера
-\param[in] input_file Входной файл
+\param[in] input_file Входной поток
 */
-void Interpreter::interpret(std::ifstream& input_file) {
-	// Считанные инструкции
-	std::vector<std::shared_ptr<Instr>> instrs;
+void Interpreter::interpret(std::istream& input_file) {
+	SourceFile source;
+	source.read(input_file);
 
-	// Карта меток
-	std::map<std::string, int> labels;
+	interpret(source.get_text());
+}
 
+/*!
+Транслирует программу и размещает её данные. Ошибки трансляции выводятся в стандартный поток вывода
+\param[in] source Текст программы
+\param[out] program Оттранслированная программа
+\return Флаг, удалось ли оттранслировать программу
+*/
+bool Interpreter::translate(std::string_view source, TranslatedProgram& program) const {
 	// Ошибки, возникшие в процессе токенизации
 	std::vector<TokenizerError> tokenizer_errors;
 
@@ -25,34 +50,250 @@ void Interpreter::interpret(std::ifstream& input_file) {
 
 	// Переводим мнемоники во внутрнее представление
 	MnemonicTranslator mnemonic_translator;
-	if (!mnemonic_translator.translate(input_file, instrs, labels, tokenizer_errors, syntax_errors)) {
+	bool translated = mnemonic_translator.translate(source, program.instrs, program.labels, tokenizer_errors, syntax_errors, options.translation_threads);
+
+	// Разрешаем метки в индексы инструкций, чтобы не искать их по имени во время выполнения
+	if (translated) {
+		translated = mnemonic_translator.link(program.instrs, program.labels, syntax_errors);
+	}
+
+	// Размещаем данные по фиксированным адресам, чтобы обращаться к ним без поиска по имени
+	if (translated) {
+		translated = mnemonic_translator.layout_data(program.instrs, program.data_addresses, program.memory_image, syntax_errors, options.memory_size);
+	}
+
+	if (!translated) {
 		for (const auto& err : tokenizer_errors) {
 			std::cout << err.what() << std::endl;
 		}
 		for (const auto& err : syntax_errors) {
 			std::cout << err.what() << std::endl;
 		}
+	}
 
-		return;
+	return translated;
+}
+
+/*!
+Записывает инструкции программы в байт-код и объединяет частые последовательности в суперинструкции
+\param[in|out] program Оттранслированная программа
+*/
+void Interpreter::emit(TranslatedProgram& program) const {
+	MnemonicTranslator mnemonic_translator;
+	mnemonic_translator.emit(program.instrs, program.bytecode);
+
+	if (options.fuse) {
+		std::vector<Fusion> fusions;
+		FusionPass fusion_pass;
+		fusion_pass.apply(program.bytecode, fusions);
+
+		if (options.dump_fusions) {
+			for (const auto& fusion : fusions) {
+				std::cerr << "Строка " << fusion.line_number << ": " << fusion.description << std::endl;
+			}
+		}
+	}
+}
+
+/*!
+Загружает программу из текста или из двоичного образа. Ошибки выводятся в стандартный поток вывода
+\param[in] source Текст программы или образ программы
+\param[out] program Программа. Байт-код записывается, если он нужен для выполнения
+\return Флаг, удалось ли загрузить программу
+*/
+bool Interpreter::load(std::string_view source, TranslatedProgram& program) const {
+	if (!ProgramImage::is_image(source)) {
+		// Кэш хранит образы, поэтому используется только при выполнении байт-кодом
+		bool use_cache = !options.cache_directory.empty() && options.engine != ENGINE::INSTR && !options.profile;
+		TranslationCache cache(options.cache_directory);
+
+		if (use_cache && cache.load(source, options, program)) {
+			return true;
+		}
+
+		if (!translate(source, program)) {
+			return false;
+		}
+		if (options.engine != ENGINE::INSTR && !options.profile) {
+			emit(program);
+		}
+		if (use_cache) {
+			cache.store(source, options, program);
+		}
+		return true;
+	}
+
+	// Образ содержит только байт-код
+	if (options.engine == ENGINE::INSTR || options.profile) {
+		std::cout << "Ошибка: образ программы выполняется только байт-кодом, без --engine=instr и --profile" << std::endl;
+		return false;
 	}
 
 	try {
-		ProgramState state(instrs.size());
+		ProgramImage::read(source, program);
+	}
+	catch (ImageError& err) {
+		std::cout << err.what() << std::endl;
+		return false;
+	}
 
-		for (const auto& l : labels) {
-			state.add_label(l.first, l.second);
+	return true;
+}
+
+/*!
+Выполняет интерпретацию инструкций на языке псевдо-ассемблера
+\param[in] source Текст программы или её двоичный образ
+*/
+void Interpreter::interpret(std::string_view source) {
+	TranslatedProgram translated;
+	if (!load(source, translated)) {
+		return;
+	}
+
+	const Program program(std::move(translated));
+	const std::vector<std::shared_ptr<Instr>>& instrs = program.get_instrs();
+
+	// Порт объявлен до состояния программы, так как буфер вывода состояния ссылается на него до конца
+	FdPort fd_port;
+
+	try {
+		ProgramState state(program, options.memory_size, options.memory_mode, options.stack_size);
+		if (options.io_port == IO_PORT::FD) {
+			state.set_io_port(fd_port);
 		}
+		state.get_output().set_buffering(options.output_buffering, options.output_buffer_size);
+
+		if (options.profile) {
+			Profiler profiler(instrs);
+
+			try {
+				profiler.execute(instrs, state);
+			}
+			catch (RuntimeError& err) {
+				state.get_output().flush();
+				std::cout << "Строка " + std::to_string(program.get_line_number(state.get_pc())) + ": " + err.what() << std::endl;
+			}
+
+			// Отчет выводится после всего, что напечатала программа
+			state.get_output().flush();
+			profiler.write_report(std::cerr, source);
 
-		try {
-			while (state.is_running()) {
-				instrs.at(state.get_pc())->execute(state);
+			if (!options.profile_json.empty()) {
+				std::ofstream json_file(options.profile_json);
+				if (!json_file) {
+					std::cerr << "Ошибка: файл \"" << options.profile_json << "\" не может быть открыт" << std::endl;
+				}
+				else {
+					profiler.write_json(json_file);
+				}
+			}
+			if (!options.profile_csv.empty()) {
+				std::ofstream csv_file(options.profile_csv);
+				if (!csv_file) {
+					std::cerr << "Ошибка: файл \"" << options.profile_csv << "\" не может быть открыт" << std::endl;
+				}
+				else {
+					profiler.write_csv(csv_file);
+				}
 			}
 		}
-		catch (RuntimeError& err) {
-			std::cout << "Строка " + std::to_string(instrs.at(state.get_pc())->get_line_number()) + ": " + err.what() << std::endl;
+		else if (options.engine == ENGINE::INSTR) {
+			try {
+				while (state.is_running()) {
+					instrs.at(state.get_pc())->execute(state);
+				}
+			}
+			catch (RuntimeError& err) {
+				// Сообщение об ошибке должно следовать за уже напечатанным программой
+				state.get_output().flush();
+				std::cout << "Строка " + std::to_string(program.get_line_number(state.get_pc())) + ": " + err.what() << std::endl;
+			}
+		}
+		else {
+			try {
+				BytecodeEngine bytecode_engine(options.engine == ENGINE::SWITCH ? DISPATCH::SWITCH : DISPATCH::THREADED);
+				bytecode_engine.execute(program, state);
+			}
+			catch (RuntimeError& err) {
+				state.get_output().flush();
+				std::cout << "Строка " + std::to_string(program.get_line_number(state.get_pc())) + ": " + err.what() << std::endl;
+			}
 		}
 	}
 	catch (RuntimeError& err) {
 		std::cout << err.what() << std::endl;
 	}
-}
\ No newline at end of file
+}
+
+/*!
+Транслирует программу один раз и выполняет её для каждого входного файла в нескольких потоках.
+Вывод каждого запуска записывается в отдельный файл в каталоге output_directory или,
+если каталог не указан, выводится в стандартный поток вывода после завершения всех запусков.
+Имя файла вывода составляется из имени входного файла и номера запуска, поэтому входные файлы
+с одинаковыми именами из разных каталогов не перезаписывают вывод друг друга
+\param[in] source Текст программы или её двоичный образ
+\param[in] input_files Входные файлы, по одному на запуск
+\param[in] output_directory Каталог для файлов вывода или пустая строка
+\param[in] thread_count Количество потоков
+\return Флаг, удалось ли загрузить программу и выполнить все запуски
+*/
+bool Interpreter::interpret_batch(std::string_view source, const std::vector<std::string>& input_files, const std::string& output_directory, int thread_count) {
+	TranslatedProgram translated;
+	if (!load(source, translated)) {
+		return false;
+	}
+
+	const Program program(std::move(translated));
+
+	if (!output_directory.empty()) {
+		std::error_code error;
+		std::filesystem::create_directories(output_directory, error);
+		if (error) {
+			std::cerr << "Ошибка: каталог \"" << output_directory << "\" не может быть создан" << std::endl;
+			return false;
+		}
+	}
+
+	std::vector<BatchRun> runs(input_files.size());
+	for (int i = 0; i < input_files.size(); i++) {
+		runs[i].input_file = input_files[i];
+		if (!output_directory.empty()) {
+			std::string output_name = std::filesystem::path(input_files[i]).filename().string() + "." + std::to_string(i + 1) + ".out";
+			runs[i].output_file = (std::filesystem::path(output_directory) / output_name).string();
+		}
+	}
+
+	BatchRunner batch_runner(program, options);
+	batch_runner.run(runs, thread_count);
+
+	// Без каталога для файлов вывода результаты выводятся в порядке входных файлов
+	if (output_directory.empty()) {
+		for (const auto& run : runs) {
+			std::cout << "== " << run.input_file << std::endl << run.output;
+		}
+	}
+
+	for (const auto& run : runs) {
+		if (run.failed) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/*!
+Транслирует программу и записывает её двоичный образ. Ошибки трансляции выводятся в стандартный поток вывода
+\param[in] source Текст программы
+\param[out] output Поток для образа программы
+\return Флаг, удалось ли оттранслировать программу
+*/
+bool Interpreter::assemble(std::string_view source, std::ostream& output) const {
+	TranslatedProgram program;
+	if (!translate(source, program)) {
+		return false;
+	}
+
+	emit(program);
+	ProgramImage::write(program, output);
+	return true;
+}
@@ -1,17 +1,135 @@
 #pragma once
 
+#include <cstdint>
 #include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <map>
+#include <memory>
 
 #include "Instruction.h"
+#include "OutputBuffer.h"
+#include "Program.h"
+
+/// Версия интерпретатора. Увеличивается при изменении результата трансляции, чтобы не использовать устаревший кэш
+const uint32_t INTERPRETER_VERSION = 1;
+
+/// Способы выполнения инструкций
+enum class ENGINE {
+	INSTR, ///< Последовательный вызов Instr::execute, эталонный вариант для отладки
+	SWITCH, ///< Выполнение байт-кода с диспетчеризацией через switch
+	THREADED, ///< Выполнение байт-кода в виде прямого шитого кода
+};
+
+/// Порты ввода-вывода встроенных подпрограмм при интерпретации одной программы
+enum class IO_PORT {
+	STREAM, ///< Стандартные потоки std::cin и std::cout
+	FD, ///< Дескрипторы стандартного ввода и вывода, читаемые и записываемые большими блоками
+};
+
+/*!
+Параметры интерпретатора
+*/
+struct InterpreterOptions {
+	/// Способ выполнения инструкций
+	ENGINE engine = ENGINE::THREADED;
+	/// Объединять ли частые последовательности инструкций байт-кода в суперинструкции
+	bool fuse = true;
+	/// Выводить ли в поток ошибок список примененных объединений
+	bool dump_fusions = false;
+	/// Режим буферизации вывода программы
+	BUFFERING output_buffering = BUFFERING::FULL;
+	/// Размер буфера вывода в режиме BUFFERING::FULL
+	int output_buffer_size = DEFAULT_OUTPUT_BUFFER_SIZE;
+	/// Профилировать ли программу. Программа выполняется через Instr::execute, а отчет выводится в поток ошибок
+	bool profile = false;
+	/// Файл для счетчиков профилировщика в формате JSON или пустая строка
+	std::string profile_json;
+	/// Файл для счетчиков профилировщика в формате CSV или пустая строка
+	std::string profile_csv;
+	/// Количество ячеек памяти программы
+	int memory_size = DEFAULT_MEMORY_SIZE;
+	/// Способ выделения памяти программы
+	MEMORY_MODE memory_mode = MEMORY_MODE::FIXED;
+	/// Размер сегмента стека данных программы в ячейках
+	int stack_size = DEFAULT_STACK_SIZE;
+	/// Порт ввода-вывода встроенных подпрограмм
+	IO_PORT io_port = IO_PORT::STREAM;
+	/// Количество потоков трансляции большой программы
+	int translation_threads = 1;
+	/// Каталог кэша оттранслированных программ или пустая строка, если кэш не используется
+	std::string cache_directory;
+};
 
 /*!
 Интерпретатор псевдо-ассемблера
 */
 class Interpreter {
+private:
+	/// Параметры интерпретатора
+	InterpreterOptions options;
+
+	/*!
+	Транслирует программу и размещает её данные. Ошибки трансляции выводятся в стандартный поток вывода
+	\param[in] source Текст программы
+	\param[out] program Оттранслированная программа
+	\return Флаг, удалось ли оттранслировать программу
+	*/
+	bool translate(std::string_view source, TranslatedProgram& program) const;
+
+	/*!
+	Загружает программу из текста или из двоичного образа. Ошибки выводятся в стандартный поток вывода
+	\param[in] source Текст программы или образ программы
+	\param[out] program Программа. Байт-код записывается, если он нужен для выполнения
+	\return Флаг, удалось ли загрузить программу
+	*/
+	bool load(std::string_view source, TranslatedProgram& program) const;
+
+	/*!
+	Записывает инструкции программы в байт-код и объединяет частые последовательности в суперинструкции
+	\param[in|out] program Оттранслированная программа
+	*/
+	void emit(TranslatedProgram& program) const;
+
 public:
+	/*!
+	Конструктор интерпретатора
+	\param[in] options Параметры интерпретатора
+	*/
+	Interpreter(const InterpreterOptions& options = InterpreterOptions());
+
+	/*!
+	Выполняет интерпретацию инструкций на языке псевдо-ассемблера
+	\param[in] input_file Входной поток
+	*/
+	void interpret(std::istream& input_file);
+
 	/*!
 	Выполняет интерпретацию инструкций на языке псевдо-ассемблера
-	\param[in] input_file Входной файл
+	\param[in] source Текст программы или её двоичный образ
+	*/
+	void interpret(std::string_view source);
+
+	/*!
+	Транслирует программу и записывает её двоичный образ. Ошибки трансляции выводятся в стандартный поток вывода
+	\param[in] source Текст программы
+	\param[out] output Поток для образа программы
+	\return Флаг, удалось ли оттранслировать программу
+	*/
+	bool assemble(std::string_view source, std::ostream& output) const;
+
+	/*!
+	Транслирует программу один раз и выполняет её для каждого входного файла в нескольких потоках.
+	Вывод каждого запуска записывается в отдельный файл в каталоге output_directory или,
+	если каталог не указан, выводится в стандартный поток вывода после завершения всех запусков.
+	Имя файла вывода составляется из имени входного файла и номера запуска, поэтому входные файлы
+	с одинаковыми именами из разных каталогов не перезаписывают вывод друг друга
+	\param[in] source Текст программы или её двоичный образ
+	\param[in] input_files Входные файлы, по одному на запуск
+	\param[in] output_directory Каталог для файлов вывода или пустая строка
+	\param[in] thread_count Количество потоков
+	\return Флаг, удалось ли загрузить программу и выполнить все запуски
 	*/
-	void interpret(std::ifstream& input_file);
+	bool interpret_batch(std::string_view source, const std::vector<std::string>& input_files, const std::string& output_directory, int thread_count);
 };
\ No newline at end of file
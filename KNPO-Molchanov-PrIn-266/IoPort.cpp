@@ -0,0 +1,238 @@
+#include <cstddef>
+#include <climits>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cerrno>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "IoPort.h"
+
+
+/*!
+Конструктор порта
+\param[in] input Входной поток
+\param[in] output Выходной поток
+*/
+StreamPort::StreamPort(std::istream& input, std::ostream& output)
+	: input{ &input }, output{ &output } {
+}
+
+/*!
+Отключает синхронизацию стандартных потоков с stdio и связь std::cin с std::cout.
+Вывод перед чтением ввода сбрасывает OutputBuffer, поэтому связь потоков не нужна.
+Вызывается до первой операции ввода-вывода
+*/
+void StreamPort::disable_stdio_sync() {
+	std::ios::sync_with_stdio(false);
+	std::cin.tie(nullptr);
+}
+
+bool StreamPort::read_char(char& ch) {
+	ch = '\0';
+	return (bool)(*input >> ch);
+}
+
+bool StreamPort::read_int(int& value) {
+	value = 0;
+	return (bool)(*input >> value);
+}
+
+bool StreamPort::read_line(std::string& line) {
+	return (bool)std::getline(*input, line);
+}
+
+void StreamPort::write(const char* data, size_t size) {
+	output->write(data, size);
+}
+
+void StreamPort::flush() {
+	output->flush();
+}
+
+/*!
+Проверяет, является ли символ пробельным с точки зрения оператора >> потока
+\param[in] ch Символ
+\return Флаг, является ли символ пробельным
+*/
+static bool is_space(char ch) {
+	return ch == ' ' || ch == '\t' || ch == '\n' || ch == '\r' || ch == '\v' || ch == '\f';
+}
+
+/*!
+Пропускает пробельные символы
+\return Флаг, остались ли во вводе другие символы
+*/
+bool BufferedPort::skip_whitespace() {
+	while (has_input()) {
+		size_t start = 0;
+		while (start < input_data.size() && is_space(input_data[start])) {
+			start++;
+		}
+		input_data.remove_prefix(start);
+
+		if (!input_data.empty()) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool BufferedPort::read_char(char& ch) {
+	ch = '\0';
+	if (!skip_whitespace()) {
+		return false;
+	}
+
+	ch = input_data[0];
+	input_data.remove_prefix(1);
+	return true;
+}
+
+bool BufferedPort::read_int(int& value) {
+	value = 0;
+	if (!skip_whitespace()) {
+		return false;
+	}
+
+	bool negative = false;
+	if (input_data[0] == '-' || input_data[0] == '+') {
+		negative = input_data[0] == '-';
+		input_data.remove_prefix(1);
+	}
+
+	// Как и оператор >> потока, при переполнении возвращается ближайшее допустимое значение
+	long long number = 0;
+	bool has_digits = false;
+	while (has_input() && input_data[0] >= '0' && input_data[0] <= '9') {
+		if (number <= INT_MAX) {
+			number = number * 10 + (input_data[0] - '0');
+		}
+		has_digits = true;
+		input_data.remove_prefix(1);
+	}
+
+	if (!has_digits) {
+		return false;
+	}
+
+	if (negative) {
+		value = -number < INT_MIN ? INT_MIN : (int)-number;
+	}
+	else {
+		value = number > INT_MAX ? INT_MAX : (int)number;
+	}
+	return true;
+}
+
+bool BufferedPort::read_line(std::string& line) {
+	line.clear();
+	if (!has_input()) {
+		return false;
+	}
+
+	while (has_input()) {
+		size_t end = input_data.find('\n');
+		if (end != std::string_view::npos) {
+			line.append(input_data.data(), end);
+			input_data.remove_prefix(end + 1);
+			return true;
+		}
+
+		line.append(input_data.data(), input_data.size());
+		input_data = std::string_view();
+	}
+
+	return true;
+}
+
+/*!
+Конструктор порта
+\param[in] input Ввод
+*/
+StringPort::StringPort(std::string_view input) : input(input) {
+	input_data = this->input;
+}
+
+/*!
+Заменяет ещё не прочитанный ввод
+\param[in] new_input Ввод
+*/
+void StringPort::set_input(std::string_view new_input) {
+	input = new_input;
+	input_data = input;
+}
+
+bool StringPort::refill() {
+	return false;
+}
+
+void StringPort::write(const char* data, size_t size) {
+	output.append(data, size);
+}
+
+void StringPort::flush() {
+}
+
+/*!
+Конструктор порта
+\param[in] input_fd Дескриптор ввода
+\param[in] output_fd Дескриптор вывода
+*/
+FdPort::FdPort(int input_fd, int output_fd)
+	: input_fd{ input_fd }, output_fd{ output_fd }, read_buffer(FD_PORT_READ_SIZE) {
+}
+
+bool FdPort::refill() {
+#ifdef _WIN32
+	int count = _read(input_fd, read_buffer.data(), (unsigned int)read_buffer.size());
+#else
+	ssize_t count;
+	do {
+		count = read(input_fd, read_buffer.data(), read_buffer.size());
+	} while (count < 0 && errno == EINTR);
+#endif
+	if (count < 0 && !read_failed) {
+		// Остаток ввода недоступен, поэтому ошибка, как и конец ввода, завершает чтение
+		std::cerr << "Ошибка: ввод программы не может быть прочитан" << std::endl;
+		read_failed = true;
+	}
+	if (count <= 0) {
+		return false;
+	}
+
+	input_data = std::string_view(read_buffer.data(), count);
+	return true;
+}
+
+void FdPort::write(const char* data, size_t size) {
+	// После ошибки вывод отбрасывается, чтобы не сообщать о ней при каждой записи
+	while (size > 0 && !write_failed) {
+#ifdef _WIN32
+		int count = _write(output_fd, data, (unsigned int)size);
+#else
+		ssize_t count = ::write(output_fd, data, size);
+		if (count < 0 && errno == EINTR) {
+			continue;
+		}
+#endif
+		if (count <= 0) {
+			std::cerr << "Ошибка: вывод программы не может быть записан" << std::endl;
+			write_failed = true;
+			return;
+		}
+
+		data += count;
+		size -= count;
+	}
+}
+
+void FdPort::flush() {
+}
@@ -0,0 +1,211 @@
+#pragma once
+
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// Размер блока, которым FdPort читает входные данные, в байтах
+const int FD_PORT_READ_SIZE = 64 * 1024;
+
+/*!
+\brief Порт ввода-вывода встроенных подпрограмм
+
+Через порт встроенные подпрограммы читают ввод и записывают вывод программы.
+Порт передается в состояние программы, поэтому запуски программы не зависят
+от стандартных потоков и могут выполняться параллельно или в тестах
+*/
+class IoPort {
+public:
+	virtual ~IoPort() = default;
+
+	/*!
+	Читает символ, пропуская пробельные символы, как оператор >> потока
+	\param[out] ch Символ или '\0', если ввод закончился
+	\return Флаг, удалось ли прочитать символ
+	*/
+	virtual bool read_char(char& ch) = 0;
+
+	/*!
+	Читает целое число в десятичной записи, пропуская пробельные символы, как оператор >> потока
+	\param[out] value Число или 0, если число прочитать не удалось
+	\return Флаг, удалось ли прочитать число
+	*/
+	virtual bool read_int(int& value) = 0;
+
+	/*!
+	Читает остаток строки. Символ перевода строки читается, но в строку не записывается
+	\param[out] line Строка
+	\return Флаг, удалось ли прочитать строку
+	*/
+	virtual bool read_line(std::string& line) = 0;
+
+	/*!
+	Записывает данные
+	\param[in] data Данные
+	\param[in] size Размер данных в байтах
+	*/
+	virtual void write(const char* data, size_t size) = 0;
+
+	/*!
+	Передает записанные данные получателю
+	*/
+	virtual void flush() = 0;
+};
+
+/*!
+Порт ввода-вывода поверх потоков стандартной библиотеки
+*/
+class StreamPort : public IoPort {
+private:
+	/// Входной поток
+	std::istream* input;
+
+	/// Выходной поток
+	std::ostream* output;
+
+public:
+	/*!
+	Конструктор порта
+	\param[in] input Входной поток
+	\param[in] output Выходной поток
+	*/
+	StreamPort(std::istream& input, std::ostream& output);
+
+	/*!
+	Отключает синхронизацию стандартных потоков с stdio и связь std::cin с std::cout.
+	Вывод перед чтением ввода сбрасывает OutputBuffer, поэтому связь потоков не нужна.
+	Вызывается до первой операции ввода-вывода
+	*/
+	static void disable_stdio_sync();
+
+	bool read_char(char& ch) override;
+	bool read_int(int& value) override;
+	bool read_line(std::string& line) override;
+	void write(const char* data, size_t size) override;
+	void flush() override;
+};
+
+/*!
+\brief Порт ввода-вывода с собственным разбором ввода
+
+Читает ввод из окна input_data, которое наследники пополняют в refill
+*/
+class BufferedPort : public IoPort {
+private:
+	/*!
+	Пропускает пробельные символы
+	\return Флаг, остались ли во вводе другие символы
+	*/
+	bool skip_whitespace();
+
+	/*!
+	Проверяет, остались ли во вводе символы, при необходимости пополняя окно
+	\return Флаг, остались ли во вводе символы
+	*/
+	bool has_input() {
+		return !input_data.empty() || refill();
+	}
+
+protected:
+	/// Ещё не прочитанная часть ввода
+	std::string_view input_data;
+
+	/*!
+	Пополняет окно input_data, когда оно прочитано полностью
+	\return Флаг, появились ли во вводе новые символы
+	*/
+	virtual bool refill() = 0;
+
+public:
+	bool read_char(char& ch) override;
+	bool read_int(int& value) override;
+	bool read_line(std::string& line) override;
+};
+
+/*!
+Порт ввода-вывода, читающий ввод из строки и записывающий вывод в строку
+*/
+class StringPort : public BufferedPort {
+private:
+	/// Ввод
+	std::string input;
+
+	/// Записанный вывод
+	std::string output;
+
+protected:
+	bool refill() override;
+
+public:
+	/*!
+	Конструктор порта
+	\param[in] input Ввод
+	*/
+	StringPort(std::string_view input = "");
+
+	/*!
+	Заменяет ещё не прочитанный ввод
+	\param[in] new_input Ввод
+	*/
+	void set_input(std::string_view new_input);
+
+	/*!
+	Возвращает записанный вывод
+	\return Вывод
+	*/
+	const std::string& get_output() const {
+		return output;
+	}
+
+	/*!
+	Очищает записанный вывод
+	*/
+	void clear_output() {
+		output.clear();
+	}
+
+	void write(const char* data, size_t size) override;
+	void flush() override;
+};
+
+/*!
+\brief Порт ввода-вывода поверх дескрипторов файлов
+
+Ввод читается блоками по FD_PORT_READ_SIZE байт, вывод записывается
+одним системным вызовом на каждый сброс OutputBuffer. Прерванные сигналом вызовы повторяются,
+а об ошибке чтения или записи один раз сообщается в стандартный поток ошибок. Дескрипторы портом не закрываются
+*/
+class FdPort : public BufferedPort {
+private:
+	/// Дескриптор ввода
+	int input_fd;
+
+	/// Дескриптор вывода
+	int output_fd;
+
+	/// Блок прочитанного ввода
+	std::vector<char> read_buffer;
+
+	/// Флаг, произошла ли ошибка чтения
+	bool read_failed = false;
+
+	/// Флаг, произошла ли ошибка записи
+	bool write_failed = false;
+
+protected:
+	bool refill() override;
+
+public:
+	/*!
+	Конструктор порта
+	\param[in] input_fd Дескриптор ввода
+	\param[in] output_fd Дескриптор вывода
+	*/
+	FdPort(int input_fd = 0, int output_fd = 1);
+
+	void write(const char* data, size_t size) override;
+	void flush() override;
+};
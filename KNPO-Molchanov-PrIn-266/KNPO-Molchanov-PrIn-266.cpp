@@ -3,31 +3,293 @@
 #include <vector>
 #include <memory>
 #include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <thread>
 
 #include "Interpreter.h"
+#include "SourceFile.h"
+#include "IoPort.h"
+#include "TranslationCache.h"
 
 
+/*!
+Выводит справку по использованию интерпретатора
+\param[in] program_name Имя исполняемого файла
+*/
+static void print_usage(const char* program_name) {
+	std::cerr << "Пример использования: " << program_name << " [--engine=instr|switch|threaded] [--no-fusion] [--dump-fusions] [--output=unbuffered|line|full] [--output-buffer-size=N] [--profile] [--profile-json=файл] [--profile-csv=файл] [--memory-size=N] [--grow-memory] [--stack-size=N] [--batch=каталог|список] [--batch-output=каталог] [--jobs=N] [--translation-jobs=N] [--io=stream|fd] [--cache[=каталог]] <файл.asm|файл.kbin>" << std::endl;
+	std::cerr << "Запись двоичного образа: " << program_name << " assemble [--no-fusion] [--memory-size=N] <файл.asm> [файл.kbin]" << std::endl;
+}
+
+/*!
+Определяет способ выполнения инструкций по его имени
+\param[in] name Имя способа выполнения
+\param[out] engine Способ выполнения
+\return Флаг, указывающий, известно ли имя
+*/
+static bool parse_engine(const std::string& name, ENGINE& engine) {
+	if (name == "instr") {
+		engine = ENGINE::INSTR;
+	}
+	else if (name == "switch") {
+		engine = ENGINE::SWITCH;
+	}
+	else if (name == "threaded") {
+		engine = ENGINE::THREADED;
+	}
+	else {
+		return false;
+	}
+
+	return true;
+}
+
+/*!
+Определяет режим буферизации вывода по его имени
+\param[in] name Имя режима буферизации
+\param[out] buffering Режим буферизации
+\return Флаг, указывающий, известно ли имя
+*/
+static bool parse_buffering(const std::string& name, BUFFERING& buffering) {
+	if (name == "unbuffered") {
+		buffering = BUFFERING::NONE;
+	}
+	else if (name == "line") {
+		buffering = BUFFERING::LINE;
+	}
+	else if (name == "full") {
+		buffering = BUFFERING::FULL;
+	}
+	else {
+		return false;
+	}
+
+	return true;
+}
+
+/*!
+Составляет список входных файлов пакетного режима
+\param[in] batch Каталог, все файлы которого являются входными, или файл со списком входных файлов по одному в строке
+\param[out] input_files Входные файлы
+\return Флаг, удалось ли прочитать каталог или список
+*/
+static bool collect_input_files(const std::string& batch, std::vector<std::string>& input_files) {
+	std::error_code error;
+
+	if (std::filesystem::is_directory(batch, error)) {
+		for (const auto& entry : std::filesystem::directory_iterator(batch, error)) {
+			if (entry.is_regular_file()) {
+				input_files.push_back(entry.path().string());
+			}
+		}
+		std::sort(input_files.begin(), input_files.end());
+		return !error;
+	}
+
+	std::ifstream list_file(batch);
+	if (!list_file) {
+		return false;
+	}
+
+	std::string line;
+	while (std::getline(list_file, line)) {
+		if (!line.empty() && line.back() == '\r') {
+			line.pop_back();
+		}
+		if (!line.empty()) {
+			input_files.push_back(line);
+		}
+	}
+
+	return true;
+}
+
 int main(int argc, char* argv[]) {
-	if (argc != 2) {
-		std::cerr << "Пример использования: " << argv[0] << " <файл.asm>" << std::endl;
+	// Интерпретатор не пользуется функциями stdio, поэтому синхронизация с ними не нужна
+	StreamPort::disable_stdio_sync();
+
+	InterpreterOptions options;
+	std::string file_name;
+	std::string image_name;
+	bool memory_size_given = false;
+	std::string batch;
+	std::string batch_output;
+	int jobs = std::max(1, (int)std::thread::hardware_concurrency());
+	options.translation_threads = jobs;
+
+	// Подкоманда assemble записывает двоичный образ программы вместо её выполнения
+	bool assemble = argc > 1 && std::string(argv[1]) == "assemble";
+
+	for (int i = assemble ? 2 : 1; i < argc; i++) {
+		std::string arg(argv[i]);
+
+		if (arg.compare(0, 9, "--engine=") == 0) {
+			if (!parse_engine(arg.substr(9), options.engine)) {
+				std::cerr << "Ошибка: неизвестный способ выполнения \"" << arg.substr(9) << "\"" << std::endl;
+				return 1;
+			}
+		}
+		else if (arg.compare(0, 9, "--output=") == 0) {
+			if (!parse_buffering(arg.substr(9), options.output_buffering)) {
+				std::cerr << "Ошибка: неизвестный режим буферизации вывода \"" << arg.substr(9) << "\"" << std::endl;
+				return 1;
+			}
+		}
+		else if (arg.compare(0, 21, "--output-buffer-size=") == 0) {
+			std::string size = arg.substr(21);
+			if (size.empty() || size.find_first_not_of("0123456789") != std::string::npos || size.size() > 9 || std::stoi(size) == 0) {
+				std::cerr << "Ошибка: недопустимый размер буфера вывода \"" << size << "\"" << std::endl;
+				return 1;
+			}
+			options.output_buffer_size = std::stoi(size);
+		}
+		else if (arg.compare(0, 14, "--memory-size=") == 0) {
+			std::string size = arg.substr(14);
+			if (size.empty() || size.find_first_not_of("0123456789") != std::string::npos || size.size() > 9 || std::stoi(size) == 0) {
+				std::cerr << "Ошибка: недопустимый размер памяти \"" << size << "\"" << std::endl;
+				return 1;
+			}
+			options.memory_size = std::stoi(size);
+			memory_size_given = true;
+		}
+		else if (arg.compare(0, 13, "--stack-size=") == 0) {
+			std::string size = arg.substr(13);
+			if (size.empty() || size.find_first_not_of("0123456789") != std::string::npos || size.size() > 9 || std::stoi(size) == 0) {
+				std::cerr << "Ошибка: недопустимый размер стека \"" << size << "\"" << std::endl;
+				return 1;
+			}
+			options.stack_size = std::stoi(size);
+		}
+		else if (arg.compare(0, 8, "--batch=") == 0) {
+			batch = arg.substr(8);
+		}
+		else if (arg.compare(0, 15, "--batch-output=") == 0) {
+			batch_output = arg.substr(15);
+		}
+		else if (arg.compare(0, 7, "--jobs=") == 0) {
+			std::string count = arg.substr(7);
+			if (count.empty() || count.find_first_not_of("0123456789") != std::string::npos || count.size() > 4 || std::stoi(count) == 0) {
+				std::cerr << "Ошибка: недопустимое количество потоков \"" << count << "\"" << std::endl;
+				return 1;
+			}
+			jobs = std::stoi(count);
+		}
+		else if (arg.compare(0, 19, "--translation-jobs=") == 0) {
+			std::string count = arg.substr(19);
+			if (count.empty() || count.find_first_not_of("0123456789") != std::string::npos || count.size() > 4 || std::stoi(count) == 0) {
+				std::cerr << "Ошибка: недопустимое количество потоков трансляции \"" << count << "\"" << std::endl;
+				return 1;
+			}
+			options.translation_threads = std::stoi(count);
+		}
+		else if (arg == "--io=stream") {
+			options.io_port = IO_PORT::STREAM;
+		}
+		else if (arg == "--io=fd") {
+			options.io_port = IO_PORT::FD;
+		}
+		else if (arg == "--cache") {
+			options.cache_directory = DEFAULT_TRANSLATION_CACHE_DIRECTORY;
+		}
+		else if (arg.compare(0, 8, "--cache=") == 0 && arg.size() > 8) {
+			options.cache_directory = arg.substr(8);
+		}
+		else if (arg == "--grow-memory") {
+			options.memory_mode = MEMORY_MODE::GROWABLE;
+		}
+		else if (arg == "--profile") {
+			options.profile = true;
+		}
+		else if (arg.compare(0, 15, "--profile-json=") == 0) {
+			options.profile = true;
+			options.profile_json = arg.substr(15);
+		}
+		else if (arg.compare(0, 14, "--profile-csv=") == 0) {
+			options.profile = true;
+			options.profile_csv = arg.substr(14);
+		}
+		else if (arg == "--no-fusion") {
+			options.fuse = false;
+		}
+		else if (arg == "--dump-fusions") {
+			options.dump_fusions = true;
+		}
+		else if (arg.compare(0, 2, "--") == 0 || !image_name.empty() || (!file_name.empty() && !assemble)) {
+			print_usage(argv[0]);
+			return 1;
+		}
+		else if (file_name.empty()) {
+			file_name = arg;
+		}
+		else {
+			image_name = arg;
+		}
+	}
+
+	if (file_name.empty()) {
+		print_usage(argv[0]);
 		return 1;
 	}
 
-	std::string file_name(argv[1]);
-	if (file_name.substr(file_name.find_last_of(".") + 1) != "asm") {
-		std::cerr << "Ошибка: файл \"" << argv[1] << "\" должен иметь расширение \".asm\"" << std::endl;
+	// Подключаемая по мере обращения память по умолчанию намного больше, так как неиспользуемая её часть ничего не стоит
+	if (options.memory_mode == MEMORY_MODE::GROWABLE && !memory_size_given) {
+		options.memory_size = DEFAULT_GROWABLE_MEMORY_SIZE;
+	}
+
+	std::string extension = file_name.substr(file_name.find_last_of(".") + 1);
+	if (extension != "asm" && (assemble || extension != "kbin")) {
+		std::cerr << "Ошибка: файл \"" << file_name << "\" должен иметь расширение \".asm\"" << (assemble ? "" : " или \".kbin\"") << std::endl;
 		return 1;
 	}
 
-	std::ifstream input_file(file_name);
-	if (!input_file.is_open()) {
-		std::cerr << "Ошибка: файл \"" << argv[1] << "\" не может быть открыт" << std::endl;
+	// Текст или образ программы отображается в память и разбирается без копирования
+	SourceFile source;
+	if (!source.open(file_name)) {
+		std::cerr << "Ошибка: файл \"" << file_name << "\" не может быть открыт" << std::endl;
 		return 1;
 	}
 
-	Interpreter interp;
-	interp.interpret(input_file);
+	Interpreter interp(options);
+
+	if (assemble) {
+		if (image_name.empty()) {
+			image_name = file_name.substr(0, file_name.size() - extension.size()) + "kbin";
+		}
+
+		std::ofstream image_file(image_name, std::ios::binary);
+		if (!image_file) {
+			std::cerr << "Ошибка: файл \"" << image_name << "\" не может быть открыт" << std::endl;
+			return 1;
+		}
+
+		if (!interp.assemble(source.get_text(), image_file)) {
+			image_file.close();
+			std::filesystem::remove(image_name);
+			return 1;
+		}
+		return 0;
+	}
+
+	if (!batch.empty()) {
+		if (options.profile) {
+			std::cerr << "Ошибка: профилирование в пакетном режиме не поддерживается" << std::endl;
+			return 1;
+		}
+
+		std::vector<std::string> input_files;
+		if (!collect_input_files(batch, input_files)) {
+			std::cerr << "Ошибка: каталог или список входных файлов \"" << batch << "\" не может быть прочитан" << std::endl;
+			return 1;
+		}
+
+		if (!interp.interpret_batch(source.get_text(), input_files, batch_output, jobs)) {
+			return 1;
+		}
+		return 0;
+	}
+
+	interp.interpret(source.get_text());
 
-	input_file.close();
 	return 0;
 }
\ No newline at end of file
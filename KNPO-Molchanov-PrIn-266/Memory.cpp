@@ -0,0 +1,183 @@
+#include <cstddef>
+#include <vector>
+#include <memory>
+#include <algorithm>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+#include "Memory.h"
+
+
+Memory::~Memory() {
+	release();
+}
+
+/*!
+Освобождает память
+*/
+void Memory::release() {
+	if (mode == MEMORY_MODE::GROWABLE && cells != nullptr) {
+#ifdef _WIN32
+		VirtualFree(cells, 0, MEM_RELEASE);
+#else
+		munmap(cells, reserved_bytes);
+#endif
+	}
+
+	buffer = std::vector<int>();
+	dirty_flags = std::vector<char>();
+	dirty_pages = std::vector<int>();
+	base.reset();
+	cells = nullptr;
+	size = 0;
+	committed_size = 0;
+	reserved_bytes = 0;
+}
+
+/*!
+Выделяет память. Прежнее содержимое теряется
+\param[in] new_size Количество ячеек
+\param[in] new_mode Способ выделения памяти
+\return Флаг, удалось ли выделить или зарезервировать память
+*/
+bool Memory::allocate(int new_size, MEMORY_MODE new_mode) {
+	release();
+	mode = new_mode;
+
+	if (new_size <= 0) {
+		return false;
+	}
+
+	dirty_flags.assign((new_size + MEMORY_PAGE_SIZE - 1) / MEMORY_PAGE_SIZE, 0);
+
+	if (mode == MEMORY_MODE::FIXED) {
+		buffer.assign(new_size, 0);
+		cells = buffer.data();
+		size = new_size;
+		committed_size = new_size;
+		return true;
+	}
+
+	// Резервируется только адресное пространство, физическая память не выделяется
+	size_t bytes = ((size_t)new_size * sizeof(int) + MEMORY_COMMIT_SIZE - 1) / MEMORY_COMMIT_SIZE * MEMORY_COMMIT_SIZE;
+#ifdef _WIN32
+	void* reserved = VirtualAlloc(nullptr, bytes, MEM_RESERVE, PAGE_NOACCESS);
+	if (reserved == nullptr) {
+		return false;
+	}
+#else
+	void* reserved = mmap(nullptr, bytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+	if (reserved == MAP_FAILED) {
+		return false;
+	}
+#endif
+
+	cells = (int*)reserved;
+	size = new_size;
+	committed_size = 0;
+	reserved_bytes = bytes;
+	return true;
+}
+
+/*!
+Подключает память так, чтобы к первым end ячейкам можно было обращаться
+\param[in] end Количество ячеек от начала памяти, не больше размера памяти
+\return Флаг, удалось ли подключить память
+*/
+bool Memory::commit(int end) {
+	if (end <= committed_size) {
+		return true;
+	}
+	if (end > size) {
+		return false;
+	}
+
+	// Память подключается целыми блоками, чтобы обращения к соседним ячейкам не требовали подключения
+	size_t committed_bytes = (size_t)committed_size * sizeof(int);
+	size_t new_committed_bytes = ((size_t)end * sizeof(int) + MEMORY_COMMIT_SIZE - 1) / MEMORY_COMMIT_SIZE * MEMORY_COMMIT_SIZE;
+	if (new_committed_bytes > reserved_bytes) {
+		new_committed_bytes = reserved_bytes;
+	}
+
+	char* start = (char*)cells + committed_bytes;
+	size_t length = new_committed_bytes - committed_bytes;
+#ifdef _WIN32
+	if (VirtualAlloc(start, length, MEM_COMMIT, PAGE_READWRITE) == nullptr) {
+		return false;
+	}
+#else
+	if (mprotect(start, length, PROT_READ | PROT_WRITE) != 0) {
+		return false;
+	}
+#endif
+
+	size_t new_committed_size = new_committed_bytes / sizeof(int);
+	committed_size = new_committed_size < (size_t)size ? (int)new_committed_size : size;
+	return true;
+}
+
+/*!
+Забывает измененные страницы
+*/
+void Memory::clear_dirty() {
+	for (int page : dirty_pages) {
+		dirty_flags[page] = 0;
+	}
+	dirty_pages.clear();
+}
+
+/*!
+Делает снимок подключенной памяти. Измененные страницы после этого
+запоминаются относительно сделанного снимка
+\return Снимок памяти
+*/
+MemorySnapshot Memory::snapshot() {
+	MemorySnapshot memory_snapshot;
+	memory_snapshot.cells = std::make_shared<const std::vector<int>>(cells, cells + committed_size);
+
+	base = memory_snapshot.cells;
+	clear_dirty();
+
+	return memory_snapshot;
+}
+
+/*!
+Восстанавливает память из снимка. Если память уже делала этот снимок или
+восстанавливалась из него, копируются только измененные с тех пор страницы.
+Иначе копируется весь снимок, а остальная подключенная память заполняется нулями
+\param[in] memory_snapshot Снимок памяти
+\return Флаг, удалось ли подключить память под содержимое снимка
+*/
+bool Memory::restore(const MemorySnapshot& memory_snapshot) {
+	const std::vector<int>& image = *memory_snapshot.cells;
+	if (!commit(image.size())) {
+		return false;
+	}
+
+	if (is_based_on(memory_snapshot)) {
+		// Страницы за пределами снимка до изменения были заполнены нулями
+		for (int page : dirty_pages) {
+			int start = page * MEMORY_PAGE_SIZE;
+			int end = std::min(start + MEMORY_PAGE_SIZE, committed_size);
+			int image_end = std::max(start, std::min(end, (int)image.size()));
+
+			if (image_end > start) {
+				std::copy(image.data() + start, image.data() + image_end, cells + start);
+			}
+			std::fill(cells + image_end, cells + end, 0);
+		}
+	}
+	else {
+		std::copy(image.begin(), image.end(), cells);
+		std::fill(cells + image.size(), cells + committed_size, 0);
+		base = memory_snapshot.cells;
+	}
+
+	clear_dirty();
+	return true;
+}
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <memory>
+
+/// Размер памяти по умолчанию в ячейках
+const int DEFAULT_MEMORY_SIZE = 2048;
+
+/// Размер памяти по умолчанию в ячейках в режиме MEMORY_MODE::GROWABLE
+const int DEFAULT_GROWABLE_MEMORY_SIZE = 64 * 1024 * 1024;
+
+/// Размер в байтах, которым подключается зарезервированная память в режиме MEMORY_MODE::GROWABLE
+const size_t MEMORY_COMMIT_SIZE = 64 * 1024;
+
+/// Количество ячеек в странице памяти. Страница - единица отслеживания изменений для снимков памяти
+const int MEMORY_PAGE_SIZE = 1024;
+
+/// Способы выделения памяти программы
+enum class MEMORY_MODE {
+	FIXED, ///< Вся память выделяется и заполняется нулями сразу
+	GROWABLE, ///< Адресное пространство резервируется сразу, а страницы подключаются при первом обращении к ним
+};
+
+/*!
+Снимок памяти. Содержимое снимка не изменяется, поэтому один снимок
+могут совместно использовать несколько экземпляров памяти
+*/
+struct MemorySnapshot {
+	/// Содержимое подключенной на момент снимка памяти
+	std::shared_ptr<const std::vector<int>> cells;
+};
+
+/*!
+\brief Ячейки памяти программы на псевдо-ассемблере
+
+В режиме MEMORY_MODE::GROWABLE память резервируется через mmap или VirtualAlloc
+и подключается блоками по мере обращения к ней. Подключенные страницы операционная
+система заполняет нулями сама, поэтому память, к которой программа не обращалась,
+не тратит ни времени, ни физической памяти.
+
+Память запоминает страницы, измененные после последнего снимка или восстановления.
+Восстановление того же снимка копирует из него только эти страницы
+*/
+class Memory {
+private:
+	/// Первая ячейка памяти
+	int* cells = nullptr;
+
+	/// Количество ячеек
+	int size = 0;
+
+	/// Количество ячеек от начала памяти, к которым можно обращаться без подключения
+	int committed_size = 0;
+
+	/// Способ выделения памяти
+	MEMORY_MODE mode = MEMORY_MODE::FIXED;
+
+	/// Ячейки памяти в режиме MEMORY_MODE::FIXED
+	std::vector<int> buffer;
+
+	/// Длина зарезервированной области в байтах в режиме MEMORY_MODE::GROWABLE
+	size_t reserved_bytes = 0;
+
+	/// Флаги измененных страниц
+	std::vector<char> dirty_flags;
+
+	/// Номера измененных страниц
+	std::vector<int> dirty_pages;
+
+	/// Содержимое снимка, относительно которого запоминаются измененные страницы, или nullptr
+	std::shared_ptr<const std::vector<int>> base;
+
+	/*!
+	Запоминает, что страница изменена
+	\param[in] page Номер страницы
+	*/
+	void mark_dirty(int page) {
+		dirty_flags[page] = 1;
+		dirty_pages.push_back(page);
+	}
+
+	/*!
+	Забывает измененные страницы
+	*/
+	void clear_dirty();
+
+	/*!
+	Освобождает память
+	*/
+	void release();
+
+public:
+	Memory() = default;
+
+	Memory(const Memory&) = delete;
+	Memory& operator=(const Memory&) = delete;
+
+	~Memory();
+
+	/*!
+	Выделяет память. Прежнее содержимое теряется
+	\param[in] new_size Количество ячеек
+	\param[in] new_mode Способ выделения памяти
+	\return Флаг, удалось ли выделить или зарезервировать память
+	*/
+	bool allocate(int new_size, MEMORY_MODE new_mode);
+
+	/*!
+	Подключает память так, чтобы к первым end ячейкам можно было обращаться
+	\param[in] end Количество ячеек от начала памяти, не больше размера памяти
+	\return Флаг, удалось ли подключить память
+	*/
+	bool commit(int end);
+
+	/*!
+	Возвращает количество ячеек
+	\return Количество ячеек
+	*/
+	int get_size() const {
+		return size;
+	}
+
+	/*!
+	Возвращает количество ячеек от начала памяти, к которым можно обращаться без подключения.
+	Адрес, меньший этого количества, заведомо допустим
+	\return Количество подключенных ячеек
+	*/
+	int get_committed_size() const {
+		return committed_size;
+	}
+
+	/*!
+	Возвращает способ выделения памяти
+	\return Способ выделения памяти
+	*/
+	MEMORY_MODE get_mode() const {
+		return mode;
+	}
+
+	/*!
+	Возвращает значение ячейки. Адрес должен быть меньше количества подключенных ячеек
+	\param[in] address Адрес
+	\return Значение ячейки
+	*/
+	int get(int address) const {
+		return cells[address];
+	}
+
+	/*!
+	Устанавливает значение ячейки. Адрес должен быть меньше количества подключенных ячеек
+	\param[in] address Адрес
+	\param[in] value Значение
+	*/
+	void set(int address, int value) {
+		int page = address / MEMORY_PAGE_SIZE;
+		if (!dirty_flags[page]) {
+			mark_dirty(page);
+		}
+		cells[address] = value;
+	}
+
+	/*!
+	Делает снимок подключенной памяти. Измененные страницы после этого
+	запоминаются относительно сделанного снимка
+	\return Снимок памяти
+	*/
+	MemorySnapshot snapshot();
+
+	/*!
+	Восстанавливает память из снимка. Если память уже делала этот снимок или
+	восстанавливалась из него, копируются только измененные с тех пор страницы.
+	Иначе копируется весь снимок, а остальная подключенная память заполняется нулями
+	\param[in] memory_snapshot Снимок памяти
+	\return Флаг, удалось ли подключить память под содержимое снимка
+	*/
+	bool restore(const MemorySnapshot& memory_snapshot);
+
+	/*!
+	Проверяет, запоминаются ли измененные страницы относительно снимка
+	\param[in] memory_snapshot Снимок памяти
+	\return Флаг, делала ли память этот снимок или восстанавливалась ли из него последним
+	*/
+	bool is_based_on(const MemorySnapshot& memory_snapshot) const {
+		return base == memory_snapshot.cells;
+	}
+
+	/*!
+	Возвращает количество страниц, измененных после последнего снимка или восстановления
+	\return Количество измененных страниц
+	*/
+	int get_dirty_page_count() const {
+		return dirty_pages.size();
+	}
+};
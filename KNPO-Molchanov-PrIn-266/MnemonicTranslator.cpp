@@ -2,12 +2,22 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <charconv>
 #include <fstream>
 #include <iostream>
+#include <algorithm>
+#include <iterator>
+#include <thread>
+#include <climits>
+#include <cstdint>
 
 #include "Tokenizer.h"
+#include "DfaTokenizer.h"
 #include "Instruction.h"
 #include "MnemonicTranslator.h"
+#include "Bytecode.h"
+#include "SourceFile.h"
 
 
 static inline bool is_register_token(TOKEN_TYPE type) {
@@ -18,7 +28,8 @@ static inline bool is_register_token(TOKEN_TYPE type) {
 		|| type == TOKEN_TYPE::R4
 		|| type == TOKEN_TYPE::R5
 		|| type == TOKEN_TYPE::R6
-		|| type == TOKEN_TYPE::R7;
+		|| type == TOKEN_TYPE::R7
+		|| type == TOKEN_TYPE::SP;
 }
 
 static inline bool is_number_token(TOKEN_TYPE type) {
@@ -29,41 +40,34 @@ static inline bool is_number_token(TOKEN_TYPE type) {
 		|| type == TOKEN_TYPE::CHAR;
 }
 
-static inline int convert_to_int(Token token) {
-	std::string s = token.text;
+static inline int convert_to_int(const Token& token, bool negative) {
+	if (token.type == TOKEN_TYPE::CHAR) {
+		return negative ? -(int)token.text[1] : (int)token.text[1];
+	}
+
+	std::string_view digits = token.text;
+	int base = 10;
 
 	// Если число записано не в десятичной системе счисления...
 	if (token.type != TOKEN_TYPE::DECIMAL_NUMBER) {
 		// ...пропускаем префикс системы счисления
-		s = s.substr(2);
-	}
-
-	switch (token.type) {
-	case TOKEN_TYPE::HEX_NUMBER:
-		return std::stol(s, 0, 16);
-	case TOKEN_TYPE::DECIMAL_NUMBER:
-		return std::stol(s, 0, 10);
-	case TOKEN_TYPE::OCTAL_NUMBER:
-		return std::stol(s, 0, 8);
-	case TOKEN_TYPE::BINARY_NUMBER:
-		return std::stol(s, 0, 2);
-	case TOKEN_TYPE::CHAR:
-		return (int)token.text[1];
-	default:
-		return std::stol(s, 0, 2);
+		digits.remove_prefix(2);
+		base = token.type == TOKEN_TYPE::HEX_NUMBER ? 16 : token.type == TOKEN_TYPE::OCTAL_NUMBER ? 8 : 2;
+	}
+
+	// Число разбирается прямо из текста токена, без создания временной строки
+	long long value = 0;
+	std::from_chars_result result = std::from_chars(digits.data(), digits.data() + digits.size(), value, base);
+
+	// Десятичное число должно помещаться в int, а остальные задают 32-битный образ числа
+	long long max_value = token.type != TOKEN_TYPE::DECIMAL_NUMBER ? UINT32_MAX : negative ? -(long long)INT_MIN : INT_MAX;
+	if (result.ec != std::errc() || value > max_value) {
+		throw SyntaxError("Слишком большое число \"" + std::string(token.text) + "\"");
 	}
-}
 
-static std::map<TOKEN_TYPE, REGISTER> reg_table{
-	{ TOKEN_TYPE::R0, REGISTER::R0 },
-	{ TOKEN_TYPE::R1, REGISTER::R1 },
-	{ TOKEN_TYPE::R2, REGISTER::R2 },
-	{ TOKEN_TYPE::R3, REGISTER::R3 },
-	{ TOKEN_TYPE::R4, REGISTER::R4 },
-	{ TOKEN_TYPE::R5, REGISTER::R5 },
-	{ TOKEN_TYPE::R6, REGISTER::R6 },
-	{ TOKEN_TYPE::R7, REGISTER::R7 },
-};
+	unsigned int bits = (unsigned int)value;
+	return (int)(negative ? 0u - bits : bits);
+}
 
 /*!
 Конструктор ошибки
@@ -90,837 +94,1153 @@ void SyntaxError::change_error_message(const std::string& m) {
 }
 
 /*!
-Проверяет, что токен на заданной позиции является требуемой командной, иначе
+Проверяет, что текущий токен является требуемой командной, иначе
 бросает исключение, с соотвествующим сообщением, какой токен команды ожидался
-\param[in] tokens Токены
-\param[in] pos Заданная позиция
+\param[in|out] cursor Курсор по токенам строки, переводится на следующий токен
 \param[in] command_type Требуемый тип команды
 \param[in] command_name Имя команды для исключения, в случае если команды не было найдено
-\return Позиция токена, следующего за искомым токеном
 \throw SyntaxError В случае, если искомого токена не оказалось на заданной позици
 */
-int MnemonicTranslator::check_command(std::vector<Token> tokens, int pos, TOKEN_TYPE command_type, const std::string& command_name) const {
-	if (tokens.size() == 0 || pos < 0 || pos >= tokens.size()) {
-		throw SyntaxError("Ожидалась команда \"" + command_name + "\"");
+void MnemonicTranslator::check_command(TokenCursor& cursor, TOKEN_TYPE command_type, std::string_view command_name) const {
+	if (cursor.at_end()) {
+		throw SyntaxError("Ожидалась команда \"" + std::string(command_name) + "\"");
 	}
-	else if (tokens[pos].type != command_type) {
-		throw SyntaxError("Ожидалась команда \"" + command_name + "\", получено \"" + tokens[pos].text + "\"");
+	else if (cursor.peek().type != command_type) {
+		throw SyntaxError("Ожидалась команда \"" + std::string(command_name) + "\", получено \"" + std::string(cursor.peek().text) + "\"");
 	}
 
-	return pos + 1;
+	cursor.next();
 }
 
 /*!
-Проверяет, что токен на заданной позиции является запятой, иначе бросает исключение
+Проверяет, что текущий токен является запятой, иначе бросает исключение
 с сообщением, что ожидалась запятая
-\param[in] tokens Токены
-\param[in] pos Заданная позиция
-\return Позиция токена, следующего за искомым токеном
+\param[in|out] cursor Курсор по токенам строки, переводится на следующий токен
 \throw SyntaxError В случае, если запятой не оказалось на заданной позиции
 */
-int MnemonicTranslator::check_comma(const std::vector<Token>& tokens, int pos) const {
-	if (tokens.size() == 0 || pos < 0 || pos >= tokens.size()) {
+void MnemonicTranslator::check_comma(TokenCursor& cursor) const {
+	if (cursor.at_end()) {
 		throw SyntaxError("Ожидалась запятая");
 	}
-	else if (tokens[pos].type != TOKEN_TYPE::COMMA) {
-		throw SyntaxError("Ожидалась запятая, получено \"" + tokens[pos].text + "\"");
+	else if (cursor.peek().type != TOKEN_TYPE::COMMA) {
+		throw SyntaxError("Ожидалась запятая, получено \"" + std::string(cursor.peek().text) + "\"");
 	}
 
-	return pos + 1;
+	cursor.next();
 }
 
 /*!
-Проверят, что на заданной позиции находится токен регистра, иначе бросает исключение
+Проверят, что текущий токен является токеном регистра, иначе бросает исключение
 с сообщением, что ожидался регистр
-\param[in] tokens Токены
-\param[in] pos Заданная позиция
-\return Позиция токена, следующего за искомым токеном
+\param[in] cursor Курсор по токенам строки
 \throw SyntaxError В случае, если регистра не оказалось на заданной позиции
 */
-void MnemonicTranslator::expect_register(const std::vector<Token>& tokens, int pos) const {
-	if (tokens.size() == 0 || pos < 0 || pos >= tokens.size()) {
+void MnemonicTranslator::expect_register(const TokenCursor& cursor) const {
+	if (cursor.at_end()) {
 		throw SyntaxError("Ожидался регистр");
 	}
-	else if (!is_register_token(tokens[pos].type)) {
-		throw SyntaxError("Ожидался регистр, получено \"" + tokens[pos].text + "\"");
+	else if (!is_register_token(cursor.peek().type)) {
+		throw SyntaxError("Ожидался регистр, получено \"" + std::string(cursor.peek().text) + "\"");
 	}
 }
 
 /*!
-Проверят, что на заданной позиции находится токен имени, иначе бросает исключение
+Проверят, что текущий токен является токеном имени, иначе бросает исключение
 с сообщением, что ожидалось имя
-\param[in] tokens Токены
-\param[in] pos Заданная позиция
-\return Позиция токена, следующего за искомым токеном
+\param[in] cursor Курсор по токенам строки
 \throw SyntaxError В случае, если имени не оказалось на заданной позиции
 */
-void MnemonicTranslator::expect_name(const std::vector<Token>& tokens, int pos) const {
-	if (tokens.size() == 0 || pos < 0 || pos >= tokens.size()) {
+void MnemonicTranslator::expect_name(const TokenCursor& cursor) const {
+	if (cursor.at_end()) {
 		throw SyntaxError("Ожидалось имя");
 	}
-	else if (tokens[pos].type != TOKEN_TYPE::NAME) {
-		throw SyntaxError("Ожидалось имя, получено \"" + tokens[pos].text + "\"");
+	else if (cursor.peek().type != TOKEN_TYPE::NAME) {
+		throw SyntaxError("Ожидалось имя, получено \"" + std::string(cursor.peek().text) + "\"");
 	}
 }
 
 /*!
-Проверят, что на заданной позиции находится токен числа, иначе бросает исключение
+Проверят, что текущий токен является токеном числа, иначе бросает исключение
 с сообщением, что ожидалось число
-\param[in] tokens Токены
-\param[in] pos Заданная позиция
-\return Позиция токена, следующего за искомым токеном
+\param[in] cursor Курсор по токенам строки
 \throw SyntaxError В случае, если числа не оказалось на заданной позиции
 */
-void MnemonicTranslator::expect_number(const std::vector<Token>& tokens, int pos) const {
-	if (tokens.size() == 0 || pos < 0 || pos >= tokens.size()) {
+void MnemonicTranslator::expect_number(const TokenCursor& cursor) const {
+	if (cursor.at_end()) {
 		throw SyntaxError("Ожидалось число");
 	}
-	else if (!is_number_token(tokens[pos].type)) {
-		throw SyntaxError("Ожидалось число, получено \"" + tokens[pos].text + "\"");
+	else if (!is_number_token(cursor.peek().type)) {
+		throw SyntaxError("Ожидалось число, получено \"" + std::string(cursor.peek().text) + "\"");
 	}
 }
 
 /*!
-Извлекает числовой токен с заданной позиции и конвертирует его в число
-\param[in] tokens Токены
-\param[in] pos Заданная позиция
+Извлекает числовой токен, перед которым может стоять знак, и конвертирует его в число
+\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за числом
 \param[out] number Сконвертированное число
-\return Позиция токена, следующего числовым токеном
 \throw SyntaxError В случае, если числа не оказалось на заданной позиции
 */
-int MnemonicTranslator::extract_number(std::vector<Token> tokens, int pos, int& number) const {
-	int i = pos;
-	if (tokens.size() == 0 || i < 0 || i >= tokens.size()) {
+void MnemonicTranslator::extract_number(TokenCursor& cursor, int& number) const {
+	if (cursor.at_end()) {
 		throw SyntaxError("Ожидалось число");
 	}
 
-	int sign = 1;
-	if (tokens[i].type == TOKEN_TYPE::MINUS || tokens[i].type == TOKEN_TYPE::PLUS) {
-		sign = tokens[i].type == TOKEN_TYPE::MINUS ? -1 : 1;
-		i++;
+	bool negative = false;
+	if (cursor.peek().type == TOKEN_TYPE::MINUS || cursor.peek().type == TOKEN_TYPE::PLUS) {
+		negative = cursor.next().type == TOKEN_TYPE::MINUS;
 	}
 
-	expect_number(tokens, i);
-
-	number = convert_to_int(tokens[i]) * sign;
+	expect_number(cursor);
 
-	return i + 1;
+	number = convert_to_int(cursor.next(), negative);
 }
 
 /*!
-Извлекает токен регистра с заданной позиции и определяет регистр, который он обозначает
-\param[in] tokens Токены
-\param[in] pos Заданная позиция
+Извлекает токен регистра и определяет регистр, который он обозначает
+\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за регистром
 \param[out] reg Считанный регистр
-\return Позиция токена, следующего токеном регистра
 \throw SyntaxError В случае, если регистра не оказалось на заданной позиции
 */
-int MnemonicTranslator::extract_register(std::vector<Token> tokens, int pos, REGISTER& reg) const {
-	expect_register(tokens, pos);
-	reg = reg_table[tokens[pos].type];
-	return pos + 1;
+void MnemonicTranslator::extract_register(TokenCursor& cursor, REGISTER& reg) const {
+	expect_register(cursor);
+
+	// Токены регистров r0-r7 и sp идут в TOKEN_TYPE подряд, как и регистры в REGISTER
+	reg = (REGISTER)((int)cursor.next().type - (int)TOKEN_TYPE::R0);
 }
 
 /*!
-Извлекает токен имени с заданной позиции
-\param[in] tokens Токены
-\param[in] pos Заданная позиция
+Извлекает токен имени
+\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за именем
 \param[out] var_name Считанное имя
-\return Позиция токена, следующего токеном имени
 \throw SyntaxError В случае, если имени не оказалось на заданной позиции
 */
-int MnemonicTranslator::extract_name(std::vector<Token> tokens, int pos, std::string& var_name) const {
-	if (tokens.size() == 0) {
+void MnemonicTranslator::extract_name(TokenCursor& cursor, std::string& var_name) const {
+	if (cursor.at_end()) {
 		throw SyntaxError("Ожидалось имя метки");
 	}
-	else if (tokens[pos].type != TOKEN_TYPE::NAME) {
-		throw SyntaxError("Ожидалось имя метки, получено \"" + tokens[pos].text + "\"");
+	else if (cursor.peek().type != TOKEN_TYPE::NAME) {
+		throw SyntaxError("Ожидалось имя метки, получено \"" + std::string(cursor.peek().text) + "\"");
 	}
 
-	var_name = tokens[pos].text;
-
-	return pos + 1;
+	var_name.assign(cursor.next().text);
 }
 
 /*!
 Извлекает инструкцию "add" с заданной позиции
-\param[in] tokens Токены
-\param[in] pos Заданная позиция
+\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
 \param[out] add_instr Считанная инструкция "add"
-\return Позиция токена, следующего за инструкцией
 \throw SyntaxError В случае, если инструкция записана синтаксически неправильно
 */
-int MnemonicTranslator::extract_add_instr(const std::vector<Token>& tokens, int pos, std::shared_ptr<Instr>& add_instr) const {
-	int i = pos;
-
+void MnemonicTranslator::extract_add_instr(TokenCursor& cursor, std::shared_ptr<Instr>& add_instr) const {
 	// Проверяем, что первый токен в строке это "add"
-	i = check_command(tokens, i, TOKEN_TYPE::ADD, "add");
+	check_command(cursor, TOKEN_TYPE::ADD, "add");
 
 	// Выделяем первый аргумент команды - регистр
 	REGISTER dest;
-	i = extract_register(tokens, i, dest);
+	extract_register(cursor, dest);
 
 	// Пропускаем запятую после первого аргумента
-	i = check_comma(tokens, i);
+	check_comma(cursor);
 
 	// Проверяем, что после запятой идёт регистр или число
-	if (i == tokens.size()) {
+	if (cursor.at_end()) {
 		throw SyntaxError("Ожидалось число или регистр");
 	}
-	else if (!is_register_token(tokens[i].type)
-		&& tokens[i].type != TOKEN_TYPE::MINUS
-		&& tokens[i].type != TOKEN_TYPE::PLUS
-		&& !is_number_token(tokens[i].type)) {
-		throw SyntaxError("Ожидалось число или регистр, получено \"" + tokens[i].text + "\"");
+	else if (!is_register_token(cursor.peek().type)
+		&& cursor.peek().type != TOKEN_TYPE::MINUS
+		&& cursor.peek().type != TOKEN_TYPE::PLUS
+		&& !is_number_token(cursor.peek().type)) {
+		throw SyntaxError("Ожидалось число или регистр, получено \"" + std::string(cursor.peek().text) + "\"");
 	}
 
 	// Выделяем второй аргумент - число или регистр
-	if (is_register_token(tokens[i].type)) {
+	if (is_register_token(cursor.peek().type)) {
 		REGISTER src;
-		i = extract_register(tokens, i, src);
+		extract_register(cursor, src);
 		add_instr = std::make_shared<AddRegInstr>(dest, src);
 	}
 	else {
 		int imm_value;
-		i = extract_number(tokens, i, imm_value);
+		extract_number(cursor, imm_value);
 		add_instr = std::make_shared<AddImmInstr>(dest, imm_value);
 	}
-
-	return i;
 }
 
 /*!
 Извлекает инструкцию "sub" с заданной позиции
-\param[in] tokens Токены
-\param[in] pos Заданная позиция
+\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
 \param[out] sub_instr Считанная инструкция "sub"
-\return Позиция токена, следующего за инструкцией
 \throw SyntaxError В случае, если инструкция записана синтаксически неправильно
 */
-int MnemonicTranslator::extract_sub_instr(const std::vector<Token>& tokens, int pos, std::shared_ptr<Instr>& sub_instr) const {
-	int i = pos;
-
+void MnemonicTranslator::extract_sub_instr(TokenCursor& cursor, std::shared_ptr<Instr>& sub_instr) const {
 	// Проверяем, что первый токен в строке это "sub"
-	i = check_command(tokens, i, TOKEN_TYPE::SUB, "sub");
+	check_command(cursor, TOKEN_TYPE::SUB, "sub");
 
 	// Выделяем первый аргумент команды - регистр
 	REGISTER dest;
-	i = extract_register(tokens, i, dest);
+	extract_register(cursor, dest);
 
 	// Пропускаем запятую после первого аргумента
-	i = check_comma(tokens, i);
+	check_comma(cursor);
 
 	// Проверяем, что после запятой идёт регистр или число
-	if (i == tokens.size()) {
+	if (cursor.at_end()) {
 		throw SyntaxError("Ожидалось число или регистр");
 	}
-	else if (!is_register_token(tokens[i].type)
-		&& tokens[i].type != TOKEN_TYPE::MINUS
-		&& tokens[i].type != TOKEN_TYPE::PLUS
-		&& !is_number_token(tokens[i].type)) {
-		throw SyntaxError("Ожидалось число или регистр, получено \"" + tokens[i].text + "\"");
+	else if (!is_register_token(cursor.peek().type)
+		&& cursor.peek().type != TOKEN_TYPE::MINUS
+		&& cursor.peek().type != TOKEN_TYPE::PLUS
+		&& !is_number_token(cursor.peek().type)) {
+		throw SyntaxError("Ожидалось число или регистр, получено \"" + std::string(cursor.peek().text) + "\"");
 	}
 
 	// Выделяем второй аргумент - число или регистр
-	if (is_register_token(tokens[i].type)) {
+	if (is_register_token(cursor.peek().type)) {
 		REGISTER src;
-		i = extract_register(tokens, i, src);
+		extract_register(cursor, src);
 		sub_instr = std::make_shared<SubRegInstr>(dest, src);
 	}
 	else {
 		int imm_value;
-		i = extract_number(tokens, i, imm_value);
+		extract_number(cursor, imm_value);
 		sub_instr = std::make_shared<SubImmInstr>(dest, imm_value);
 	}
-
-	return i;
 }
 
 /*!
 Извлекает инструкцию "and" с заданной позиции
-\param[in] tokens Токены
-\param[in] pos Заданная позиция
+\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
 \param[out] and_instr Считанная инструкция "and"
-\return Позиция токена, следующего за инструкцией
 \throw SyntaxError В случае, если инструкция записана синтаксически неправильно
 */
-int MnemonicTranslator::extract_and_instr(const std::vector<Token>& tokens, int pos, std::shared_ptr<Instr>& and_instr) const {
-	int i = pos;
-
+void MnemonicTranslator::extract_and_instr(TokenCursor& cursor, std::shared_ptr<Instr>& and_instr) const {
 	// Проверяем, что первый токен в строке это "and"
-	i = check_command(tokens, i, TOKEN_TYPE::AND, "and");
+	check_command(cursor, TOKEN_TYPE::AND, "and");
 
 	// Выделяем первый аргумент команды - регистр
 	REGISTER dest;
-	i = extract_register(tokens, i, dest);
+	extract_register(cursor, dest);
 
 	// Пропускаем запятую после первого аргумента
-	i = check_comma(tokens, i);
+	check_comma(cursor);
 
 	// Проверяем, что после запятой идёт регистр или число
-	if (i == tokens.size()) {
+	if (cursor.at_end()) {
 		throw SyntaxError("Ожидалось число или регистр");
 	}
-	else if (!is_register_token(tokens[i].type)
-		&& tokens[i].type != TOKEN_TYPE::MINUS
-		&& tokens[i].type != TOKEN_TYPE::PLUS
-		&& !is_number_token(tokens[i].type)) {
-		throw SyntaxError("Ожидалось число или регистр, получено \"" + tokens[i].text + "\"");
+	else if (!is_register_token(cursor.peek().type)
+		&& cursor.peek().type != TOKEN_TYPE::MINUS
+		&& cursor.peek().type != TOKEN_TYPE::PLUS
+		&& !is_number_token(cursor.peek().type)) {
+		throw SyntaxError("Ожидалось число или регистр, получено \"" + std::string(cursor.peek().text) + "\"");
 	}
 
 	// Выделяем второй аргумент - число или регистр
-	if (is_register_token(tokens[i].type)) {
+	if (is_register_token(cursor.peek().type)) {
 		REGISTER src;
-		i = extract_register(tokens, i, src);
+		extract_register(cursor, src);
 		and_instr = std::make_shared<AndRegInstr>(dest, src);
 	}
 	else {
 		int imm_value;
-		i = extract_number(tokens, i, imm_value);
+		extract_number(cursor, imm_value);
 		and_instr = std::make_shared<AndImmInstr>(dest, imm_value);
 	}
-
-	return i;
 }
 
 /*!
 Извлекает инструкцию "or" с заданной позиции
-\param[in] tokens Токены
-\param[in] pos Заданная позиция
+\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
 \param[out] or_instr Считанная инструкция "or"
-\return Позиция токена, следующего за инструкцией
 \throw SyntaxError В случае, если инструкция записана синтаксически неправильно
 */
-int MnemonicTranslator::extract_or_instr(const std::vector<Token>& tokens, int pos, std::shared_ptr<Instr>& or_instr) const {
-	int i = pos;
-
+void MnemonicTranslator::extract_or_instr(TokenCursor& cursor, std::shared_ptr<Instr>& or_instr) const {
 	// Проверяем, что первый токен в строке это "or"
-	i = check_command(tokens, i, TOKEN_TYPE::OR, "or");
+	check_command(cursor, TOKEN_TYPE::OR, "or");
 
 	// Выделяем первый аргумент команды - регистр
 	REGISTER dest;
-	i = extract_register(tokens, i, dest);
+	extract_register(cursor, dest);
 
 	// Пропускаем запятую после первого аргумента
-	i = check_comma(tokens, i);
+	check_comma(cursor);
 
 	// Проверяем, что после запятой идёт регистр или число
-	if (i == tokens.size()) {
+	if (cursor.at_end()) {
 		throw SyntaxError("Ожидалось число или регистр");
 	}
-	else if (!is_register_token(tokens[i].type)
-		&& tokens[i].type != TOKEN_TYPE::MINUS
-		&& tokens[i].type != TOKEN_TYPE::PLUS
-		&& !is_number_token(tokens[i].type)) {
-		throw SyntaxError("Ожидалось число или регистр, получено \"" + tokens[i].text + "\"");
+	else if (!is_register_token(cursor.peek().type)
+		&& cursor.peek().type != TOKEN_TYPE::MINUS
+		&& cursor.peek().type != TOKEN_TYPE::PLUS
+		&& !is_number_token(cursor.peek().type)) {
+		throw SyntaxError("Ожидалось число или регистр, получено \"" + std::string(cursor.peek().text) + "\"");
 	}
 
 	// Выделяем второй аргумент - число или регистр
-	if (is_register_token(tokens[i].type)) {
+	if (is_register_token(cursor.peek().type)) {
 		REGISTER src;
-		i = extract_register(tokens, i, src);
+		extract_register(cursor, src);
 		or_instr = std::make_shared<OrRegInstr>(dest, src);
 	}
 	else {
 		int imm_value;
-		i = extract_number(tokens, i, imm_value);
+		extract_number(cursor, imm_value);
 		or_instr = std::make_shared<OrImmInstr>(dest, imm_value);
 	}
-
-	return i;
 }
 
 /*!
 Извлекает инструкцию "xor" с заданной позиции
-\param[in] tokens Токены
-\param[in] pos Заданная позиция
+\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
 \param[out] or_instr Считанная инструкция "xor"
-\return Позиция токена, следующего за инструкцией
 \throw SyntaxError В случае, если инструкция записана синтаксически неправильно
 */
-int MnemonicTranslator::extract_xor_instr(const std::vector<Token>& tokens, int pos, std::shared_ptr<Instr>& xor_instr) const {
-	int i = pos;
-
+void MnemonicTranslator::extract_xor_instr(TokenCursor& cursor, std::shared_ptr<Instr>& xor_instr) const {
 	// Проверяем, что первый токен в строке это "xor"
-	i = check_command(tokens, i, TOKEN_TYPE::XOR, "xor");
+	check_command(cursor, TOKEN_TYPE::XOR, "xor");
 
 	// Выделяем первый аргумент команды - регистр
 	REGISTER dest;
-	i = extract_register(tokens, i, dest);
+	extract_register(cursor, dest);
 
 	// Пропускаем запятую после первого аргумента
-	i = check_comma(tokens, i);
+	check_comma(cursor);
 
 	// Проверяем, что после запятой идёт регистр или число
-	if (i == tokens.size()) {
+	if (cursor.at_end()) {
 		throw SyntaxError("Ожидалось число или регистр");
 	}
-	else if (!is_register_token(tokens[i].type)
-		&& tokens[i].type != TOKEN_TYPE::MINUS
-		&& tokens[i].type != TOKEN_TYPE::PLUS
-		&& !is_number_token(tokens[i].type)) {
-		throw SyntaxError("Ожидалось число или регистр, получено \"" + tokens[i].text + "\"");
+	else if (!is_register_token(cursor.peek().type)
+		&& cursor.peek().type != TOKEN_TYPE::MINUS
+		&& cursor.peek().type != TOKEN_TYPE::PLUS
+		&& !is_number_token(cursor.peek().type)) {
+		throw SyntaxError("Ожидалось число или регистр, получено \"" + std::string(cursor.peek().text) + "\"");
 	}
 
 	// Выделяем второй аргумент - число или регистр
-	if (is_register_token(tokens[i].type)) {
+	if (is_register_token(cursor.peek().type)) {
 		REGISTER src;
-		i = extract_register(tokens, i, src);
+		extract_register(cursor, src);
 		xor_instr = std::make_shared<XorRegInstr>(dest, src);
 	}
 	else {
 		int imm_value;
-		i = extract_number(tokens, i, imm_value);
+		extract_number(cursor, imm_value);
 		xor_instr = std::make_shared<XorImmInstr>(dest, imm_value);
 	}
-
-	return i;
 }
 
 /*!
 Извлекает инструкцию "not" с заданной позиции
-\param[in] tokens Токены
-\param[in] pos Заданная позиция
+\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
 \param[out] not_instr Считанная инструкция "not"
-\return Позиция токена, следующего за инструкцией
 \throw SyntaxError В случае, если инструкция записана синтаксически неправильно
 */
-int MnemonicTranslator::extract_not_instr(const std::vector<Token>& tokens, int pos, std::shared_ptr<Instr>& not_instr) const {
-	int i = pos;
-
+void MnemonicTranslator::extract_not_instr(TokenCursor& cursor, std::shared_ptr<Instr>& not_instr) const {
 	// Проверяем, что первый токен в строке это "not"
-	i = check_command(tokens, i, TOKEN_TYPE::NOT, "not");
+	check_command(cursor, TOKEN_TYPE::NOT, "not");
 
 	// Выделяем единственный аргумент команды - регистр
 	REGISTER dest;
-	i = extract_register(tokens, i, dest);
+	extract_register(cursor, dest);
 
 	not_instr = std::make_shared<NotInstr>(dest);
-
-	return i;
 }
 
 /*!
 Извлекает инструкцию "shr" с заданной позиции
-\param[in] tokens Токены
-\param[in] pos Заданная позиция
+\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
 \param[out] shr_instr Считанная инструкция "shr"
-\return Позиция токена, следующего за инструкцией
 \throw SyntaxError В случае, если инструкция записана синтаксически неправильно
 */
-int MnemonicTranslator::extract_shr_instr(const std::vector<Token>& tokens, int pos, std::shared_ptr<Instr>& shr_instr) const {
-	int i = pos;
-
+void MnemonicTranslator::extract_shr_instr(TokenCursor& cursor, std::shared_ptr<Instr>& shr_instr) const {
 	// Проверяем, что первый токен в строке это "shr"
-	i = check_command(tokens, i, TOKEN_TYPE::SHR, "shr");
+	check_command(cursor, TOKEN_TYPE::SHR, "shr");
 
 	// Выделяем первый аргумент команды - регистр
 	REGISTER dest;
-	i = extract_register(tokens, i, dest);
+	extract_register(cursor, dest);
 
 	// Пропускаем запятую после первого аргумента
-	i = check_comma(tokens, i);
+	check_comma(cursor);
 
 	// Проверяем, что после запятой идёт регистр или число
-	if (i == tokens.size()) {
+	if (cursor.at_end()) {
 		throw SyntaxError("Ожидалось число или регистр");
 	}
-	else if (!is_register_token(tokens[i].type)
-		&& tokens[i].type != TOKEN_TYPE::MINUS
-		&& tokens[i].type != TOKEN_TYPE::PLUS
-		&& !is_number_token(tokens[i].type)) {
-		throw SyntaxError("Ожидалось число или регистр, получено \"" + tokens[i].text + "\"");
+	else if (!is_register_token(cursor.peek().type)
+		&& cursor.peek().type != TOKEN_TYPE::MINUS
+		&& cursor.peek().type != TOKEN_TYPE::PLUS
+		&& !is_number_token(cursor.peek().type)) {
+		throw SyntaxError("Ожидалось число или регистр, получено \"" + std::string(cursor.peek().text) + "\"");
 	}
 
 	// Выделяем второй аргумент - число или регистр
-	if (is_register_token(tokens[i].type)) {
+	if (is_register_token(cursor.peek().type)) {
 		REGISTER src;
-		i = extract_register(tokens, i, src);
+		extract_register(cursor, src);
 		shr_instr = std::make_shared<ShrRegInstr>(dest, src);
 	}
 	else {
 		int imm_value;
-		i = extract_number(tokens, i, imm_value);
+		extract_number(cursor, imm_value);
 		shr_instr = std::make_shared<ShrImmInstr>(dest, imm_value);
 	}
-
-	return i;
 }
 
 /*!
 Извлекает инструкцию "shl" с заданной позиции
-\param[in] tokens Токены
-\param[in] pos Заданная позиция
+\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
 \param[out] shl_instr Считанная инструкция "shl"
-\return Позиция токена, следующего за инструкцией
 \throw SyntaxError В случае, если инструкция записана синтаксически неправильно
 */
-int MnemonicTranslator::extract_shl_instr(const std::vector<Token>& tokens, int pos, std::shared_ptr<Instr>& shl_instr) const {
-	int i = pos;
-
+void MnemonicTranslator::extract_shl_instr(TokenCursor& cursor, std::shared_ptr<Instr>& shl_instr) const {
 	// Проверяем, что первый токен в строке это "shr"
-	i = check_command(tokens, i, TOKEN_TYPE::SHL, "shl");
+	check_command(cursor, TOKEN_TYPE::SHL, "shl");
 
 	// Выделяем первый аргумент команды - регистр
 	REGISTER dest;
-	i = extract_register(tokens, i, dest);
+	extract_register(cursor, dest);
 
 	// Пропускаем запятую после первого аргумента
-	i = check_comma(tokens, i);
+	check_comma(cursor);
 
 	// Проверяем, что после запятой идёт регистр или число
-	if (i == tokens.size()) {
+	if (cursor.at_end()) {
 		throw SyntaxError("Ожидалось число или регистр");
 	}
-	else if (!is_register_token(tokens[i].type)
-		&& tokens[i].type != TOKEN_TYPE::MINUS
-		&& tokens[i].type != TOKEN_TYPE::PLUS
-		&& !is_number_token(tokens[i].type)) {
-		throw SyntaxError("Ожидалось число или регистр, получено \"" + tokens[i].text + "\"");
+	else if (!is_register_token(cursor.peek().type)
+		&& cursor.peek().type != TOKEN_TYPE::MINUS
+		&& cursor.peek().type != TOKEN_TYPE::PLUS
+		&& !is_number_token(cursor.peek().type)) {
+		throw SyntaxError("Ожидалось число или регистр, получено \"" + std::string(cursor.peek().text) + "\"");
 	}
 
 	// Выделяем второй аргумент - число или регистр
-	if (is_register_token(tokens[i].type)) {
+	if (is_register_token(cursor.peek().type)) {
 		REGISTER src;
-		i = extract_register(tokens, i, src);
+		extract_register(cursor, src);
 		shl_instr = std::make_shared<ShlRegInstr>(dest, src);
 	}
 	else {
 		int imm_value;
-		i = extract_number(tokens, i, imm_value);
+		extract_number(cursor, imm_value);
 		shl_instr = std::make_shared<ShlImmInstr>(dest, imm_value);
 	}
+}
+
+/*!
+Извлекает инструкцию "mul" с заданной позиции
+\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
+\param[out] mul_instr Считанная инструкция "mul"
+\throw SyntaxError В случае, если инструкция записана синтаксически неправильно
+*/
+void MnemonicTranslator::extract_mul_instr(TokenCursor& cursor, std::shared_ptr<Instr>& mul_instr) const {
+	// Проверяем, что первый токен в строке это "mul"
+	check_command(cursor, TOKEN_TYPE::MUL, "mul");
+
+	// Выделяем первый аргумент команды - регистр
+	REGISTER dest;
+	extract_register(cursor, dest);
 
-	return i;
+	// Пропускаем запятую после первого аргумента
+	check_comma(cursor);
+
+	// Проверяем, что после запятой идёт регистр или число
+	if (cursor.at_end()) {
+		throw SyntaxError("Ожидалось число или регистр");
+	}
+	else if (!is_register_token(cursor.peek().type)
+		&& cursor.peek().type != TOKEN_TYPE::MINUS
+		&& cursor.peek().type != TOKEN_TYPE::PLUS
+		&& !is_number_token(cursor.peek().type)) {
+		throw SyntaxError("Ожидалось число или регистр, получено \"" + std::string(cursor.peek().text) + "\"");
+	}
+
+	// Выделяем второй аргумент - число или регистр
+	if (is_register_token(cursor.peek().type)) {
+		REGISTER src;
+		extract_register(cursor, src);
+		mul_instr = std::make_shared<MulRegInstr>(dest, src);
+	}
+	else {
+		int imm_value;
+		extract_number(cursor, imm_value);
+		mul_instr = std::make_shared<MulImmInstr>(dest, imm_value);
+	}
+}
+
+/*!
+Извлекает инструкцию "div" с заданной позиции
+\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
+\param[out] div_instr Считанная инструкция "div"
+\throw SyntaxError В случае, если инструкция записана синтаксически неправильно
+*/
+void MnemonicTranslator::extract_div_instr(TokenCursor& cursor, std::shared_ptr<Instr>& div_instr) const {
+	// Проверяем, что первый токен в строке это "div"
+	check_command(cursor, TOKEN_TYPE::DIV, "div");
+
+	// Выделяем первый аргумент команды - регистр
+	REGISTER dest;
+	extract_register(cursor, dest);
+
+	// Пропускаем запятую после первого аргумента
+	check_comma(cursor);
+
+	// Проверяем, что после запятой идёт регистр или число
+	if (cursor.at_end()) {
+		throw SyntaxError("Ожидалось число или регистр");
+	}
+	else if (!is_register_token(cursor.peek().type)
+		&& cursor.peek().type != TOKEN_TYPE::MINUS
+		&& cursor.peek().type != TOKEN_TYPE::PLUS
+		&& !is_number_token(cursor.peek().type)) {
+		throw SyntaxError("Ожидалось число или регистр, получено \"" + std::string(cursor.peek().text) + "\"");
+	}
+
+	// Выделяем второй аргумент - число или регистр
+	if (is_register_token(cursor.peek().type)) {
+		REGISTER src;
+		extract_register(cursor, src);
+		div_instr = std::make_shared<DivRegInstr>(dest, src);
+	}
+	else {
+		int imm_value;
+		extract_number(cursor, imm_value);
+		div_instr = std::make_shared<DivImmInstr>(dest, imm_value);
+	}
+}
+
+/*!
+Извлекает инструкцию "mod" с заданной позиции
+\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
+\param[out] mod_instr Считанная инструкция "mod"
+\throw SyntaxError В случае, если инструкция записана синтаксически неправильно
+*/
+void MnemonicTranslator::extract_mod_instr(TokenCursor& cursor, std::shared_ptr<Instr>& mod_instr) const {
+	// Проверяем, что первый токен в строке это "mod"
+	check_command(cursor, TOKEN_TYPE::MOD, "mod");
+
+	// Выделяем первый аргумент команды - регистр
+	REGISTER dest;
+	extract_register(cursor, dest);
+
+	// Пропускаем запятую после первого аргумента
+	check_comma(cursor);
+
+	// Проверяем, что после запятой идёт регистр или число
+	if (cursor.at_end()) {
+		throw SyntaxError("Ожидалось число или регистр");
+	}
+	else if (!is_register_token(cursor.peek().type)
+		&& cursor.peek().type != TOKEN_TYPE::MINUS
+		&& cursor.peek().type != TOKEN_TYPE::PLUS
+		&& !is_number_token(cursor.peek().type)) {
+		throw SyntaxError("Ожидалось число или регистр, получено \"" + std::string(cursor.peek().text) + "\"");
+	}
+
+	// Выделяем второй аргумент - число или регистр
+	if (is_register_token(cursor.peek().type)) {
+		REGISTER src;
+		extract_register(cursor, src);
+		mod_instr = std::make_shared<ModRegInstr>(dest, src);
+	}
+	else {
+		int imm_value;
+		extract_number(cursor, imm_value);
+		mod_instr = std::make_shared<ModImmInstr>(dest, imm_value);
+	}
 }
 
 /*!
 Извлекает инструкцию "set" с заданной позиции
-\param[in] tokens Токены
-\param[in] pos Заданная позиция
+\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
 \param[out] set_instr Считанная инструкция "set"
-\return Позиция токена, следующего за инструкцией
 \throw SyntaxError В случае, если инструкция записана синтаксически неправильно
 */
-int MnemonicTranslator::extract_set_instr(const std::vector<Token>& tokens, int pos, std::shared_ptr<Instr>& set_instr) const {
-	int i = pos;
-
+void MnemonicTranslator::extract_set_instr(TokenCursor& cursor, std::shared_ptr<Instr>& set_instr) const {
 	// Проверяем, что первый токен в строке это "set"
-	i = check_command(tokens, i, TOKEN_TYPE::SET, "set");
+	check_command(cursor, TOKEN_TYPE::SET, "set");
 
 	// Выделяем первый аргумент команды - регистр
 	REGISTER dest;
-	i = extract_register(tokens, i, dest);
+	extract_register(cursor, dest);
 
 	// Пропускаем запятую после первого аргумента
-	i = check_comma(tokens, i);
+	check_comma(cursor);
 
 	// Проверяем, что после запятой идёт регистр или имя переменной
-	if (i == tokens.size()) {
+	if (cursor.at_end()) {
 		throw SyntaxError("Ожидался регистр или имя переменной");
 	}
-	else if (!is_register_token(tokens[i].type) && tokens[i].type != TOKEN_TYPE::NAME && !is_number_token(tokens[i].type)) {
-		throw SyntaxError("Ожидался регистр или имя переменной, получено \"" + tokens[i].text + "\"");
+	else if (!is_register_token(cursor.peek().type) && cursor.peek().type != TOKEN_TYPE::NAME && !is_number_token(cursor.peek().type)) {
+		throw SyntaxError("Ожидался регистр или имя переменной, получено \"" + std::string(cursor.peek().text) + "\"");
 	}
 
 	// Выделяем второй аргумент - регистр, имя переменной или число
-	if (is_register_token(tokens[i].type)) {
+	if (is_register_token(cursor.peek().type)) {
 		REGISTER src;
-		i = extract_register(tokens, i, src);
+		extract_register(cursor, src);
 		set_instr = std::make_shared<SetRegInstr>(dest, src);
 	}
-	else if (tokens[i].type == TOKEN_TYPE::NAME) {
+	else if (cursor.peek().type == TOKEN_TYPE::NAME) {
 		std::string var_name;
-		i = extract_name(tokens, i, var_name);
+		extract_name(cursor, var_name);
 		set_instr = std::make_shared<SetNameInstr>(dest, var_name);
 	}
 	else {
 		int imm_value;
-		i = extract_number(tokens, i, imm_value);
+		extract_number(cursor, imm_value);
 		set_instr = std::make_shared<SetImmInstr>(dest, imm_value);
 	}
-
-	return i;
 }
 
 /*!
 Извлекает инструкцию "ld" с заданной позиции
-\param[in] tokens Токены
-\param[in] pos Заданная позиция
+\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
 \param[out] ld_instr Считанная инструкция "ld"
-\return Позиция токена, следующего за инструкцией
 \throw SyntaxError В случае, если инструкция записана синтаксически неправильно
 */
-int MnemonicTranslator::extract_ld_instr(const std::vector<Token>& tokens, int pos, std::shared_ptr<Instr>& ld_instr) const {
-	int i = pos;
-
+void MnemonicTranslator::extract_ld_instr(TokenCursor& cursor, std::shared_ptr<Instr>& ld_instr) const {
 	// Проверяем, что первый токен в строке это "ld"
-	i = check_command(tokens, i, TOKEN_TYPE::LD, "ld");
+	check_command(cursor, TOKEN_TYPE::LD, "ld");
 
 	// Выделяем первый аргумент команды - регистр
 	REGISTER dest;
-	i = extract_register(tokens, i, dest);
+	extract_register(cursor, dest);
 
 	// Пропускаем запятую после первого аргумента
-	i = check_comma(tokens, i);
+	check_comma(cursor);
 
 	// Выделяем второй аргумент команды - имя переменной
 	std::string var_name;
-	i = extract_name(tokens, i, var_name);
+	extract_name(cursor, var_name);
 
 	ld_instr = std::make_shared<LdInstr>(dest, var_name);
-
-	return i;
 }
 
 /*!
 Извлекает инструкцию "st" с заданной позиции
-\param[in] tokens Токены
-\param[in] pos Заданная позиция
+\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
 \param[out] st_instr Считанная инструкция "st"
-\return Позиция токена, следующего за инструкцией
 \throw SyntaxError В случае, если инструкция записана синтаксически неправильно
 */
-int MnemonicTranslator::extract_st_instr(const std::vector<Token>& tokens, int pos, std::shared_ptr<Instr>& st_instr) const {
-	int i = pos;
-
+void MnemonicTranslator::extract_st_instr(TokenCursor& cursor, std::shared_ptr<Instr>& st_instr) const {
 	// Проверяем, что первый токен в строке это "st"
-	i = check_command(tokens, i, TOKEN_TYPE::ST, "st");
+	check_command(cursor, TOKEN_TYPE::ST, "st");
 
 	// Выделяем первый аргумент команды - имя переменной
 	std::string var_name;
-	i = extract_name(tokens, i, var_name);
+	extract_name(cursor, var_name);
 
 	// Пропускаем запятую после первого аргумента
-	i = check_comma(tokens, i);
+	check_comma(cursor);
 
 	// Выделяем второй аргумент команды - регистр
 	REGISTER dest;
-	i = extract_register(tokens, i, dest);
+	extract_register(cursor, dest);
 
 	st_instr = std::make_shared<StInstr>(var_name, dest);
-
-	return i;
 }
 
 /*!
 Извлекает инструкцию "ldi" с заданной позиции
-\param[in] tokens Токены
-\param[in] pos Заданная позиция
+\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
 \param[out] ldi_instr Считанная инструкция "ldi"
-\return Позиция токена, следующего за инструкцией
 \throw SyntaxError В случае, если инструкция записана синтаксически неправильно
 */
-int MnemonicTranslator::extract_ldi_instr(const std::vector<Token>& tokens, int pos, std::shared_ptr<Instr>& ldi_instr) const {
-	int i = pos;
-
+void MnemonicTranslator::extract_ldi_instr(TokenCursor& cursor, std::shared_ptr<Instr>& ldi_instr) const {
 	// Проверяем, что первый токен в строке это "ldi"
-	i = check_command(tokens, i, TOKEN_TYPE::LDI, "ldi");
+	check_command(cursor, TOKEN_TYPE::LDI, "ldi");
 
 	// Выделяем первый аргумент команды - регистр
 	REGISTER dest;
-	i = extract_register(tokens, i, dest);
+	extract_register(cursor, dest);
 
 	// Пропускаем запятую после первого аргумента
-	i = check_comma(tokens, i);
+	check_comma(cursor);
 
-	// Выделяем второй аргумент команды - регистр
+	// Выделяем второй аргумент команды - регистр с базовым адресом
 	REGISTER src;
-	i = extract_register(tokens, i, src);
+	extract_register(cursor, src);
+
+	// Без третьего аргумента адрес берется из регистра без смещения
+	if (cursor.at_end() || cursor.peek().type != TOKEN_TYPE::COMMA) {
+		ldi_instr = std::make_shared<LdiInstr>(dest, src);
+		return;
+	}
 
-	ldi_instr = std::make_shared<LdiInstr>(dest, src);
+	// Пропускаем запятую после второго аргумента
+	check_comma(cursor);
 
-	return i;
+	// Проверяем, что после запятой идёт регистр или число
+	if (cursor.at_end()) {
+		throw SyntaxError("Ожидалось число или регистр");
+	}
+	else if (!is_register_token(cursor.peek().type)
+		&& cursor.peek().type != TOKEN_TYPE::MINUS
+		&& cursor.peek().type != TOKEN_TYPE::PLUS
+		&& !is_number_token(cursor.peek().type)) {
+		throw SyntaxError("Ожидалось число или регистр, получено \"" + std::string(cursor.peek().text) + "\"");
+	}
+
+	// Выделяем третий аргумент - смещение в виде числа или регистра
+	if (is_register_token(cursor.peek().type)) {
+		REGISTER index;
+		extract_register(cursor, index);
+		ldi_instr = std::make_shared<LdiIndexInstr>(dest, src, index);
+	}
+	else {
+		int offset;
+		extract_number(cursor, offset);
+		ldi_instr = std::make_shared<LdiOffsetInstr>(dest, src, offset);
+	}
 }
 
 /*!
 Извлекает инструкцию "sti" с заданной позиции
-\param[in] tokens Токены
-\param[in] pos Заданная позиция
+\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
 \param[out] sti_instr Считанная инструкция "sti"
-\return Позиция токена, следующего за инструкцией
 \throw SyntaxError В случае, если инструкция записана синтаксически неправильно
 */
-int MnemonicTranslator::extract_sti_instr(const std::vector<Token>& tokens, int pos, std::shared_ptr<Instr>& sti_instr) const {
-	int i = pos;
-
-	// Проверяем, что первый токен в строке это "ldi"
-	i = check_command(tokens, i, TOKEN_TYPE::STI, "sti");
+void MnemonicTranslator::extract_sti_instr(TokenCursor& cursor, std::shared_ptr<Instr>& sti_instr) const {
+	// Проверяем, что первый токен в строке это "sti"
+	check_command(cursor, TOKEN_TYPE::STI, "sti");
 
-	// Выделяем первый аргумент команды - регистр
+	// Выделяем первый аргумент команды - регистр с базовым адресом
 	REGISTER dest;
-	i = extract_register(tokens, i, dest);
+	extract_register(cursor, dest);
 
 	// Пропускаем запятую после первого аргумента
-	i = check_comma(tokens, i);
+	check_comma(cursor);
 
-	// Выделяем второй аргумент команды - регистр
+	// Проверяем, что после запятой идёт регистр или число
+	if (cursor.at_end()) {
+		throw SyntaxError("Ожидалось число или регистр");
+	}
+	else if (!is_register_token(cursor.peek().type)
+		&& cursor.peek().type != TOKEN_TYPE::MINUS
+		&& cursor.peek().type != TOKEN_TYPE::PLUS
+		&& !is_number_token(cursor.peek().type)) {
+		throw SyntaxError("Ожидалось число или регистр, получено \"" + std::string(cursor.peek().text) + "\"");
+	}
+
+	// Смещение в виде числа всегда записывается перед регистром источником
+	if (!is_register_token(cursor.peek().type)) {
+		int offset;
+		extract_number(cursor, offset);
+
+		check_comma(cursor);
+
+		REGISTER src;
+		extract_register(cursor, src);
+
+		sti_instr = std::make_shared<StiOffsetInstr>(dest, offset, src);
+		return;
+	}
+
+	// Выделяем второй аргумент команды - регистр. Если за ним следует
+	// третий аргумент, то второй является смещением, а третий - источником
 	REGISTER src;
-	i = extract_register(tokens, i, src);
+	extract_register(cursor, src);
 
-	sti_instr = std::make_shared<StiInstr>(dest, src);
+	if (cursor.at_end() || cursor.peek().type != TOKEN_TYPE::COMMA) {
+		sti_instr = std::make_shared<StiInstr>(dest, src);
+		return;
+	}
+
+	check_comma(cursor);
+
+	REGISTER index = src;
+	extract_register(cursor, src);
+
+	sti_instr = std::make_shared<StiIndexInstr>(dest, index, src);
+}
+
+/*!
+Извлекает инструкцию "push" с заданной позиции
+\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
+\param[out] push_instr Считанная инструкция "push"
+\throw SyntaxError В случае, если инструкция записана синтаксически неправильно
+*/
+void MnemonicTranslator::extract_push_instr(TokenCursor& cursor, std::shared_ptr<Instr>& push_instr) const {
+	// Проверяем, что первый токен в строке это "push"
+	check_command(cursor, TOKEN_TYPE::PUSH, "push");
+
+	// Выделяем единственный аргумент команды - регистр
+	REGISTER src;
+	extract_register(cursor, src);
 
-	return i;
+	push_instr = std::make_shared<PushInstr>(src);
+}
+
+/*!
+Извлекает инструкцию "pop" с заданной позиции
+\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
+\param[out] pop_instr Считанная инструкция "pop"
+\throw SyntaxError В случае, если инструкция записана синтаксически неправильно
+*/
+void MnemonicTranslator::extract_pop_instr(TokenCursor& cursor, std::shared_ptr<Instr>& pop_instr) const {
+	// Проверяем, что первый токен в строке это "pop"
+	check_command(cursor, TOKEN_TYPE::POP, "pop");
+
+	// Выделяем единственный аргумент команды - регистр
+	REGISTER dest;
+	extract_register(cursor, dest);
+
+	pop_instr = std::make_shared<PopInstr>(dest);
 }
 
 /*!
 Извлекает инструкцию "jmp" с заданной позиции
-\param[in] tokens Токены
-\param[in] pos Заданная позиция
+\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
 \param[out] jmp_instr Считанная инструкция "jmp"
-\return Позиция токена, следующего за инструкцией
 \throw SyntaxError В случае, если инструкция записана синтаксически неправильно
 */
-int MnemonicTranslator::extract_jmp_instr(const std::vector<Token>& tokens, int pos, std::shared_ptr<Instr>& jmp_instr) const {
-	int i = pos;
-
+void MnemonicTranslator::extract_jmp_instr(TokenCursor& cursor, std::shared_ptr<Instr>& jmp_instr) const {
 	// Проверяем, что первый токен в строке это "jmp"
-	i = check_command(tokens, i, TOKEN_TYPE::JMP, "jmp");
+	check_command(cursor, TOKEN_TYPE::JMP, "jmp");
 
 	// Выделяем единственный аргумент команды - имя метки
 	std::string label_name;
-	i = extract_name(tokens, i, label_name);
+	extract_name(cursor, label_name);
 
 	jmp_instr = std::make_shared<JmpInstr>(label_name);
-
-	return i;
 }
 
 /*!
 Извлекает инструкцию "jeq" с заданной позиции
-\param[in] tokens Токены
-\param[in] pos Заданная позиция
+\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
 \param[out] jeq_instr Считанная инструкция "jeq"
-\return Позиция токена, следующего за инструкцией
 \throw SyntaxError В случае, если инструкция записана синтаксически неправильно
 */
-int MnemonicTranslator::extract_jeq_instr(const std::vector<Token>& tokens, int pos, std::shared_ptr<Instr>& jeq_instr) const {
-	int i = pos;
-
+void MnemonicTranslator::extract_jeq_instr(TokenCursor& cursor, std::shared_ptr<Instr>& jeq_instr) const {
 	// Проверяем, что первый токен в строке это "jeq"
-	i = check_command(tokens, i, TOKEN_TYPE::JEQ, "jeq");
+	check_command(cursor, TOKEN_TYPE::JEQ, "jeq");
 
 	// Выделяем первый аргумент команды - имя метки
 	std::string label_name;
-	i = extract_name(tokens, i, label_name);
+	extract_name(cursor, label_name);
 
 	// Пропускаем запятую после первого аргумента
-	i = check_comma(tokens, i);
+	check_comma(cursor);
 
 	// Выделяем второй аргумент команды - регистр
 	REGISTER reg1;
-	i = extract_register(tokens, i, reg1);
+	extract_register(cursor, reg1);
 
 	// Пропускаем запятую после второго аргумента
-	i = check_comma(tokens, i);
+	check_comma(cursor);
 
-	// Выделяем третий аргумент команды - регистр
-	REGISTER reg2;
-	i = extract_register(tokens, i, reg2);
+	// Проверяем, что после запятой идёт регистр или число
+	if (cursor.at_end()) {
+		throw SyntaxError("Ожидалось число или регистр");
+	}
+	else if (!is_register_token(cursor.peek().type)
+		&& cursor.peek().type != TOKEN_TYPE::MINUS
+		&& cursor.peek().type != TOKEN_TYPE::PLUS
+		&& !is_number_token(cursor.peek().type)) {
+		throw SyntaxError("Ожидалось число или регистр, получено \"" + std::string(cursor.peek().text) + "\"");
+	}
 
-	jeq_instr = std::make_shared<JeqInstr>(label_name, reg1, reg2);
+	// Выделяем третий аргумент команды - регистр или число
+	if (is_register_token(cursor.peek().type)) {
+		REGISTER reg2;
+		extract_register(cursor, reg2);
+		jeq_instr = std::make_shared<JeqInstr>(label_name, reg1, reg2);
+	}
+	else {
+		int imm_value;
+		extract_number(cursor, imm_value);
+		jeq_instr = std::make_shared<JeqImmInstr>(label_name, reg1, imm_value);
+	}
+}
 
-	return i;
+/*!
+Извлекает инструкцию "jne" с заданной позиции
+\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
+\param[out] jne_instr Считанная инструкция "jne"
+\throw SyntaxError В случае, если инструкция записана синтаксически неправильно
+*/
+void MnemonicTranslator::extract_jne_instr(TokenCursor& cursor, std::shared_ptr<Instr>& jne_instr) const {
+	// Проверяем, что первый токен в строке это "jne"
+	check_command(cursor, TOKEN_TYPE::JNE, "jne");
+
+	// Выделяем первый аргумент команды - имя метки
+	std::string label_name;
+	extract_name(cursor, label_name);
+
+	// Пропускаем запятую после первого аргумента
+	check_comma(cursor);
+
+	// Выделяем второй аргумент команды - регистр
+	REGISTER reg1;
+	extract_register(cursor, reg1);
+
+	// Пропускаем запятую после второго аргумента
+	check_comma(cursor);
+
+	// Проверяем, что после запятой идёт регистр или число
+	if (cursor.at_end()) {
+		throw SyntaxError("Ожидалось число или регистр");
+	}
+	else if (!is_register_token(cursor.peek().type)
+		&& cursor.peek().type != TOKEN_TYPE::MINUS
+		&& cursor.peek().type != TOKEN_TYPE::PLUS
+		&& !is_number_token(cursor.peek().type)) {
+		throw SyntaxError("Ожидалось число или регистр, получено \"" + std::string(cursor.peek().text) + "\"");
+	}
+
+	// Выделяем третий аргумент команды - регистр или число
+	if (is_register_token(cursor.peek().type)) {
+		REGISTER reg2;
+		extract_register(cursor, reg2);
+		jne_instr = std::make_shared<JneInstr>(label_name, reg1, reg2);
+	}
+	else {
+		int imm_value;
+		extract_number(cursor, imm_value);
+		jne_instr = std::make_shared<JneImmInstr>(label_name, reg1, imm_value);
+	}
 }
 
 /*!
 Извлекает инструкцию "jgt" с заданной позиции
-\param[in] tokens Токены
-\param[in] pos Заданная позиция
+\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
 \param[out] jgt_instr Считанная инструкция "jgt"
-\return Позиция токена, следующего за инструкцией
 \throw SyntaxError В случае, если инструкция записана синтаксически неправильно
 */
-int MnemonicTranslator::extract_jgt_instr(const std::vector<Token>& tokens, int pos, std::shared_ptr<Instr>& jgt_instr) const {
-	int i = pos;
-
+void MnemonicTranslator::extract_jgt_instr(TokenCursor& cursor, std::shared_ptr<Instr>& jgt_instr) const {
 	// Проверяем, что первый токен в строке это "jgt"
-	i = check_command(tokens, i, TOKEN_TYPE::JGT, "jgt");
+	check_command(cursor, TOKEN_TYPE::JGT, "jgt");
 
 	// Выделяем первый аргумент команды - имя метки
 	std::string label_name;
-	i = extract_name(tokens, i, label_name);
+	extract_name(cursor, label_name);
 
 	// Пропускаем запятую после первого аргумента
-	i = check_comma(tokens, i);
+	check_comma(cursor);
 
 	// Выделяем второй аргумент команды - регистр
 	REGISTER reg1;
-	i = extract_register(tokens, i, reg1);
+	extract_register(cursor, reg1);
 
 	// Пропускаем запятую после второго аргумента
-	i = check_comma(tokens, i);
+	check_comma(cursor);
 
-	// Выделяем третий аргумент команды - регистр
-	REGISTER reg2;
-	i = extract_register(tokens, i, reg2);
+	// Проверяем, что после запятой идёт регистр или число
+	if (cursor.at_end()) {
+		throw SyntaxError("Ожидалось число или регистр");
+	}
+	else if (!is_register_token(cursor.peek().type)
+		&& cursor.peek().type != TOKEN_TYPE::MINUS
+		&& cursor.peek().type != TOKEN_TYPE::PLUS
+		&& !is_number_token(cursor.peek().type)) {
+		throw SyntaxError("Ожидалось число или регистр, получено \"" + std::string(cursor.peek().text) + "\"");
+	}
+
+	// Выделяем третий аргумент команды - регистр или число
+	if (is_register_token(cursor.peek().type)) {
+		REGISTER reg2;
+		extract_register(cursor, reg2);
+		jgt_instr = std::make_shared<JgtInstr>(label_name, reg1, reg2);
+	}
+	else {
+		int imm_value;
+		extract_number(cursor, imm_value);
+		jgt_instr = std::make_shared<JgtImmInstr>(label_name, reg1, imm_value);
+	}
+}
+
+/*!
+Извлекает инструкцию "jlt" с заданной позиции
+\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
+\param[out] jlt_instr Считанная инструкция "jlt"
+\throw SyntaxError В случае, если инструкция записана синтаксически неправильно
+*/
+void MnemonicTranslator::extract_jlt_instr(TokenCursor& cursor, std::shared_ptr<Instr>& jlt_instr) const {
+	// Проверяем, что первый токен в строке это "jlt"
+	check_command(cursor, TOKEN_TYPE::JLT, "jlt");
+
+	// Выделяем первый аргумент команды - имя метки
+	std::string label_name;
+	extract_name(cursor, label_name);
+
+	// Пропускаем запятую после первого аргумента
+	check_comma(cursor);
+
+	// Выделяем второй аргумент команды - регистр
+	REGISTER reg1;
+	extract_register(cursor, reg1);
+
+	// Пропускаем запятую после второго аргумента
+	check_comma(cursor);
 
-	jgt_instr = std::make_shared<JgtInstr>(label_name, reg1, reg2);
+	// Проверяем, что после запятой идёт регистр или число
+	if (cursor.at_end()) {
+		throw SyntaxError("Ожидалось число или регистр");
+	}
+	else if (!is_register_token(cursor.peek().type)
+		&& cursor.peek().type != TOKEN_TYPE::MINUS
+		&& cursor.peek().type != TOKEN_TYPE::PLUS
+		&& !is_number_token(cursor.peek().type)) {
+		throw SyntaxError("Ожидалось число или регистр, получено \"" + std::string(cursor.peek().text) + "\"");
+	}
 
-	return i;
+	// Выделяем третий аргумент команды - регистр или число
+	if (is_register_token(cursor.peek().type)) {
+		REGISTER reg2;
+		extract_register(cursor, reg2);
+		jlt_instr = std::make_shared<JltInstr>(label_name, reg1, reg2);
+	}
+	else {
+		int imm_value;
+		extract_number(cursor, imm_value);
+		jlt_instr = std::make_shared<JltImmInstr>(label_name, reg1, imm_value);
+	}
+}
+
+/*!
+Извлекает инструкцию "jge" с заданной позиции
+\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
+\param[out] jge_instr Считанная инструкция "jge"
+\throw SyntaxError В случае, если инструкция записана синтаксически неправильно
+*/
+void MnemonicTranslator::extract_jge_instr(TokenCursor& cursor, std::shared_ptr<Instr>& jge_instr) const {
+	// Проверяем, что первый токен в строке это "jge"
+	check_command(cursor, TOKEN_TYPE::JGE, "jge");
+
+	// Выделяем первый аргумент команды - имя метки
+	std::string label_name;
+	extract_name(cursor, label_name);
+
+	// Пропускаем запятую после первого аргумента
+	check_comma(cursor);
+
+	// Выделяем второй аргумент команды - регистр
+	REGISTER reg1;
+	extract_register(cursor, reg1);
+
+	// Пропускаем запятую после второго аргумента
+	check_comma(cursor);
+
+	// Проверяем, что после запятой идёт регистр или число
+	if (cursor.at_end()) {
+		throw SyntaxError("Ожидалось число или регистр");
+	}
+	else if (!is_register_token(cursor.peek().type)
+		&& cursor.peek().type != TOKEN_TYPE::MINUS
+		&& cursor.peek().type != TOKEN_TYPE::PLUS
+		&& !is_number_token(cursor.peek().type)) {
+		throw SyntaxError("Ожидалось число или регистр, получено \"" + std::string(cursor.peek().text) + "\"");
+	}
+
+	// Выделяем третий аргумент команды - регистр или число
+	if (is_register_token(cursor.peek().type)) {
+		REGISTER reg2;
+		extract_register(cursor, reg2);
+		jge_instr = std::make_shared<JgeInstr>(label_name, reg1, reg2);
+	}
+	else {
+		int imm_value;
+		extract_number(cursor, imm_value);
+		jge_instr = std::make_shared<JgeImmInstr>(label_name, reg1, imm_value);
+	}
+}
+
+/*!
+Извлекает инструкцию "jle" с заданной позиции
+\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
+\param[out] jle_instr Считанная инструкция "jle"
+\throw SyntaxError В случае, если инструкция записана синтаксически неправильно
+*/
+void MnemonicTranslator::extract_jle_instr(TokenCursor& cursor, std::shared_ptr<Instr>& jle_instr) const {
+	// Проверяем, что первый токен в строке это "jle"
+	check_command(cursor, TOKEN_TYPE::JLE, "jle");
+
+	// Выделяем первый аргумент команды - имя метки
+	std::string label_name;
+	extract_name(cursor, label_name);
+
+	// Пропускаем запятую после первого аргумента
+	check_comma(cursor);
+
+	// Выделяем второй аргумент команды - регистр
+	REGISTER reg1;
+	extract_register(cursor, reg1);
+
+	// Пропускаем запятую после второго аргумента
+	check_comma(cursor);
+
+	// Проверяем, что после запятой идёт регистр или число
+	if (cursor.at_end()) {
+		throw SyntaxError("Ожидалось число или регистр");
+	}
+	else if (!is_register_token(cursor.peek().type)
+		&& cursor.peek().type != TOKEN_TYPE::MINUS
+		&& cursor.peek().type != TOKEN_TYPE::PLUS
+		&& !is_number_token(cursor.peek().type)) {
+		throw SyntaxError("Ожидалось число или регистр, получено \"" + std::string(cursor.peek().text) + "\"");
+	}
+
+	// Выделяем третий аргумент команды - регистр или число
+	if (is_register_token(cursor.peek().type)) {
+		REGISTER reg2;
+		extract_register(cursor, reg2);
+		jle_instr = std::make_shared<JleInstr>(label_name, reg1, reg2);
+	}
+	else {
+		int imm_value;
+		extract_number(cursor, imm_value);
+		jle_instr = std::make_shared<JleImmInstr>(label_name, reg1, imm_value);
+	}
 }
 
 /*!
 Извлекает инструкцию "call" с заданной позиции
-\param[in] tokens Токены
-\param[in] pos Заданная позиция
+\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
 \param[out] call_instr Считанная инструкция "call"
-\return Позиция токена, следующего за инструкцией
 \throw SyntaxError В случае, если инструкция записана синтаксически неправильно
 */
-int MnemonicTranslator::extract_call_instr(const std::vector<Token>& tokens, int pos, std::shared_ptr<Instr>& call_instr) const {
-	int i = pos;
-
+void MnemonicTranslator::extract_call_instr(TokenCursor& cursor, std::shared_ptr<Instr>& call_instr) const {
 	// Проверяем, что первый токен в строке это "call"
-	i = check_command(tokens, i, TOKEN_TYPE::CALL, "call");
+	check_command(cursor, TOKEN_TYPE::CALL, "call");
 
 	// Выделяем единственный аргумент команды - имя подпрограммы
 	std::string subroutine_name;
-	i = extract_name(tokens, i, subroutine_name);
+	extract_name(cursor, subroutine_name);
 
 	call_instr = std::make_shared<CallInstr>(subroutine_name);
-
-	return i;
 }
 
 /*!
 Извлекает инструкцию "ret" с заданной позиции
-\param[in] tokens Токены
-\param[in] pos Заданная позиция
+\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
 \param[out] ret_instr Считанная инструкция "ret"
-\return Позиция токена, следующего за инструкцией
 \throw SyntaxError В случае, если инструкция записана синтаксически неправильно
 */
-int MnemonicTranslator::extract_ret_instr(const std::vector<Token>& tokens, int pos, std::shared_ptr<Instr>& ret_instr) const {
-	int i = pos;
-
+void MnemonicTranslator::extract_ret_instr(TokenCursor& cursor, std::shared_ptr<Instr>& ret_instr) const {
 	// Проверяем, что первый токен в строке это "ret"
-	i = check_command(tokens, i, TOKEN_TYPE::RET, "ret");
+	check_command(cursor, TOKEN_TYPE::RET, "ret");
 
 	ret_instr = std::make_shared<RetInstr>();
-
-	return i;
 }
 
 /*!
 Извлекает список аргументов для инструкции "data" с заданной позиции
-\param[in] tokens Токены
-\param[in] pos Заданная позиция
+\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
 \param[out] arguments Список считанных аргументов
-\return Позиция токена, следующего за список аргументов
 \throw SyntaxError В случае, если список аргументов записан неправильно
 */
-int MnemonicTranslator::extract_data_argument_list(const std::vector<Token>& tokens, int pos, std::vector<int>& arguments) const {
-	int i = pos;
-
-	if (tokens.size() == 0 || pos < 0 || pos >= tokens.size()) {
+void MnemonicTranslator::extract_data_argument_list(TokenCursor& cursor, std::vector<int>& arguments) const {
+	if (cursor.at_end()) {
 		throw SyntaxError("Ожидались данные");
 	}
 
-	while (i < tokens.size()) {
+	while (!cursor.at_end()) {
 		// Если аргумент это строка...
-		if (tokens[i].type == TOKEN_TYPE::STRING) {
-			std::string str_data = tokens[i].text;
+		if (cursor.peek().type == TOKEN_TYPE::STRING) {
+			std::string str_data(cursor.next().text);
 
 			// Заменяем unescaped управляющий последовательности
 			for (int j = 0; j < str_data.length(); j++) {
@@ -950,158 +1270,171 @@ int MnemonicTranslator::extract_data_argument_list(const std::vector<Token>& tok
 			}
 			// Добавляем нуль-терминаторный символ
 			arguments.push_back('\0');
-
-			i++;
 		}
 		// Иначе...
 		else {
 			// Пробуем извлечь число
 			int num;
-			i = extract_number(tokens, i, num);
+			extract_number(cursor, num);
 			arguments.push_back(num);
 		}
 
 		// Если токены ещё остались, то следующим токеном обяазан быть разеделитель - запятая
-		if (i < tokens.size()) {
-			i = check_comma(tokens, i);
+		if (!cursor.at_end()) {
+			check_comma(cursor);
 		}
 	}
-
-	return i;
 }
 
 /*!
 Извлекает инструкцию "data" с заданной позиции
-\param[in] tokens Токены
-\param[in] pos Заданная позиция
+\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
 \param[out] data_instr Считанная инструкция "data"
-\return Позиция токена, следующего за инструкцией
 \throw SyntaxError В случае, если инструкция записана синтаксически неправильно
 */
-int MnemonicTranslator::extract_data_instr(const std::vector<Token>& tokens, int pos, std::shared_ptr<Instr>& data_instr) const {
-	int i = pos;
-
+void MnemonicTranslator::extract_data_instr(TokenCursor& cursor, std::shared_ptr<Instr>& data_instr) const {
 	// Проверяем, что первый токен в строке это "data"
-	i = check_command(tokens, i, TOKEN_TYPE::DATA, "data");
+	check_command(cursor, TOKEN_TYPE::DATA, "data");
 
 	// Выделяем имя области памяти
 	std::string name;
-	i = extract_name(tokens, i, name);
+	extract_name(cursor, name);
 
 	// Выделяем данные из команды
 	std::vector<int> data;
-	i = extract_data_argument_list(tokens, i, data);
+	extract_data_argument_list(cursor, data);
 
 	data_instr = std::make_shared<DataInstr>(name, data);
-
-	return i;
 }
 
 /*!
 Извлекает инструкцию псевдо-ассемблера с заданной позиции
-\param[in] tokens Токены
-\param[in] pos Заданная позиция
+\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
 \param[out] instr Считанная инструкция
-\return Позиция токена, следующего за инструкцией
 \throw SyntaxError В случае, если инструкция записана синтаксически неправильно
 */
-void MnemonicTranslator::extract_instr(const std::vector<Token>& tokens, int pos, std::shared_ptr<Instr>& instr) const {
-	int i = pos;
-
-	if (tokens.size() == 0 || i < 0 || i >= tokens.size()) {
+void MnemonicTranslator::extract_instr(TokenCursor& cursor, std::shared_ptr<Instr>& instr) const {
+	if (cursor.at_end()) {
 		throw SyntaxError("Ожидалась инструкция");
 	}
 
-	switch (tokens[i].type) {
+	switch (cursor.peek().type) {
 	case TOKEN_TYPE::ADD:
-		i = extract_add_instr(tokens, i, instr);
+		extract_add_instr(cursor, instr);
 		break;
 	case TOKEN_TYPE::SUB:
-		i = extract_sub_instr(tokens, i, instr);
+		extract_sub_instr(cursor, instr);
 		break;
 	case TOKEN_TYPE::AND:
-		i = extract_and_instr(tokens, i, instr);
+		extract_and_instr(cursor, instr);
 		break;
 	case TOKEN_TYPE::OR:
-		i = extract_or_instr(tokens, i, instr);
+		extract_or_instr(cursor, instr);
 		break;
 	case TOKEN_TYPE::XOR:
-		i = extract_xor_instr(tokens, i, instr);
+		extract_xor_instr(cursor, instr);
 		break;
 	case TOKEN_TYPE::NOT:
-		i = extract_not_instr(tokens, i, instr);
+		extract_not_instr(cursor, instr);
 		break;
 	case TOKEN_TYPE::SHR:
-		i = extract_shr_instr(tokens, i, instr);
+		extract_shr_instr(cursor, instr);
 		break;
 	case TOKEN_TYPE::SHL:
-		i = extract_shl_instr(tokens, i, instr);
+		extract_shl_instr(cursor, instr);
+		break;
+	case TOKEN_TYPE::MUL:
+		extract_mul_instr(cursor, instr);
+		break;
+	case TOKEN_TYPE::DIV:
+		extract_div_instr(cursor, instr);
+		break;
+	case TOKEN_TYPE::MOD:
+		extract_mod_instr(cursor, instr);
 		break;
 	case TOKEN_TYPE::SET:
-		i = extract_set_instr(tokens, i, instr);
+		extract_set_instr(cursor, instr);
 		break;
 	case TOKEN_TYPE::LD:
-		i = extract_ld_instr(tokens, i, instr);
+		extract_ld_instr(cursor, instr);
 		break;
 	case TOKEN_TYPE::ST:
-		i = extract_st_instr(tokens, i, instr);
+		extract_st_instr(cursor, instr);
 		break;
 	case TOKEN_TYPE::LDI:
-		i = extract_ldi_instr(tokens, i, instr);
+		extract_ldi_instr(cursor, instr);
 		break;
 	case TOKEN_TYPE::STI:
-		i = extract_sti_instr(tokens, i, instr);
+		extract_sti_instr(cursor, instr);
+		break;
+	case TOKEN_TYPE::PUSH:
+		extract_push_instr(cursor, instr);
+		break;
+	case TOKEN_TYPE::POP:
+		extract_pop_instr(cursor, instr);
 		break;
 	case TOKEN_TYPE::JMP:
-		i = extract_jmp_instr(tokens, i, instr);
+		extract_jmp_instr(cursor, instr);
 		break;
 	case TOKEN_TYPE::JEQ:
-		i = extract_jeq_instr(tokens, i, instr);
+		extract_jeq_instr(cursor, instr);
+		break;
+	case TOKEN_TYPE::JNE:
+		extract_jne_instr(cursor, instr);
 		break;
 	case TOKEN_TYPE::JGT:
-		i = extract_jgt_instr(tokens, i, instr);
+		extract_jgt_instr(cursor, instr);
+		break;
+	case TOKEN_TYPE::JLT:
+		extract_jlt_instr(cursor, instr);
+		break;
+	case TOKEN_TYPE::JGE:
+		extract_jge_instr(cursor, instr);
+		break;
+	case TOKEN_TYPE::JLE:
+		extract_jle_instr(cursor, instr);
 		break;
 	case TOKEN_TYPE::CALL:
-		i = extract_call_instr(tokens, i, instr);
+		extract_call_instr(cursor, instr);
 		break;
 	case TOKEN_TYPE::RET:
-		i = extract_ret_instr(tokens, i, instr);
+		extract_ret_instr(cursor, instr);
 		break;
 	case TOKEN_TYPE::DATA:
-		i = extract_data_instr(tokens, i, instr);
+		extract_data_instr(cursor, instr);
 		break;
 	default:
-		throw SyntaxError("Ожидалась инструкция, получено \"" + tokens[i].text + "\"");
+		throw SyntaxError("Ожидалась инструкция, получено \"" + std::string(cursor.peek().text) + "\"");
 	}
 
-	if (i != tokens.size()) {
+	if (!cursor.at_end()) {
 		throw SyntaxError("На одной строке может быть лишь одна инструкция");
 	}
 }
 
 /*!
 Извлекает имена меток, записанные перед инструкцией
-\param[in] tokens Токены
-\param[in] pos Заданная позиция
+\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
 \param[out] label_names Список считанных имен меток
-\return Позиция токена, следующего за инструкцией
 \throw SyntaxError В случае, если инструкция записана синтаксически неправильно
 */
-int MnemonicTranslator::extract_labels(const std::vector<Token>& tokens, int pos, std::vector<std::string>& label_names) const {
-	int i = pos;
-
-	while (i < tokens.size() && tokens[i].type == TOKEN_TYPE::NAME) {
-		label_names.push_back(tokens[i].text);
+void MnemonicTranslator::extract_labels(TokenCursor& cursor, std::vector<std::string>& label_names) const {
+	while (cursor.is(TOKEN_TYPE::NAME)) {
+		label_names.push_back(std::string(cursor.next().text));
 
-		i++;
-		if (i == tokens.size() || tokens[i].type != TOKEN_TYPE::COLON) {
+		if (!cursor.is(TOKEN_TYPE::COLON)) {
 			throw SyntaxError("После метки \"" + label_names.at(label_names.size() - 1) + "\" должно идти двоеточие");
 		}
 
-		i++;
+		cursor.next();
 	}
+}
 
-	return i;
+/*!
+Конструктор транслятора
+\param[in] tokenizer_type Способ выделения токенов из строк
+*/
+MnemonicTranslator::MnemonicTranslator(TOKENIZER tokenizer_type) : tokenizer_type{ tokenizer_type } {
 }
 
 /*!
@@ -1113,30 +1446,62 @@ int MnemonicTranslator::extract_labels(const std::vector<Token>& tokens, int pos
 \param[out] syntax_errors Ошибки, возникшие во время синтаксического разбора инструкций
 \return Флаг, указывающий, возникли ли ошибки во время перевода мнемоник
 */
-bool MnemonicTranslator::translate(std::ifstream& input_file, std::vector<std::shared_ptr<Instr>>& instrs, std::map<std::string, int>& labels, std::vector<TokenizerError>& tokenizer_errors, std::vector<SyntaxError>& syntax_errors) const {
+bool MnemonicTranslator::translate(std::istream& input_file, std::vector<std::shared_ptr<Instr>>& instrs, std::map<std::string, int>& labels, std::vector<TokenizerError>& tokenizer_errors, std::vector<SyntaxError>& syntax_errors) const {
+	SourceFile source;
+	source.read(input_file);
+
+	return translate(source.get_text(), instrs, labels, tokenizer_errors, syntax_errors);
+}
+
+/*!
+Переводит часть текста программы во внутреннее представление
+\param[in] chunk Часть текста программы из целых строк
+\param[in] first_line_number Номер первой строки части
+\param[in|out] result Результат трансляции. Метки из result.pending_label_names
+относятся к первой инструкции части, а после трансляции в нём остаются метки, объявленные после последней инструкции
+*/
+void MnemonicTranslator::translate_chunk(std::string_view chunk, int first_line_number, TranslatedChunk& result) const {
 	// Токенайзер псевдо-ассемблера
-	Tokenizer tokenizer;
+	std::unique_ptr<AbstractTokenizer> tokenizer;
+	if (tokenizer_type == TOKENIZER::REGEX) {
+		tokenizer.reset(new Tokenizer());
+	}
+	else {
+		tokenizer.reset(new DfaTokenizer());
+	}
 
-	// Текущая строка из входного потока
-	std::string line;
+	// Токены текущей строки. Вектор переиспользуется, чтобы не выделять память на каждой строке
+	std::vector<Token> tokens;
 
 	// Метки, ссылающиеся на текущую инструкцию
-	std::vector<std::string> found_label_names;
+	std::vector<std::string>& found_label_names = result.pending_label_names;
+
+	int current_line_number = first_line_number - 1;
 
-	int current_line_number = 0;
+	// Индекс начала текущей строки в части текста
+	size_t line_start = 0;
+
+	// Пока в части текста есть строки
+	while (line_start < chunk.size()) {
+		size_t line_end = chunk.find('\n', line_start);
+		if (line_end == std::string_view::npos) {
+			line_end = chunk.size();
+		}
+
+		std::string_view line = chunk.substr(line_start, line_end - line_start);
+		line_start = line_end + 1;
 
-	// Пока во входном файле есть строки
-	while (std::getline(input_file, line)) {
 		try {
 			current_line_number++;
 
 			// Конвертировать текущую строку в поток токенов
-			std::vector<Token> tokens;
-			tokenizer.tokenize(line, tokens);
+			tokens.clear();
+			tokenizer->tokenize(line, tokens);
 
 			// Извлечь метки, написанные вначале строки
+			TokenCursor cursor(tokens);
 			std::vector<std::string> label_names_buf;
-			int instr_start_pos = extract_labels(tokens, 0, label_names_buf);
+			extract_labels(cursor, label_names_buf);
 
 			// Если метки были найдены, проверяем, были ли среди них дубликата
 			if (label_names_buf.size() > 0) {
@@ -1150,13 +1515,13 @@ bool MnemonicTranslator::translate(std::ifstream& input_file, std::vector<std::s
 			}
 
 			// Если токенов кроме меток в строке не было, перейти к следующей строчке
-			if (instr_start_pos == tokens.size()) {
+			if (cursor.at_end()) {
 				continue;
 			}
 
 			// Извлечь инструкцию, написанную в строке
 			std::shared_ptr<Instr> instr = nullptr;
-			extract_instr(tokens, instr_start_pos, instr);
+			extract_instr(cursor, instr);
 
 			// Если на строке была инструкция
 			if (instr != nullptr) {
@@ -1164,13 +1529,13 @@ bool MnemonicTranslator::translate(std::ifstream& input_file, std::vector<std::s
 				instr->set_line_number(current_line_number);
 
 				// Поместить её в список считанных инструкция
-				instrs.push_back(instr);
-				int instr_address = instrs.size() - 1;
+				result.instrs.push_back(instr);
+				int instr_address = result.instrs.size() - 1;
 
 				// Для каждой найденной раннее метки
-				for (const std::string& label : found_label_names) {
+				for (std::string& label : found_label_names) {
 					// Сохранить метку и адрес, на которой она указывает
-					labels[label] = instr_address;
+					result.labels.emplace_back(std::move(label), instr_address);
 				}
 
 				// Очистить список ранее найденных меток
@@ -1179,13 +1544,197 @@ bool MnemonicTranslator::translate(std::ifstream& input_file, std::vector<std::s
 		}
 		catch (TokenizerError& err) {
 			err.change_error_message("Строка " + std::to_string(current_line_number) + ": " + err.what());
-			tokenizer_errors.push_back(err);
+			result.tokenizer_errors.push_back(err);
 		}
 		catch (SyntaxError& err) {
 			err.change_error_message("Строка " + std::to_string(current_line_number) + ": " + err.what());
-			syntax_errors.push_back(err);
+			result.syntax_errors.push_back(err);
+		}
+	}
+}
+
+/*!
+Переводит текст программы на языке псевдо-ассемблера во внутреннее представление.
+Строки и токены ссылаются на исходный текст и не копируются
+\param[in] source Текст программы
+\param[out] instrs Считанные инструкции
+\param[out] instr Считанные метки
+\param[out] tokenizer_errors Ошибки, возникшие во время токенезации мнемоник
+\param[out] syntax_errors Ошибки, возникшие во время синтаксического разбора инструкций
+\param[in] thread_count Количество потоков. Текст размером от PARALLEL_TRANSLATION_MIN_SIZE делится
+на части по границам строк, которые переводятся параллельно, а затем соединяются по порядку
+\return Флаг, указывающий, возникли ли ошибки во время перевода мнемоник
+*/
+bool MnemonicTranslator::translate(std::string_view source, std::vector<std::shared_ptr<Instr>>& instrs, std::map<std::string, int>& labels, std::vector<TokenizerError>& tokenizer_errors, std::vector<SyntaxError>& syntax_errors, int thread_count) const {
+	// Запуск потоков для небольшой программы обходится дороже её трансляции
+	if (source.size() < PARALLEL_TRANSLATION_MIN_SIZE) {
+		thread_count = 1;
+	}
+
+	// Текст делится на части примерно равного размера, каждая из которых заканчивается концом строки
+	std::vector<std::string_view> chunk_texts;
+	std::vector<int> first_line_numbers;
+	size_t chunk_start = 0;
+	int line_number = 1;
+	for (int i = 0; i < thread_count && chunk_start < source.size(); i++) {
+		size_t chunk_end = source.size();
+		if (i < thread_count - 1) {
+			chunk_end = source.find('\n', std::max(chunk_start, source.size() * (i + 1) / thread_count));
+			chunk_end = chunk_end == std::string_view::npos ? source.size() : chunk_end + 1;
+		}
+
+		chunk_texts.push_back(source.substr(chunk_start, chunk_end - chunk_start));
+		first_line_numbers.push_back(line_number);
+		line_number += std::count(source.begin() + chunk_start, source.begin() + chunk_end, '\n');
+		chunk_start = chunk_end;
+	}
+
+	// Первая часть переводится в вызывающем потоке, остальные - в отдельных
+	std::vector<TranslatedChunk> chunks(chunk_texts.size());
+	std::vector<std::thread> workers;
+	for (size_t i = 1; i < chunks.size(); i++) {
+		workers.emplace_back([this, &chunk_texts, &first_line_numbers, &chunks, i] {
+			translate_chunk(chunk_texts[i], first_line_numbers[i], chunks[i]);
+		});
+	}
+	if (!chunks.empty()) {
+		translate_chunk(chunk_texts[0], first_line_numbers[0], chunks[0]);
+	}
+	for (auto& worker : workers) {
+		worker.join();
+	}
+
+	// Части соединяются по порядку: индексы инструкций сдвигаются на количество инструкций предыдущих частей,
+	// поэтому ошибки остаются упорядоченными по строкам, а повторно объявленная метка указывает на последнюю инструкцию
+	for (size_t i = 0; i < chunks.size(); i++) {
+		// Метки в конце предыдущей части относятся к первой инструкции этой части. Часть переводится заново
+		// вместе с ними, чтобы повторное объявление метки на границе частей обнаруживалось так же, как в одном потоке
+		if (i > 0 && !chunks[i - 1].pending_label_names.empty()) {
+			TranslatedChunk carried;
+			carried.pending_label_names = std::move(chunks[i - 1].pending_label_names);
+			translate_chunk(chunk_texts[i], first_line_numbers[i], carried);
+			chunks[i] = std::move(carried);
+		}
+
+		TranslatedChunk& chunk = chunks[i];
+		int instr_offset = instrs.size();
+		for (auto& label : chunk.labels) {
+			labels[std::move(label.first)] = instr_offset + label.second;
 		}
-	}	
+
+		instrs.insert(instrs.end(), std::make_move_iterator(chunk.instrs.begin()), std::make_move_iterator(chunk.instrs.end()));
+		tokenizer_errors.insert(tokenizer_errors.end(), std::make_move_iterator(chunk.tokenizer_errors.begin()), std::make_move_iterator(chunk.tokenizer_errors.end()));
+		syntax_errors.insert(syntax_errors.end(), std::make_move_iterator(chunk.syntax_errors.begin()), std::make_move_iterator(chunk.syntax_errors.end()));
+	}
 
 	return tokenizer_errors.size() == 0 && syntax_errors.size() == 0;
+}
+
+/*!
+Разрешает метки, на которые ссылаются инструкции перехода и вызова подпрограмм, в индексы инструкций
+\param[in] instrs Считанные инструкции
+\param[in] labels Считанные метки
+\param[out] syntax_errors Ошибки, возникшие из-за ссылок на неизвестные метки
+\return Флаг, указывающий, возникли ли ошибки во время компоновки
+*/
+bool MnemonicTranslator::link(const std::vector<std::shared_ptr<Instr>>& instrs, const std::map<std::string, int>& labels, std::vector<SyntaxError>& syntax_errors) const {
+	bool linked = true;
+
+	for (const auto& instr : instrs) {
+		BranchInstr* branch_instr = dynamic_cast<BranchInstr*>(instr.get());
+
+		// Метки есть только у инструкций перехода и вызова подпрограмм
+		if (branch_instr == nullptr) {
+			continue;
+		}
+
+		std::string label_name = branch_instr->get_label_name();
+
+		// Встроенные подпрограммы разрешаются в идентификаторы ещё при трансляции
+		CallInstr* call_instr = dynamic_cast<CallInstr*>(branch_instr);
+		if (call_instr != nullptr && call_instr->is_builtin()) {
+			continue;
+		}
+
+		auto label = labels.find(label_name);
+		if (label == labels.end()) {
+			syntax_errors.push_back(SyntaxError("Строка " + std::to_string(instr->get_line_number()) + ": Неизвестная метка \"" + label_name + "\""));
+			linked = false;
+			continue;
+		}
+
+		branch_instr->set_address(label->second);
+	}
+
+	return linked;
+}
+
+/*!
+Размещает данные инструкций "data" по фиксированным адресам в порядке их следования
+и заменяет имена ячеек памяти в инструкциях "set", "ld" и "st" их адресами
+\param[in] instrs Считанные инструкции
+\param[out] data_addresses Адреса ячеек памяти по их именам
+\param[out] memory_image Начальное содержимое памяти, начиная с нулевого адреса
+\param[out] syntax_errors Ошибки, возникшие из-за повторяющихся или неизвестных имен ячеек памяти и нехватки памяти
+\param[in] memory_size Количество ячеек памяти, в которые должны поместиться данные
+\return Флаг, указывающий, возникли ли ошибки во время размещения данных
+*/
+bool MnemonicTranslator::layout_data(const std::vector<std::shared_ptr<Instr>>& instrs, std::map<std::string, int>& data_addresses, std::vector<int>& memory_image, std::vector<SyntaxError>& syntax_errors, int memory_size) const {
+	bool placed = true;
+
+	for (const auto& instr : instrs) {
+		DataInstr* data_instr = dynamic_cast<DataInstr*>(instr.get());
+		if (data_instr == nullptr) {
+			continue;
+		}
+
+		std::string name = data_instr->get_data_label_name();
+		std::vector<int> data = data_instr->get_data();
+		std::string line = "Строка " + std::to_string(instr->get_line_number()) + ": ";
+
+		if (data_addresses.count(name) > 0) {
+			syntax_errors.push_back(SyntaxError(line + "Имя переменной не может повторяться \"" + name + "\""));
+			placed = false;
+			continue;
+		}
+		if (memory_image.size() + data.size() > memory_size) {
+			syntax_errors.push_back(SyntaxError(line + "Не хватает памяти для записи всех значений"));
+			placed = false;
+			continue;
+		}
+
+		// Данные располагаются подряд, начиная с нулевого адреса, как их раньше выделяла инструкция "data"
+		data_addresses[name] = memory_image.size();
+		data_instr->set_data_address(memory_image.size());
+		memory_image.insert(memory_image.end(), data.begin(), data.end());
+	}
+
+	for (const auto& instr : instrs) {
+		DataAccessInstr* access_instr = dynamic_cast<DataAccessInstr*>(instr.get());
+		if (access_instr == nullptr) {
+			continue;
+		}
+
+		auto address = data_addresses.find(access_instr->get_var_name());
+		if (address == data_addresses.end()) {
+			syntax_errors.push_back(SyntaxError("Строка " + std::to_string(instr->get_line_number()) + ": Неизвестное имя ячейки памяти \"" + access_instr->get_var_name() + "\""));
+			placed = false;
+			continue;
+		}
+
+		access_instr->set_data_address(address->second);
+	}
+
+	return placed;
+}
+
+/*!
+Записывает скомпонованные инструкции в байт-код
+\param[in] instrs Скомпонованные инструкции с размещенными данными
+\param[out] bytecode Байт-код
+*/
+void MnemonicTranslator::emit(const std::vector<std::shared_ptr<Instr>>& instrs, Bytecode& bytecode) const {
+	for (const auto& instr : instrs) {
+		instr->emit(bytecode);
+	}
 }
\ No newline at end of file
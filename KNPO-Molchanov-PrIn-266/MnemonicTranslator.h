@@ -3,9 +3,15 @@
 #include <vector>
 #include <map>
 #include <string>
+#include <string_view>
+#include <istream>
+#include <memory>
+#include <utility>
 
 #include "Tokenizer.h"
+#include "TokenCursor.h"
 #include "Instruction.h"
+#include "Bytecode.h"
 
 /*!
 Класс, описывающий ошибку, возникающую в случае, если
@@ -36,310 +42,370 @@ public:
 	void change_error_message(const std::string& m);
 };
 
+/// Способы выделения токенов из строк
+enum class TOKENIZER {
+	REGEX, ///< Tokenizer на регулярных выражениях, эталонный вариант для отладки
+	DFA, ///< DfaTokenizer, выделяющий токены за один проход по строке
+};
+
+/// Наименьший размер текста программы, начиная с которого трансляция делится между потоками
+const size_t PARALLEL_TRANSLATION_MIN_SIZE = 256 * 1024;
+
+/*!
+Результат трансляции части текста программы. Индексы инструкций
+в метках отсчитываются от начала части
+*/
+struct TranslatedChunk {
+	/// Считанные инструкции
+	std::vector<std::shared_ptr<Instr>> instrs;
+	/// Метки и индексы инструкций, на которые они указывают, в порядке их объявления
+	std::vector<std::pair<std::string, int>> labels;
+	/// Ошибки, возникшие во время токенизации, в порядке строк
+	std::vector<TokenizerError> tokenizer_errors;
+	/// Ошибки, возникшие во время синтаксического разбора, в порядке строк
+	std::vector<SyntaxError> syntax_errors;
+	/// Метки, ещё не отнесенные к инструкции: объявленные до начала части и в её конце
+	std::vector<std::string> pending_label_names;
+};
+
 /*
 Транслятор текстовых мнемоник псевдо-ассмеблера во внутреннее представление 
 */
 class MnemonicTranslator
 {
 private:
+	/// Способ выделения токенов из строк
+	TOKENIZER tokenizer_type;
+
 	/*!
-	Проверяет, что токен на заданной позиции является требуемой командной
-	\param[in] tokens Токены
-	\param[in] pos Заданная позиция
+	Проверяет, что текущий токен является требуемой командной, иначе
+	бросает исключение, с соотвествующим сообщением, какой токен команды ожидался
+	\param[in|out] cursor Курсор по токенам строки, переводится на следующий токен
 	\param[in] command_type Требуемый тип команды
 	\param[in] command_name Имя команды для исключения, в случае если команды не было найдено
-	\return Позиция токена, следующего за искомым токеном
 	\throw SyntaxError В случае, если искомого токена не оказалось на заданной позици
 	*/
-	int check_command(std::vector<Token> tokens, int pos, TOKEN_TYPE command_type, const std::string& command_name) const;
+	void check_command(TokenCursor& cursor, TOKEN_TYPE command_type, std::string_view command_name) const;
 
 	/*!
-	Проверяет, что токен на заданной позиции является запятой
-	\param[in] tokens Токены
-	\param[in] pos Заданная позиция
-	\return Позиция токена, следующего за искомым токеном
+	Проверяет, что текущий токен является запятой, иначе бросает исключение
+	с сообщением, что ожидалась запятая
+	\param[in|out] cursor Курсор по токенам строки, переводится на следующий токен
 	\throw SyntaxError В случае, если запятой не оказалось на заданной позиции
 	*/
-	int check_comma(const std::vector<Token>& tokens, int pos) const;
+	void check_comma(TokenCursor& cursor) const;
 
 	/*!
-	Проверят, что на заданной позиции находится токен регистра
-	\param[in] tokens Токены
-	\param[in] pos Заданная позиция
-	\return Позиция токена, следующего за искомым токеном
+	Проверят, что текущий токен является токеном регистра, иначе бросает исключение
+	с сообщением, что ожидался регистр
+	\param[in] cursor Курсор по токенам строки
 	\throw SyntaxError В случае, если регистра не оказалось на заданной позиции
 	*/
-	void expect_register(const std::vector<Token>& tokens, int pos) const;
+	void expect_register(const TokenCursor& cursor) const;
 
 	/*!
-	Проверят, что на заданной позиции находится токен имени
-	\param[in] tokens Токены
-	\param[in] pos Заданная позиция
-	\return Позиция токена, следующего за искомым токеном
+	Проверят, что текущий токен является токеном имени, иначе бросает исключение
+	с сообщением, что ожидалось имя
+	\param[in] cursor Курсор по токенам строки
 	\throw SyntaxError В случае, если имени не оказалось на заданной позиции
 	*/
-	void expect_name(const std::vector<Token>& tokens, int pos) const;
+	void expect_name(const TokenCursor& cursor) const;
 
 	/*!
-	Проверят, что на заданной позиции находится токен числа
-	\param[in] tokens Токены
-	\param[in] pos Заданная позиция
-	\return Позиция токена, следующего за искомым токеном
+	Проверят, что текущий токен является токеном числа, иначе бросает исключение
+	с сообщением, что ожидалось число
+	\param[in] cursor Курсор по токенам строки
 	\throw SyntaxError В случае, если числа не оказалось на заданной позиции
 	*/
-	void expect_number(const std::vector<Token>& tokens, int pos) const;
+	void expect_number(const TokenCursor& cursor) const;
 
 	/*!
-	Извлекает числовой токен с заданной позиции и конвертирует его в число
-	\param[in] tokens Токены
-	\param[in] pos Заданная позиция
+	Извлекает числовой токен, перед которым может стоять знак, и конвертирует его в число
+	\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за числом
 	\param[out] number Сконвертированное число
-	\return Позиция токена, следующего числовым токеном
 	\throw SyntaxError В случае, если числа не оказалось на заданной позиции
 	*/
-	int extract_number(std::vector<Token> tokens, int pos, int& number) const;
+	void extract_number(TokenCursor& cursor, int& number) const;
 
 	/*!
-	Извлекает токен регистра с заданной позиции и определяет регистр, который он обозначает
-	\param[in] tokens Токены
-	\param[in] pos Заданная позиция
+	Извлекает токен регистра и определяет регистр, который он обозначает
+	\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за регистром
 	\param[out] reg Считанный регистр
-	\return Позиция токена, следующего токеном регистра
 	\throw SyntaxError В случае, если регистра не оказалось на заданной позиции
 	*/
-	int extract_register(std::vector<Token> tokens, int pos, REGISTER& reg) const;
+	void extract_register(TokenCursor& cursor, REGISTER& reg) const;
 
 	/*!
-	Извлекает токен имени с заданной позиции
-	\param[in] tokens Токены
-	\param[in] pos Заданная позиция
+	Извлекает токен имени
+	\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за именем
 	\param[out] var_name Считанное имя
-	\return Позиция токена, следующего токеном имени
 	\throw SyntaxError В случае, если имени не оказалось на заданной позиции
 	*/
-	int extract_name(std::vector<Token> tokens, int pos, std::string& var_name) const;
+	void extract_name(TokenCursor& cursor, std::string& var_name) const;
 
 	/*!
 	Извлекает инструкцию "add" с заданной позиции
-	\param[in] tokens Токены
-	\param[in] pos Заданная позиция
+	\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
 	\param[out] add_instr Считанная инструкция "add"
-	\return Позиция токена, следующего за инструкцией 
 	\throw SyntaxError В случае, если инструкция записана синтаксически неправильно
 	*/
-	int extract_add_instr(const std::vector<Token>& tokens, int pos, std::shared_ptr<Instr>& add_instr) const;
+	void extract_add_instr(TokenCursor& cursor, std::shared_ptr<Instr>& add_instr) const;
 
 	/*!
 	Извлекает инструкцию "sub" с заданной позиции
-	\param[in] tokens Токены
-	\param[in] pos Заданная позиция
+	\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
 	\param[out] sub_instr Считанная инструкция "sub"
-	\return Позиция токена, следующего за инструкцией
 	\throw SyntaxError В случае, если инструкция записана синтаксически неправильно
 	*/
-	int extract_sub_instr(const std::vector<Token>& tokens, int pos, std::shared_ptr<Instr>& sub_instr) const;
+	void extract_sub_instr(TokenCursor& cursor, std::shared_ptr<Instr>& sub_instr) const;
 
 	/*!
 	Извлекает инструкцию "and" с заданной позиции
-	\param[in] tokens Токены
-	\param[in] pos Заданная позиция
+	\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
 	\param[out] and_instr Считанная инструкция "and"
-	\return Позиция токена, следующего за инструкцией
 	\throw SyntaxError В случае, если инструкция записана синтаксически неправильно
 	*/
-	int extract_and_instr(const std::vector<Token>& tokens, int pos, std::shared_ptr<Instr>& and_instr) const;
+	void extract_and_instr(TokenCursor& cursor, std::shared_ptr<Instr>& and_instr) const;
 
 	/*!
 	Извлекает инструкцию "or" с заданной позиции
-	\param[in] tokens Токены
-	\param[in] pos Заданная позиция
+	\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
 	\param[out] or_instr Считанная инструкция "or"
-	\return Позиция токена, следующего за инструкцией
 	\throw SyntaxError В случае, если инструкция записана синтаксически неправильно
 	*/
-	int extract_or_instr(const std::vector<Token>& tokens, int pos, std::shared_ptr<Instr>& or_instr) const;
+	void extract_or_instr(TokenCursor& cursor, std::shared_ptr<Instr>& or_instr) const;
 
 	/*!
 	Извлекает инструкцию "xor" с заданной позиции
-	\param[in] tokens Токены
-	\param[in] pos Заданная позиция
+	\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
 	\param[out] or_instr Считанная инструкция "xor"
-	\return Позиция токена, следующего за инструкцией
 	\throw SyntaxError В случае, если инструкция записана синтаксически неправильно
 	*/
-	int extract_xor_instr(const std::vector<Token>& tokens, int pos, std::shared_ptr<Instr>& xor_instr) const;
+	void extract_xor_instr(TokenCursor& cursor, std::shared_ptr<Instr>& xor_instr) const;
 
 	/*!
 	Извлекает инструкцию "not" с заданной позиции
-	\param[in] tokens Токены
-	\param[in] pos Заданная позиция
+	\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
 	\param[out] not_instr Считанная инструкция "not"
-	\return Позиция токена, следующего за инструкцией
 	\throw SyntaxError В случае, если инструкция записана синтаксически неправильно
 	*/
-	int extract_not_instr(const std::vector<Token>& tokens, int pos, std::shared_ptr<Instr>& not_instr) const;
+	void extract_not_instr(TokenCursor& cursor, std::shared_ptr<Instr>& not_instr) const;
 
 	/*!
 	Извлекает инструкцию "shr" с заданной позиции
-	\param[in] tokens Токены
-	\param[in] pos Заданная позиция
+	\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
 	\param[out] shr_instr Считанная инструкция "shr"
-	\return Позиция токена, следующего за инструкцией
 	\throw SyntaxError В случае, если инструкция записана синтаксически неправильно
 	*/
-	int extract_shr_instr(const std::vector<Token>& tokens, int pos, std::shared_ptr<Instr>& shr_instr) const;
+	void extract_shr_instr(TokenCursor& cursor, std::shared_ptr<Instr>& shr_instr) const;
 
 	/*!
 	Извлекает инструкцию "shl" с заданной позиции
-	\param[in] tokens Токены
-	\param[in] pos Заданная позиция
+	\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
 	\param[out] shl_instr Считанная инструкция "shl"
-	\return Позиция токена, следующего за инструкцией
 	\throw SyntaxError В случае, если инструкция записана синтаксически неправильно
 	*/
-	int extract_shl_instr(const std::vector<Token>& tokens, int pos, std::shared_ptr<Instr>& shl_instr) const;
+	void extract_shl_instr(TokenCursor& cursor, std::shared_ptr<Instr>& shl_instr) const;
+
+	/*!
+	Извлекает инструкцию "mul" с заданной позиции
+	\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
+	\param[out] mul_instr Считанная инструкция "mul"
+	\throw SyntaxError В случае, если инструкция записана синтаксически неправильно
+	*/
+	void extract_mul_instr(TokenCursor& cursor, std::shared_ptr<Instr>& mul_instr) const;
+
+	/*!
+	Извлекает инструкцию "div" с заданной позиции
+	\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
+	\param[out] div_instr Считанная инструкция "div"
+	\throw SyntaxError В случае, если инструкция записана синтаксически неправильно
+	*/
+	void extract_div_instr(TokenCursor& cursor, std::shared_ptr<Instr>& div_instr) const;
+
+	/*!
+	Извлекает инструкцию "mod" с заданной позиции
+	\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
+	\param[out] mod_instr Считанная инструкция "mod"
+	\throw SyntaxError В случае, если инструкция записана синтаксически неправильно
+	*/
+	void extract_mod_instr(TokenCursor& cursor, std::shared_ptr<Instr>& mod_instr) const;
 
 	/*!
 	Извлекает инструкцию "set" с заданной позиции
-	\param[in] tokens Токены
-	\param[in] pos Заданная позиция
+	\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
 	\param[out] set_instr Считанная инструкция "set"
-	\return Позиция токена, следующего за инструкцией
 	\throw SyntaxError В случае, если инструкция записана синтаксически неправильно
 	*/
-	int extract_set_instr(const std::vector<Token>& tokens, int pos, std::shared_ptr<Instr>& set_instr) const;
+	void extract_set_instr(TokenCursor& cursor, std::shared_ptr<Instr>& set_instr) const;
 
 	/*!
 	Извлекает инструкцию "ld" с заданной позиции
-	\param[in] tokens Токены
-	\param[in] pos Заданная позиция
+	\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
 	\param[out] ld_instr Считанная инструкция "ld"
-	\return Позиция токена, следующего за инструкцией
 	\throw SyntaxError В случае, если инструкция записана синтаксически неправильно
 	*/
-	int extract_ld_instr(const std::vector<Token>& tokens, int pos, std::shared_ptr<Instr>& ld_instr) const;
+	void extract_ld_instr(TokenCursor& cursor, std::shared_ptr<Instr>& ld_instr) const;
 
 	/*!
 	Извлекает инструкцию "st" с заданной позиции
-	\param[in] tokens Токены
-	\param[in] pos Заданная позиция
+	\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
 	\param[out] st_instr Считанная инструкция "st"
-	\return Позиция токена, следующего за инструкцией
 	\throw SyntaxError В случае, если инструкция записана синтаксически неправильно
 	*/
-	int extract_st_instr(const std::vector<Token>& tokens, int pos, std::shared_ptr<Instr>& st_instr) const;
+	void extract_st_instr(TokenCursor& cursor, std::shared_ptr<Instr>& st_instr) const;
 
 	/*!
 	Извлекает инструкцию "ldi" с заданной позиции
-	\param[in] tokens Токены
-	\param[in] pos Заданная позиция
+	\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
 	\param[out] ldi_instr Считанная инструкция "ldi"
-	\return Позиция токена, следующего за инструкцией
 	\throw SyntaxError В случае, если инструкция записана синтаксически неправильно
 	*/
-	int extract_ldi_instr(const std::vector<Token>& tokens, int pos, std::shared_ptr<Instr>& ldi_instr) const;
+	void extract_ldi_instr(TokenCursor& cursor, std::shared_ptr<Instr>& ldi_instr) const;
 
 	/*!
 	Извлекает инструкцию "sti" с заданной позиции
-	\param[in] tokens Токены
-	\param[in] pos Заданная позиция
+	\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
 	\param[out] sti_instr Считанная инструкция "sti"
-	\return Позиция токена, следующего за инструкцией
 	\throw SyntaxError В случае, если инструкция записана синтаксически неправильно
 	*/
-	int extract_sti_instr(const std::vector<Token>& tokens, int pos, std::shared_ptr<Instr>& sti_instr) const;
+	void extract_sti_instr(TokenCursor& cursor, std::shared_ptr<Instr>& sti_instr) const;
+
+	/*!
+	Извлекает инструкцию "push" с заданной позиции
+	\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
+	\param[out] push_instr Считанная инструкция "push"
+	\throw SyntaxError В случае, если инструкция записана синтаксически неправильно
+	*/
+	void extract_push_instr(TokenCursor& cursor, std::shared_ptr<Instr>& push_instr) const;
+
+	/*!
+	Извлекает инструкцию "pop" с заданной позиции
+	\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
+	\param[out] pop_instr Считанная инструкция "pop"
+	\throw SyntaxError В случае, если инструкция записана синтаксически неправильно
+	*/
+	void extract_pop_instr(TokenCursor& cursor, std::shared_ptr<Instr>& pop_instr) const;
 
 	/*!
 	Извлекает инструкцию "jmp" с заданной позиции
-	\param[in] tokens Токены
-	\param[in] pos Заданная позиция
+	\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
 	\param[out] jmp_instr Считанная инструкция "jmp"
-	\return Позиция токена, следующего за инструкцией
 	\throw SyntaxError В случае, если инструкция записана синтаксически неправильно
 	*/
-	int extract_jmp_instr(const std::vector<Token>& tokens, int pos, std::shared_ptr<Instr>& jmp_instr) const;
+	void extract_jmp_instr(TokenCursor& cursor, std::shared_ptr<Instr>& jmp_instr) const;
 
 	/*!
 	Извлекает инструкцию "jeq" с заданной позиции
-	\param[in] tokens Токены
-	\param[in] pos Заданная позиция
+	\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
 	\param[out] jeq_instr Считанная инструкция "jeq"
-	\return Позиция токена, следующего за инструкцией
 	\throw SyntaxError В случае, если инструкция записана синтаксически неправильно
 	*/
-	int extract_jeq_instr(const std::vector<Token>& tokens, int pos, std::shared_ptr<Instr>& jeq_instr) const;
+	void extract_jeq_instr(TokenCursor& cursor, std::shared_ptr<Instr>& jeq_instr) const;
+
+	/*!
+	Извлекает инструкцию "jne" с заданной позиции
+	\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
+	\param[out] jne_instr Считанная инструкция "jne"
+	\throw SyntaxError В случае, если инструкция записана синтаксически неправильно
+	*/
+	void extract_jne_instr(TokenCursor& cursor, std::shared_ptr<Instr>& jne_instr) const;
 
 	/*!
 	Извлекает инструкцию "jgt" с заданной позиции
-	\param[in] tokens Токены
-	\param[in] pos Заданная позиция
+	\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
 	\param[out] jgt_instr Считанная инструкция "jgt"
-	\return Позиция токена, следующего за инструкцией
 	\throw SyntaxError В случае, если инструкция записана синтаксически неправильно
 	*/
-	int extract_jgt_instr(const std::vector<Token>& tokens, int pos, std::shared_ptr<Instr>& jgt_instr) const;
+	void extract_jgt_instr(TokenCursor& cursor, std::shared_ptr<Instr>& jgt_instr) const;
+
+	/*!
+	Извлекает инструкцию "jlt" с заданной позиции
+	\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
+	\param[out] jlt_instr Считанная инструкция "jlt"
+	\throw SyntaxError В случае, если инструкция записана синтаксически неправильно
+	*/
+	void extract_jlt_instr(TokenCursor& cursor, std::shared_ptr<Instr>& jlt_instr) const;
+
+	/*!
+	Извлекает инструкцию "jge" с заданной позиции
+	\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
+	\param[out] jge_instr Считанная инструкция "jge"
+	\throw SyntaxError В случае, если инструкция записана синтаксически неправильно
+	*/
+	void extract_jge_instr(TokenCursor& cursor, std::shared_ptr<Instr>& jge_instr) const;
+
+	/*!
+	Извлекает инструкцию "jle" с заданной позиции
+	\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
+	\param[out] jle_instr Считанная инструкция "jle"
+	\throw SyntaxError В случае, если инструкция записана синтаксически неправильно
+	*/
+	void extract_jle_instr(TokenCursor& cursor, std::shared_ptr<Instr>& jle_instr) const;
 
 	/*!
 	Извлекает инструкцию "call" с заданной позиции
-	\param[in] tokens Токены
-	\param[in] pos Заданная позиция
+	\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
 	\param[out] call_instr Считанная инструкция "call"
-	\return Позиция токена, следующего за инструкцией
 	\throw SyntaxError В случае, если инструкция записана синтаксически неправильно
 	*/
-	int extract_call_instr(const std::vector<Token>& tokens, int pos, std::shared_ptr<Instr>& call_instr) const;
+	void extract_call_instr(TokenCursor& cursor, std::shared_ptr<Instr>& call_instr) const;
 
 	/*!
 	Извлекает инструкцию "ret" с заданной позиции
-	\param[in] tokens Токены
-	\param[in] pos Заданная позиция
+	\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
 	\param[out] ret_instr Считанная инструкция "ret"
-	\return Позиция токена, следующего за инструкцией
 	\throw SyntaxError В случае, если инструкция записана синтаксически неправильно
 	*/
-	int extract_ret_instr(const std::vector<Token>& tokens, int pos, std::shared_ptr<Instr>& ret_instr) const;
+	void extract_ret_instr(TokenCursor& cursor, std::shared_ptr<Instr>& ret_instr) const;
 
 	/*!
 	Извлекает список аргументов для инструкции "data" с заданной позиции
-	\param[in] tokens Токены
-	\param[in] pos Заданная позиция
+	\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
 	\param[out] arguments Список считанных аргументов
-	\return Позиция токена, следующего за список аргументов
 	\throw SyntaxError В случае, если список аргументов записан неправильно
 	*/
-	int extract_data_argument_list(const std::vector<Token>& tokens, int pos, std::vector<int>& arguments) const;
+	void extract_data_argument_list(TokenCursor& cursor, std::vector<int>& arguments) const;
 
 	/*!
 	Извлекает инструкцию "data" с заданной позиции
-	\param[in] tokens Токены
-	\param[in] pos Заданная позиция
+	\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
 	\param[out] data_instr Считанная инструкция "data"
-	\return Позиция токена, следующего за инструкцией
 	\throw SyntaxError В случае, если инструкция записана синтаксически неправильно
 	*/
-	int extract_data_instr(const std::vector<Token>& tokens, int pos, std::shared_ptr<Instr>& data_instr) const;
+	void extract_data_instr(TokenCursor& cursor, std::shared_ptr<Instr>& data_instr) const;
 
 	/*!
-	Извлекает инструкцию псевдо-ассемблера с заданной позиции 
-	\param[in] tokens Токены
-	\param[in] pos Заданная позиция
+	Извлекает инструкцию псевдо-ассемблера с заданной позиции
+	\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
 	\param[out] instr Считанная инструкция
-	\return Позиция токена, следующего за инструкцией
 	\throw SyntaxError В случае, если инструкция записана синтаксически неправильно
 	*/
-	void extract_instr(const std::vector<Token>& tokens, int pos, std::shared_ptr<Instr>& instr) const;
+	void extract_instr(TokenCursor& cursor, std::shared_ptr<Instr>& instr) const;
 
 	/*!
 	Извлекает имена меток, записанные перед инструкцией
-	\param[in] tokens Токены
-	\param[in] pos Заданная позиция
+	\param[in|out] cursor Курсор по токенам строки, переводится на токен, следующий за прочитанным
 	\param[out] label_names Список считанных имен меток
-	\return Позиция токена, следующего за инструкцией
 	\throw SyntaxError В случае, если инструкция записана синтаксически неправильно
 	*/
-	int extract_labels(const std::vector<Token>& tokens, int pos, std::vector<std::string>& label_names) const;
+	void extract_labels(TokenCursor& cursor, std::vector<std::string>& label_names) const;
+
+	/*!
+	Переводит часть текста программы во внутреннее представление
+	\param[in] chunk Часть текста программы из целых строк
+	\param[in] first_line_number Номер первой строки части
+	\param[in|out] result Результат трансляции. Метки из result.pending_label_names
+	относятся к первой инструкции части, а после трансляции в нём остаются метки, объявленные после последней инструкции
+	*/
+	void translate_chunk(std::string_view chunk, int first_line_number, TranslatedChunk& result) const;
 
 public:
+	/*!
+	Конструктор транслятора
+	\param[in] tokenizer_type Способ выделения токенов из строк
+	*/
+	MnemonicTranslator(TOKENIZER tokenizer_type = TOKENIZER::DFA);
 
 	/*!
 	Переводит текстовые мнемоники на языке псевдо-ассемблера во внутреннее представление
@@ -350,5 +416,47 @@ public:
 	\param[out] syntax_errors Ошибки, возникшие во время синтаксического разбора инструкций
 	\return Флаг, указывающий, возникли ли ошибки во время перевода мнемоник
 	*/
-	bool translate(std::ifstream& input_file, std::vector<std::shared_ptr<Instr>>& instrs, std::map<std::string, int>& labels, std::vector<TokenizerError>& tokenizer_errors, std::vector<SyntaxError>& syntax_errors) const;
+	bool translate(std::istream& input_file, std::vector<std::shared_ptr<Instr>>& instrs, std::map<std::string, int>& labels, std::vector<TokenizerError>& tokenizer_errors, std::vector<SyntaxError>& syntax_errors) const;
+
+	/*!
+	Переводит текст программы на языке псевдо-ассемблера во внутреннее представление.
+	Строки и токены ссылаются на исходный текст и не копируются
+	\param[in] source Текст программы
+	\param[out] instrs Считанные инструкции
+	\param[out] instr Считанные метки
+	\param[out] tokenizer_errors Ошибки, возникшие во время токенезации мнемоник
+	\param[out] syntax_errors Ошибки, возникшие во время синтаксического разбора инструкций
+	\param[in] thread_count Количество потоков. Текст размером от PARALLEL_TRANSLATION_MIN_SIZE делится
+	на части по границам строк, которые переводятся параллельно, а затем соединяются по порядку
+	\return Флаг, указывающий, возникли ли ошибки во время перевода мнемоник
+	*/
+	bool translate(std::string_view source, std::vector<std::shared_ptr<Instr>>& instrs, std::map<std::string, int>& labels, std::vector<TokenizerError>& tokenizer_errors, std::vector<SyntaxError>& syntax_errors, int thread_count = 1) const;
+
+	/*!
+	Разрешает метки, на которые ссылаются инструкции перехода и вызова подпрограмм, в индексы инструкций
+	\param[in] instrs Считанные инструкции
+	\param[in] labels Считанные метки
+	\param[out] syntax_errors Ошибки, возникшие из-за ссылок на неизвестные метки
+	\return Флаг, указывающий, возникли ли ошибки во время компоновки
+	*/
+	bool link(const std::vector<std::shared_ptr<Instr>>& instrs, const std::map<std::string, int>& labels, std::vector<SyntaxError>& syntax_errors) const;
+
+	/*!
+	Размещает данные инструкций "data" по фиксированным адресам в порядке их следования
+	и заменяет имена ячеек памяти в инструкциях "set", "ld" и "st" их адресами
+	\param[in] instrs Считанные инструкции
+	\param[out] data_addresses Адреса ячеек памяти по их именам
+	\param[out] memory_image Начальное содержимое памяти, начиная с нулевого адреса
+	\param[out] syntax_errors Ошибки, возникшие из-за повторяющихся или неизвестных имен ячеек памяти и нехватки памяти
+	\param[in] memory_size Количество ячеек памяти, в которые должны поместиться данные
+	\return Флаг, указывающий, возникли ли ошибки во время размещения данных
+	*/
+	bool layout_data(const std::vector<std::shared_ptr<Instr>>& instrs, std::map<std::string, int>& data_addresses, std::vector<int>& memory_image, std::vector<SyntaxError>& syntax_errors, int memory_size = DEFAULT_MEMORY_SIZE) const;
+
+	/*!
+	Записывает скомпонованные инструкции в байт-код
+	\param[in] instrs Скомпонованные инструкции с размещенными данными
+	\param[out] bytecode Байт-код
+	*/
+	void emit(const std::vector<std::shared_ptr<Instr>>& instrs, Bytecode& bytecode) const;
 };
\ No newline at end of file
@@ -0,0 +1,101 @@
+#include <string>
+
+#include "OutputBuffer.h"
+
+
+/*!
+Конструктор буфера вывода
+\param[in] port Порт, в который записывается вывод
+\param[in] buffering Режим буферизации
+\param[in] threshold Размер буфера в режиме BUFFERING::FULL
+*/
+OutputBuffer::OutputBuffer(IoPort& port, BUFFERING buffering, int threshold)
+	: port{ &port }, buffering{ buffering }, threshold{ threshold } {
+}
+
+/*!
+Деструктор буфера вывода, записывающий оставшиеся данные в порт
+*/
+OutputBuffer::~OutputBuffer() {
+	flush();
+}
+
+/*!
+Меняет режим буферизации. Накопленные данные предварительно записываются в порт
+\param[in] new_buffering Режим буферизации
+\param[in] new_threshold Размер буфера в режиме BUFFERING::FULL
+*/
+void OutputBuffer::set_buffering(BUFFERING new_buffering, int new_threshold) {
+	flush();
+	buffering = new_buffering;
+	threshold = new_threshold;
+}
+
+/*!
+Меняет порт вывода. Накопленные данные предварительно записываются в прежний порт
+\param[in] new_port Порт, в который записывается вывод
+*/
+void OutputBuffer::set_port(IoPort& new_port) {
+	flush();
+	port = &new_port;
+}
+
+/*!
+Сбрасывает буфер, если этого требует режим буферизации
+\param[in] has_new_line Флаг, была ли записана новая строка
+*/
+void OutputBuffer::flush_if_needed(bool has_new_line) {
+	switch (buffering) {
+	case BUFFERING::NONE:
+		flush();
+		break;
+	case BUFFERING::LINE:
+		if (has_new_line) {
+			flush();
+		}
+		break;
+	case BUFFERING::FULL:
+		if (buffer.size() >= threshold) {
+			flush();
+		}
+		break;
+	}
+}
+
+/*!
+Записывает строку
+\param[in] str Строка
+*/
+void OutputBuffer::write(const std::string& str) {
+	buffer += str;
+	flush_if_needed(str.find('\n') != std::string::npos);
+}
+
+/*!
+Записывает символ
+\param[in] ch Символ
+*/
+void OutputBuffer::write(char ch) {
+	buffer += ch;
+	flush_if_needed(ch == '\n');
+}
+
+/*!
+Записывает целое число в десятичной записи
+\param[in] value Число
+*/
+void OutputBuffer::write(int value) {
+	buffer += std::to_string(value);
+	flush_if_needed(false);
+}
+
+/*!
+Записывает накопленные данные в порт и сбрасывает его
+*/
+void OutputBuffer::flush() {
+	if (!buffer.empty()) {
+		port->write(buffer.data(), buffer.size());
+		buffer.clear();
+	}
+	port->flush();
+}
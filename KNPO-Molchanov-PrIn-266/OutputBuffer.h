@@ -0,0 +1,92 @@
+#pragma once
+
+#include <string>
+
+#include "IoPort.h"
+
+/// Размер буфера вывода по умолчанию в байтах
+const int DEFAULT_OUTPUT_BUFFER_SIZE = 64 * 1024;
+
+/// Режимы буферизации вывода программы
+enum class BUFFERING {
+	NONE, ///< Вывод сбрасывается после каждой записи
+	LINE, ///< Вывод сбрасывается после каждой записанной строки
+	FULL, ///< Вывод сбрасывается при заполнении буфера, перед чтением ввода и по завершении программы
+};
+
+/*!
+Буфер вывода программы на псевдо-ассемблере
+*/
+class OutputBuffer {
+private:
+	/// Порт, в который записывается вывод
+	IoPort* port;
+
+	/// Режим буферизации
+	BUFFERING buffering;
+
+	/// Размер буфера, при достижении которого он сбрасывается в режиме BUFFERING::FULL
+	int threshold;
+
+	/// Ещё не записанные в поток данные
+	std::string buffer;
+
+	/*!
+	Сбрасывает буфер, если этого требует режим буферизации
+	\param[in] has_new_line Флаг, была ли записана новая строка
+	*/
+	void flush_if_needed(bool has_new_line);
+
+public:
+	/*!
+	Конструктор буфера вывода
+	\param[in] port Порт, в который записывается вывод
+	\param[in] buffering Режим буферизации
+	\param[in] threshold Размер буфера в режиме BUFFERING::FULL
+	*/
+	OutputBuffer(IoPort& port, BUFFERING buffering = BUFFERING::FULL, int threshold = DEFAULT_OUTPUT_BUFFER_SIZE);
+
+	OutputBuffer(const OutputBuffer&) = delete;
+	OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+	/*!
+	Деструктор буфера вывода, записывающий оставшиеся данные в порт
+	*/
+	~OutputBuffer();
+
+	/*!
+	Меняет режим буферизации. Накопленные данные предварительно записываются в порт
+	\param[in] new_buffering Режим буферизации
+	\param[in] new_threshold Размер буфера в режиме BUFFERING::FULL
+	*/
+	void set_buffering(BUFFERING new_buffering, int new_threshold = DEFAULT_OUTPUT_BUFFER_SIZE);
+
+	/*!
+	Меняет порт вывода. Накопленные данные предварительно записываются в прежний порт
+	\param[in] new_port Порт, в который записывается вывод
+	*/
+	void set_port(IoPort& new_port);
+
+	/*!
+	Записывает строку
+	\param[in] str Строка
+	*/
+	void write(const std::string& str);
+
+	/*!
+	Записывает символ
+	\param[in] ch Символ
+	*/
+	void write(char ch);
+
+	/*!
+	Записывает целое число в десятичной записи
+	\param[in] value Число
+	*/
+	void write(int value);
+
+	/*!
+	Записывает накопленные данные в порт и сбрасывает его
+	*/
+	void flush();
+};
@@ -0,0 +1,238 @@
+#include <vector>
+#include <map>
+#include <string>
+#include <string_view>
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+
+#include "Profiler.h"
+#include "Builtins.h"
+
+
+/*!
+Конструктор профилировщика
+\param[in] instrs Инструкции программы
+*/
+Profiler::Profiler(const std::vector<std::shared_ptr<Instr>>& instrs)
+	: instr_hits(instrs.size(), 0), instr_nanoseconds(instrs.size(), 0),
+	line_numbers(instrs.size()), builtin_names(instrs.size()), subroutine_names(instrs.size()) {
+	for (int i = 0; i < instrs.size(); i++) {
+		line_numbers[i] = instrs[i]->get_line_number();
+
+		// Вызываемые подпрограммы определяются заранее, чтобы не проверять тип инструкции на каждом шаге
+		CallInstr* call_instr = dynamic_cast<CallInstr*>(instrs[i].get());
+		if (call_instr != nullptr) {
+			if (call_instr->is_builtin()) {
+				builtin_names[i] = BuiltinRegistry::instance().get_name(call_instr->get_builtin_id());
+			}
+			else {
+				subroutine_names[i] = call_instr->get_subroutine_name();
+			}
+		}
+	}
+}
+
+/*!
+Выполняет инструкции, пока программа не завершится, и считает их выполнения
+\param[in] instrs Инструкции программы
+\param[in|out] state Состояние программы
+\throw RuntimeError В случае ошибки выполнения. Индекс инструкции, вызвавшей ошибку, сохраняется в состоянии программы
+*/
+void Profiler::execute(const std::vector<std::shared_ptr<Instr>>& instrs, ProgramState& state) {
+	while (state.is_running()) {
+		int pc = state.get_pc();
+		instr_hits[pc]++;
+
+		auto start = std::chrono::steady_clock::now();
+		instrs[pc]->execute(state);
+		auto finish = std::chrono::steady_clock::now();
+
+		instr_nanoseconds[pc] += std::chrono::duration_cast<std::chrono::nanoseconds>(finish - start).count();
+	}
+}
+
+/*!
+Собирает счетчики инструкций по строкам
+\return Счетчики для каждой выполнявшейся строки
+*/
+std::map<int, ProfileCounter> Profiler::get_line_counters() const {
+	std::map<int, ProfileCounter> counters;
+
+	for (int i = 0; i < instr_hits.size(); i++) {
+		if (instr_hits[i] > 0) {
+			ProfileCounter& counter = counters[line_numbers[i]];
+			counter.hits += instr_hits[i];
+			counter.nanoseconds += instr_nanoseconds[i];
+		}
+	}
+
+	return counters;
+}
+
+/*!
+Собирает счетчики инструкций "call" по именам вызываемых подпрограмм
+\param[in] names Имена подпрограмм для каждой инструкции
+\return Счетчики для каждой вызывавшейся подпрограммы
+*/
+std::map<std::string, ProfileCounter> Profiler::get_call_counters(const std::vector<std::string>& names) const {
+	std::map<std::string, ProfileCounter> counters;
+
+	for (int i = 0; i < instr_hits.size(); i++) {
+		if (instr_hits[i] > 0 && !names[i].empty()) {
+			ProfileCounter& counter = counters[names[i]];
+			counter.hits += instr_hits[i];
+			counter.nanoseconds += instr_nanoseconds[i];
+		}
+	}
+
+	return counters;
+}
+
+/*!
+Сортирует счетчики по убыванию времени выполнения
+\param[in] counters Счетчики
+\return Пары ключ-счетчик, отсортированные по убыванию времени
+*/
+template <typename Key>
+static std::vector<std::pair<Key, ProfileCounter>> sort_by_time(const std::map<Key, ProfileCounter>& counters) {
+	std::vector<std::pair<Key, ProfileCounter>> sorted(counters.begin(), counters.end());
+	std::stable_sort(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) {
+		return a.second.nanoseconds > b.second.nanoseconds;
+	});
+	return sorted;
+}
+
+/*!
+Выводит отчет: самые затратные строки, встроенные подпрограммы и вызовы подпрограмм пользователя
+\param[out] output Поток вывода
+\param[in] source Текст программы, строки которого приводятся в отчете
+*/
+void Profiler::write_report(std::ostream& output, std::string_view source) const {
+	// Строки текста программы, без начальных пробелов и символа возврата каретки
+	std::vector<std::string_view> source_lines;
+	size_t line_start = 0;
+	while (line_start < source.size()) {
+		size_t line_end = std::min(source.find('\n', line_start), source.size());
+		std::string_view line = source.substr(line_start, line_end - line_start);
+		line.remove_prefix(std::min(line.find_first_not_of(" \t"), line.size()));
+		if (!line.empty() && line.back() == '\r') {
+			line.remove_suffix(1);
+		}
+		source_lines.push_back(line);
+		line_start = line_end + 1;
+	}
+
+	long long total_hits = 0;
+	long long total_nanoseconds = 0;
+	for (int i = 0; i < instr_hits.size(); i++) {
+		total_hits += instr_hits[i];
+		total_nanoseconds += instr_nanoseconds[i];
+	}
+
+	output << "Выполнено инструкций: " << total_hits << ", время: " << total_nanoseconds / 1000 << " мкс" << std::endl;
+
+	output << std::endl << "Самые затратные строки:" << std::endl;
+	std::vector<std::pair<int, ProfileCounter>> lines = sort_by_time(get_line_counters());
+	for (int i = 0; i < lines.size() && i < PROFILE_REPORT_LINES; i++) {
+		int line_number = lines[i].first;
+		const ProfileCounter& counter = lines[i].second;
+		double percent = total_nanoseconds > 0 ? 100.0 * counter.nanoseconds / total_nanoseconds : 0;
+
+		output << "  Строка " << std::setw(6) << std::left << line_number << std::right
+			<< std::setw(12) << counter.hits << " раз "
+			<< std::setw(12) << counter.nanoseconds << " нс "
+			<< std::setw(6) << std::fixed << std::setprecision(1) << percent << "%  "
+			<< (line_number - 1 < source_lines.size() ? source_lines[line_number - 1] : "") << std::endl;
+	}
+
+	std::vector<std::pair<std::string, ProfileCounter>> builtins = sort_by_time(get_call_counters(builtin_names));
+	if (!builtins.empty()) {
+		output << std::endl << "Встроенные подпрограммы:" << std::endl;
+		for (const auto& builtin : builtins) {
+			output << "  " << std::setw(10) << std::left << builtin.first << std::right
+				<< std::setw(12) << builtin.second.hits << " вызовов "
+				<< std::setw(12) << builtin.second.nanoseconds << " нс" << std::endl;
+		}
+	}
+
+	std::map<std::string, ProfileCounter> subroutine_counters = get_call_counters(subroutine_names);
+	std::vector<std::pair<std::string, ProfileCounter>> subroutines(subroutine_counters.begin(), subroutine_counters.end());
+	std::stable_sort(subroutines.begin(), subroutines.end(), [](const auto& a, const auto& b) {
+		return a.second.hits > b.second.hits;
+	});
+	if (!subroutines.empty()) {
+		output << std::endl << "Подпрограммы:" << std::endl;
+		for (const auto& subroutine : subroutines) {
+			output << "  " << std::setw(10) << std::left << subroutine.first << std::right
+				<< std::setw(12) << subroutine.second.hits << " вызовов" << std::endl;
+		}
+	}
+}
+
+/*!
+Выводит счетчики в формате JSON
+\param[out] output Поток вывода
+*/
+void Profiler::write_json(std::ostream& output) const {
+	output << "{" << std::endl;
+
+	output << "  \"instructions\": [";
+	for (int i = 0; i < instr_hits.size(); i++) {
+		output << (i == 0 ? "" : ",") << std::endl << "    { \"index\": " << i
+			<< ", \"line\": " << line_numbers[i]
+			<< ", \"hits\": " << instr_hits[i]
+			<< ", \"nanoseconds\": " << instr_nanoseconds[i] << " }";
+	}
+	output << std::endl << "  ]," << std::endl;
+
+	output << "  \"lines\": [";
+	bool first = true;
+	for (const auto& line : get_line_counters()) {
+		output << (first ? "" : ",") << std::endl << "    { \"line\": " << line.first
+			<< ", \"hits\": " << line.second.hits
+			<< ", \"nanoseconds\": " << line.second.nanoseconds << " }";
+		first = false;
+	}
+	output << std::endl << "  ]," << std::endl;
+
+	// Имена подпрограмм являются идентификаторами, поэтому экранировать их не нужно
+	const std::pair<const char*, const std::vector<std::string>*> sections[] = {
+		{ "builtins", &builtin_names },
+		{ "subroutines", &subroutine_names },
+	};
+	for (int s = 0; s < 2; s++) {
+		output << "  \"" << sections[s].first << "\": [";
+		first = true;
+		for (const auto& call : get_call_counters(*sections[s].second)) {
+			output << (first ? "" : ",") << std::endl << "    { \"name\": \"" << call.first
+				<< "\", \"calls\": " << call.second.hits
+				<< ", \"nanoseconds\": " << call.second.nanoseconds << " }";
+			first = false;
+		}
+		output << std::endl << "  ]" << (s == 0 ? "," : "") << std::endl;
+	}
+
+	output << "}" << std::endl;
+}
+
+/*!
+Выводит счетчики в формате CSV со столбцами section, name, hits, nanoseconds
+\param[out] output Поток вывода
+*/
+void Profiler::write_csv(std::ostream& output) const {
+	output << "section,name,hits,nanoseconds" << std::endl;
+
+	for (int i = 0; i < instr_hits.size(); i++) {
+		output << "instruction," << i << "," << instr_hits[i] << "," << instr_nanoseconds[i] << std::endl;
+	}
+	for (const auto& line : get_line_counters()) {
+		output << "line," << line.first << "," << line.second.hits << "," << line.second.nanoseconds << std::endl;
+	}
+	for (const auto& call : get_call_counters(builtin_names)) {
+		output << "builtin," << call.first << "," << call.second.hits << "," << call.second.nanoseconds << std::endl;
+	}
+	for (const auto& call : get_call_counters(subroutine_names)) {
+		output << "subroutine," << call.first << "," << call.second.hits << "," << call.second.nanoseconds << std::endl;
+	}
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <vector>
+#include <map>
+#include <string>
+#include <string_view>
+#include <memory>
+#include <ostream>
+
+#include "Instruction.h"
+#include "ProgramState.h"
+
+/// Количество самых затратных строк в отчете профилировщика
+const int PROFILE_REPORT_LINES = 20;
+
+/*!
+Счетчики профилировщика для одной строки, встроенной подпрограммы или подпрограммы пользователя
+*/
+struct ProfileCounter {
+	/// Количество выполнений или вызовов
+	long long hits = 0;
+	/// Суммарное время выполнения в наносекундах
+	long long nanoseconds = 0;
+};
+
+/*!
+\brief Профилировщик программы на псевдо-ассемблере
+
+Выполняет инструкции так же, как Interpreter с ENGINE::INSTR, но считает, сколько раз
+выполнилась каждая инструкция и сколько времени это заняло. Быстрые способы выполнения
+профилировщиком не затрагиваются, поэтому без профилирования программа не тратит на него времени
+*/
+class Profiler {
+private:
+	/// Количество выполнений каждой инструкции
+	std::vector<long long> instr_hits;
+
+	/// Время выполнения каждой инструкции в наносекундах
+	std::vector<long long> instr_nanoseconds;
+
+	/// Номер строки каждой инструкции
+	std::vector<int> line_numbers;
+
+	/// Имя вызываемой встроенной подпрограммы для инструкций "call" или пустая строка
+	std::vector<std::string> builtin_names;
+
+	/// Имя вызываемой подпрограммы пользователя для инструкций "call" или пустая строка
+	std::vector<std::string> subroutine_names;
+
+	/*!
+	Собирает счетчики инструкций по строкам
+	\return Счетчики для каждой выполнявшейся строки
+	*/
+	std::map<int, ProfileCounter> get_line_counters() const;
+
+	/*!
+	Собирает счетчики инструкций "call" по именам вызываемых подпрограмм
+	\param[in] names Имена подпрограмм для каждой инструкции
+	\return Счетчики для каждой вызывавшейся подпрограммы
+	*/
+	std::map<std::string, ProfileCounter> get_call_counters(const std::vector<std::string>& names) const;
+
+public:
+	/*!
+	Конструктор профилировщика
+	\param[in] instrs Инструкции программы
+	*/
+	Profiler(const std::vector<std::shared_ptr<Instr>>& instrs);
+
+	/*!
+	Выполняет инструкции, пока программа не завершится, и считает их выполнения
+	\param[in] instrs Инструкции программы
+	\param[in|out] state Состояние программы
+	\throw RuntimeError В случае ошибки выполнения. Индекс инструкции, вызвавшей ошибку, сохраняется в состоянии программы
+	*/
+	void execute(const std::vector<std::shared_ptr<Instr>>& instrs, ProgramState& state);
+
+	/*!
+	Выводит отчет: самые затратные строки, встроенные подпрограммы и вызовы подпрограмм пользователя
+	\param[out] output Поток вывода
+	\param[in] source Текст программы, строки которого приводятся в отчете
+	*/
+	void write_report(std::ostream& output, std::string_view source) const;
+
+	/*!
+	Выводит счетчики в формате JSON
+	\param[out] output Поток вывода
+	*/
+	void write_json(std::ostream& output) const;
+
+	/*!
+	Выводит счетчики в формате CSV со столбцами section, name, hits, nanoseconds
+	\param[out] output Поток вывода
+	*/
+	void write_csv(std::ostream& output) const;
+};
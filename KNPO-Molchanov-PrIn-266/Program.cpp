@@ -0,0 +1,39 @@
+#include <utility>
+
+#include "Program.h"
+#include "BytecodeEngine.h"
+
+
+/*!
+Конструктор программы
+\param[in] program Результат трансляции. Его содержимое переносится в программу
+*/
+Program::Program(TranslatedProgram&& program)
+	: instrs{ std::move(program.instrs) }, labels{ std::move(program.labels) },
+	data_addresses{ std::move(program.data_addresses) }, memory_image{ std::move(program.memory_image) },
+	bytecode{ std::move(program.bytecode) } {
+	// Объединение инструкций байт-кода не меняет их индексы, поэтому номера строк байт-кода и инструкций совпадают
+	if (bytecode.size() > 0) {
+		line_numbers.resize(bytecode.size());
+		for (int i = 0; i < bytecode.size(); i++) {
+			line_numbers[i] = bytecode.get_line_number(i);
+		}
+
+		threaded_code = BytecodeEngine::decode_threaded(bytecode);
+	}
+	else {
+		line_numbers.resize(instrs.size());
+		for (int i = 0; i < instrs.size(); i++) {
+			line_numbers[i] = instrs[i]->get_line_number();
+		}
+	}
+}
+
+/*!
+Возвращает номер строки исходного текста, на которой записана инструкция
+\param[in] index Индекс инструкции
+\return Номер строки
+*/
+int Program::get_line_number(int index) const {
+	return line_numbers.at(index);
+}
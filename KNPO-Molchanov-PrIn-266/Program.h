@@ -0,0 +1,140 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+
+#include "Instruction.h"
+#include "Bytecode.h"
+
+/*!
+Результат трансляции программы, который заполняют транслятор, компоновщик,
+размещение данных, запись байт-кода и загрузка двоичного образа.
+После заполнения переносится в неизменяемый Program
+*/
+struct TranslatedProgram {
+	/// Инструкции
+	std::vector<std::shared_ptr<Instr>> instrs;
+	/// Индексы инструкций по именам меток
+	std::map<std::string, int> labels;
+	/// Адреса ячеек памяти по их именам
+	std::map<std::string, int> data_addresses;
+	/// Начальное содержимое памяти, начиная с нулевого адреса
+	std::vector<int> memory_image;
+	/// Байт-код. Пуст, если инструкции выполняются через Instr::execute
+	Bytecode bytecode;
+
+	/*!
+	Возвращает количество инструкций программы
+	\return Количество инструкций
+	*/
+	int size() const {
+		return instrs.empty() ? bytecode.size() : instrs.size();
+	}
+};
+
+/*!
+\brief Оттранслированная программа
+
+Владеет инструкциями, байт-кодом, таблицами меток и адресов данных, начальным
+содержимым памяти и таблицей номеров строк. После создания не изменяется,
+поэтому её одновременно выполняют несколько потоков, а каждое состояние
+программы ProgramState хранит только то, что меняется при выполнении
+*/
+class Program {
+private:
+	/// Инструкции
+	std::vector<std::shared_ptr<Instr>> instrs;
+
+	/// Индексы инструкций по именам меток
+	std::map<std::string, int> labels;
+
+	/// Адреса ячеек памяти по их именам
+	std::map<std::string, int> data_addresses;
+
+	/// Начальное содержимое памяти, начиная с нулевого адреса
+	std::vector<int> memory_image;
+
+	/// Байт-код. Пуст, если инструкции выполняются через Instr::execute
+	Bytecode bytecode;
+
+	/// Шитый код байт-кода, декодированный один раз для всех запусков программы
+	ThreadedCode threaded_code;
+
+	/// Номера строк исходного текста по индексам инструкций
+	std::vector<int> line_numbers;
+
+public:
+	/*!
+	Конструктор программы
+	\param[in] program Результат трансляции. Его содержимое переносится в программу
+	*/
+	explicit Program(TranslatedProgram&& program);
+
+	Program(const Program&) = delete;
+	Program& operator=(const Program&) = delete;
+
+	/*!
+	Возвращает количество инструкций программы
+	\return Количество инструкций
+	*/
+	int size() const {
+		return line_numbers.size();
+	}
+
+	/*!
+	Возвращает инструкции программы
+	\return Инструкции. Пусты, если программа загружена из двоичного образа
+	*/
+	const std::vector<std::shared_ptr<Instr>>& get_instrs() const {
+		return instrs;
+	}
+
+	/*!
+	Возвращает индексы инструкций по именам меток
+	\return Таблица меток
+	*/
+	const std::map<std::string, int>& get_labels() const {
+		return labels;
+	}
+
+	/*!
+	Возвращает адреса ячеек памяти по их именам
+	\return Таблица адресов данных
+	*/
+	const std::map<std::string, int>& get_data_addresses() const {
+		return data_addresses;
+	}
+
+	/*!
+	Возвращает начальное содержимое памяти
+	\return Содержимое памяти, начиная с нулевого адреса
+	*/
+	const std::vector<int>& get_memory_image() const {
+		return memory_image;
+	}
+
+	/*!
+	Возвращает байт-код программы
+	\return Байт-код. Пуст, если инструкции выполняются через Instr::execute
+	*/
+	const Bytecode& get_bytecode() const {
+		return bytecode;
+	}
+
+	/*!
+	Возвращает шитый код байт-кода программы
+	\return Шитый код. Пуст, если байт-код пуст или прямой шитый код не поддерживается
+	*/
+	const ThreadedCode& get_threaded_code() const {
+		return threaded_code;
+	}
+
+	/*!
+	Возвращает номер строки исходного текста, на которой записана инструкция
+	\param[in] index Индекс инструкции
+	\return Номер строки
+	*/
+	int get_line_number(int index) const;
+};
@@ -0,0 +1,376 @@
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <map>
+#include <ostream>
+#include <utility>
+
+#include "ProgramImage.h"
+#include "Builtins.h"
+
+
+/*!
+Конструктор ошибки
+\param[in] m Сообщение об ошибке
+*/
+ImageError::ImageError(const std::string& m) {
+	msg = m;
+}
+
+/*!
+Возвращает сообщение об ошибке
+\return Сообщение об ошибке
+*/
+std::string ImageError::what() const {
+	return msg;
+}
+
+/*!
+Вычисляет контрольную сумму FNV-1a
+\param[in] data Данные
+\return Контрольная сумма
+*/
+static uint32_t checksum(std::string_view data) {
+	uint32_t hash = 2166136261u;
+	for (char ch : data) {
+		hash ^= (uint8_t)ch;
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+/*!
+Дописывает 32-битное число в порядке байтов little-endian
+\param[out] output Данные
+\param[in] value Число
+*/
+static void put_u32(std::string& output, uint32_t value) {
+	for (int i = 0; i < 4; i++) {
+		output += (char)((value >> (8 * i)) & 0xFF);
+	}
+}
+
+/*!
+Дописывает строку: длину и символы
+\param[out] output Данные
+\param[in] str Строка
+*/
+static void put_string(std::string& output, const std::string& str) {
+	put_u32(output, str.size());
+	output += str;
+}
+
+/*!
+Возвращает поле инструкции, в котором записан идентификатор встроенной подпрограммы
+\param[in] instr Инструкция
+\return Указатель на поле или nullptr, если инструкция не вызывает встроенную подпрограмму
+*/
+static int32_t* builtin_id_field(BytecodeInstr& instr) {
+	switch (instr.opcode) {
+	case OPCODE::CALL_BUILTIN:
+		return &instr.imm_value;
+	case OPCODE::SET_MEM_CALL:
+	case OPCODE::LD_CALL:
+		return &instr.address;
+	default:
+		return nullptr;
+	}
+}
+
+/*!
+Проверяет, начинаются ли данные с сигнатуры образа программы
+\param[in] data Данные
+\return Флаг, является ли data образом программы
+*/
+bool ProgramImage::is_image(std::string_view data) {
+	return data.size() >= sizeof(PROGRAM_IMAGE_MAGIC)
+		&& std::memcmp(data.data(), PROGRAM_IMAGE_MAGIC, sizeof(PROGRAM_IMAGE_MAGIC)) == 0;
+}
+
+/*!
+Записывает образ программы
+\param[in] program Оттранслированная программа с записанным байт-кодом
+\param[out] output Поток вывода
+*/
+void ProgramImage::write(const TranslatedProgram& program, std::ostream& output) {
+	const Bytecode& bytecode = program.bytecode;
+	std::string payload;
+
+	// Идентификаторы встроенных подпрограмм зависят от порядка их регистрации,
+	// поэтому в образ записываются имена, а в инструкции - номера имен
+	std::vector<std::string> builtin_names;
+	std::map<int, int> builtin_indices;
+
+	put_u32(payload, bytecode.size());
+	for (int i = 0; i < bytecode.size(); i++) {
+		BytecodeInstr instr = bytecode.get_instr(i);
+
+		int32_t* builtin_id = builtin_id_field(instr);
+		if (builtin_id != nullptr) {
+			auto found = builtin_indices.find(*builtin_id);
+			if (found == builtin_indices.end()) {
+				found = builtin_indices.emplace(*builtin_id, builtin_names.size()).first;
+				builtin_names.push_back(BuiltinRegistry::instance().get_name(*builtin_id));
+			}
+			*builtin_id = found->second;
+		}
+
+		payload += (char)instr.opcode;
+		payload += (char)instr.dest;
+		payload += (char)instr.src1;
+		payload += (char)instr.src2;
+		put_u32(payload, instr.imm_value);
+		put_u32(payload, instr.address);
+	}
+	for (int i = 0; i < bytecode.size(); i++) {
+		put_u32(payload, bytecode.get_line_number(i));
+	}
+
+	put_u32(payload, builtin_names.size());
+	for (const auto& name : builtin_names) {
+		put_string(payload, name);
+	}
+
+	put_u32(payload, program.labels.size());
+	for (const auto& label : program.labels) {
+		put_string(payload, label.first);
+		put_u32(payload, label.second);
+	}
+
+	put_u32(payload, program.data_addresses.size());
+	for (const auto& data_address : program.data_addresses) {
+		put_string(payload, data_address.first);
+		put_u32(payload, data_address.second);
+	}
+
+	put_u32(payload, program.memory_image.size());
+	for (int value : program.memory_image) {
+		put_u32(payload, value);
+	}
+
+	std::string header(PROGRAM_IMAGE_MAGIC, sizeof(PROGRAM_IMAGE_MAGIC));
+	put_u32(header, PROGRAM_IMAGE_VERSION);
+	put_u32(header, checksum(payload));
+	put_u32(header, payload.size());
+
+	output.write(header.data(), header.size());
+	output.write(payload.data(), payload.size());
+}
+
+/*!
+Последовательное чтение содержимого образа с проверкой его границ
+*/
+class ImageReader {
+private:
+	/// Ещё не прочитанные данные
+	std::string_view data;
+
+public:
+	/*!
+	Конструктор
+	\param[in] data Данные
+	*/
+	ImageReader(std::string_view data) : data{ data } {
+	}
+
+	/*!
+	Читает байт
+	\return Байт
+	\throw ImageError В случае, если данные закончились
+	*/
+	uint8_t get_u8() {
+		if (data.empty()) {
+			throw ImageError("Образ программы поврежден");
+		}
+		uint8_t value = data[0];
+		data.remove_prefix(1);
+		return value;
+	}
+
+	/*!
+	Читает 32-битное число в порядке байтов little-endian
+	\return Число
+	\throw ImageError В случае, если данные закончились
+	*/
+	uint32_t get_u32() {
+		if (data.size() < 4) {
+			throw ImageError("Образ программы поврежден");
+		}
+		uint32_t value = 0;
+		for (int i = 0; i < 4; i++) {
+			value |= (uint32_t)(uint8_t)data[i] << (8 * i);
+		}
+		data.remove_prefix(4);
+		return value;
+	}
+
+	/*!
+	Читает количество элементов, каждый из которых занимает не меньше min_size байт
+	\param[in] min_size Наименьший размер элемента в байтах
+	\return Количество элементов
+	\throw ImageError В случае, если столько элементов в оставшихся данных не поместится
+	*/
+	int get_count(size_t min_size) {
+		uint32_t count = get_u32();
+		if (count > data.size() / min_size) {
+			throw ImageError("Образ программы поврежден");
+		}
+		return count;
+	}
+
+	/*!
+	Читает строку: длину и символы
+	\return Строка
+	\throw ImageError В случае, если данные закончились
+	*/
+	std::string get_string() {
+		int length = get_count(1);
+		std::string str(data.substr(0, length));
+		data.remove_prefix(length);
+		return str;
+	}
+
+	/*!
+	Проверяет, прочитаны ли все данные
+	\return Флаг, прочитаны ли все данные
+	*/
+	bool at_end() const {
+		return data.empty();
+	}
+};
+
+/*!
+Загружает программу из образа. Инструкции Instr не восстанавливаются,
+программа выполняется только байт-кодом
+\param[in] data Образ программы
+\param[out] program Программа
+\throw ImageError В случае, если образ поврежден, записан другой версией интерпретатора
+или ссылается на неизвестные встроенные подпрограммы
+*/
+void ProgramImage::read(std::string_view data, TranslatedProgram& program) {
+	if (!is_image(data) || data.size() < PROGRAM_IMAGE_HEADER_SIZE) {
+		throw ImageError("Файл не является образом программы");
+	}
+
+	ImageReader header(data.substr(sizeof(PROGRAM_IMAGE_MAGIC), PROGRAM_IMAGE_HEADER_SIZE - sizeof(PROGRAM_IMAGE_MAGIC)));
+	uint32_t version = header.get_u32();
+	uint32_t expected_checksum = header.get_u32();
+	uint32_t payload_size = header.get_u32();
+
+	if (version != PROGRAM_IMAGE_VERSION) {
+		throw ImageError("Образ программы записан другой версией интерпретатора (" + std::to_string(version)
+			+ ", ожидается " + std::to_string(PROGRAM_IMAGE_VERSION) + ")");
+	}
+
+	std::string_view payload = data.substr(PROGRAM_IMAGE_HEADER_SIZE);
+	if (payload.size() != payload_size || checksum(payload) != expected_checksum) {
+		throw ImageError("Образ программы поврежден");
+	}
+
+	ImageReader reader(payload);
+
+	int instr_count = reader.get_count(12);
+	std::vector<BytecodeInstr> instrs(instr_count);
+	for (auto& instr : instrs) {
+		uint8_t opcode = reader.get_u8();
+		if (opcode > (uint8_t)OPCODE::LDI_ADD_REG_STI) {
+			throw ImageError("Образ программы поврежден");
+		}
+		instr.opcode = (OPCODE)opcode;
+		instr.dest = reader.get_u8();
+		instr.src1 = reader.get_u8();
+		instr.src2 = reader.get_u8();
+		instr.imm_value = reader.get_u32();
+		instr.address = reader.get_u32();
+	}
+	std::vector<int> line_numbers(instr_count);
+	for (auto& line_number : line_numbers) {
+		line_number = reader.get_u32();
+	}
+
+	std::vector<int> builtin_ids(reader.get_count(4));
+	for (auto& builtin_id : builtin_ids) {
+		std::string name = reader.get_string();
+		builtin_id = BuiltinRegistry::instance().find(name);
+		if (builtin_id < 0) {
+			throw ImageError("Неизвестная встроенная подпрограмма \"" + name + "\"");
+		}
+	}
+
+	// Таблицы записаны в порядке возрастания имен, поэтому каждое имя вставляется в конец
+	int label_count = reader.get_count(8);
+	for (int i = 0; i < label_count; i++) {
+		std::string name = reader.get_string();
+		program.labels.emplace_hint(program.labels.end(), std::move(name), reader.get_u32());
+	}
+
+	int data_count = reader.get_count(8);
+	for (int i = 0; i < data_count; i++) {
+		std::string name = reader.get_string();
+		program.data_addresses.emplace_hint(program.data_addresses.end(), std::move(name), reader.get_u32());
+	}
+
+	program.memory_image.resize(reader.get_count(4));
+	for (auto& value : program.memory_image) {
+		value = reader.get_u32();
+	}
+
+	if (!reader.at_end()) {
+		throw ImageError("Образ программы поврежден");
+	}
+
+	// Исполнитель байт-кода не проверяет переходы и адреса данных, поэтому они проверяются здесь
+	int memory_image_size = program.memory_image.size();
+	for (int i = 0; i < instr_count; i++) {
+		BytecodeInstr& instr = instrs[i];
+		bool valid = true;
+
+		switch (instr.opcode) {
+		case OPCODE::JMP:
+		case OPCODE::JEQ:
+		case OPCODE::JNE:
+		case OPCODE::JGT:
+		case OPCODE::JLT:
+		case OPCODE::JGE:
+		case OPCODE::JLE:
+		case OPCODE::JEQ_IMM:
+		case OPCODE::JNE_IMM:
+		case OPCODE::JGT_IMM:
+		case OPCODE::JLT_IMM:
+		case OPCODE::JGE_IMM:
+		case OPCODE::JLE_IMM:
+		case OPCODE::CALL:
+		case OPCODE::SUB_IMM_JGT:
+			valid = instr.address >= 0 && instr.address <= instr_count;
+			break;
+		case OPCODE::SET_MEM:
+		case OPCODE::ST:
+		case OPCODE::SET_MEM_CALL:
+			valid = instr.imm_value >= 0 && instr.imm_value < memory_image_size;
+			break;
+		default:
+			break;
+		}
+
+		int32_t* builtin_id = builtin_id_field(instr);
+		if (builtin_id != nullptr) {
+			valid = valid && *builtin_id >= 0 && *builtin_id < builtin_ids.size();
+			if (valid) {
+				*builtin_id = builtin_ids[*builtin_id];
+			}
+		}
+
+		if (!valid) {
+			throw ImageError("Образ программы поврежден: недопустимая инструкция " + std::to_string(i));
+		}
+
+		try {
+			program.bytecode.emit(instr, line_numbers[i]);
+		}
+		catch (RuntimeError& err) {
+			throw ImageError("Образ программы поврежден: " + err.what());
+		}
+	}
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <ostream>
+
+#include "Interpreter.h"
+
+/// Сигнатура в начале образа программы
+const char PROGRAM_IMAGE_MAGIC[8] = { 'K', 'N', 'P', 'O', 'I', 'M', 'G', '\0' };
+
+/// Версия формата образа программы. Увеличивается при любом изменении формата или кодов операций байт-кода
+const uint32_t PROGRAM_IMAGE_VERSION = 5;
+
+/// Размер заголовка образа: сигнатура, версия, контрольная сумма и размер содержимого
+const size_t PROGRAM_IMAGE_HEADER_SIZE = sizeof(PROGRAM_IMAGE_MAGIC) + 3 * sizeof(uint32_t);
+
+/*!
+Класс, описывающий ошибку, возникающую в случае, если
+образ программы поврежден или записан другой версией интерпретатора
+*/
+class ImageError {
+private:
+	/// Сообщение об ошибке
+	std::string msg;
+
+public:
+	/*!
+	Конструктор ошибки
+	\param[in] m Сообщение об ошибке
+	*/
+	ImageError(const std::string& m);
+
+	/*!
+	Возвращает сообщение об ошибке
+	\return Сообщение об ошибке
+	*/
+	std::string what() const;
+};
+
+/*!
+\brief Двоичный образ оттранслированной программы
+
+Образ содержит байт-код после объединения инструкций, номера строк инструкций,
+таблицу меток, адреса и начальное содержимое памяти, а также имена вызываемых
+встроенных подпрограмм. Загрузка образа не требует разбора текста программы.
+
+Формат: заголовок (сигнатура, версия, контрольная сумма FNV-1a и размер содержимого)
+и содержимое из 32-битных чисел в порядке байтов little-endian и строк,
+записанных как длина и символы
+*/
+class ProgramImage {
+public:
+	/*!
+	Проверяет, начинаются ли данные с сигнатуры образа программы
+	\param[in] data Данные
+	\return Флаг, является ли data образом программы
+	*/
+	static bool is_image(std::string_view data);
+
+	/*!
+	Записывает образ программы
+	\param[in] program Оттранслированная программа с записанным байт-кодом
+	\param[out] output Поток вывода
+	*/
+	static void write(const TranslatedProgram& program, std::ostream& output);
+
+	/*!
+	Загружает программу из образа. Инструкции Instr не восстанавливаются,
+	программа выполняется только байт-кодом
+	\param[in] data Образ программы
+	\param[out] program Программа
+	\throw ImageError В случае, если образ поврежден, записан другой версией интерпретатора
+	или ссылается на неизвестные встроенные подпрограммы
+	*/
+	static void read(std::string_view data, TranslatedProgram& program);
+};
@@ -1,7 +1,10 @@
 #include <iostream>
 #include <string>
+#include <algorithm>
 
 #include "ProgramState.h"
+#include "Builtins.h"
+#include "Program.h"
 
 
 RuntimeError::RuntimeError(const std::string& m) {
@@ -13,9 +16,38 @@ std::string RuntimeError::what() const {
 }
 
 
-ProgramState::ProgramState(int n) {
+/*!
+Конструктор состояния программы
+\param[in] instr_count Количество инструкций
+\param[in] memory_size Количество ячеек памяти
+\param[in] memory_mode Способ выделения памяти
+\param[in] stack_size Размер сегмента стека. Сегмент размещается при первом обращении к стеку
+\throw RuntimeError В случае, если память не удалось выделить
+*/
+ProgramState::ProgramState(int n, int memory_size, MEMORY_MODE memory_mode, int stack_size) : stack_size{ stack_size } {
 	instr_count = n;
 	set_pc(0);
+
+	if (!memory.allocate(memory_size, memory_mode)) {
+		throw RuntimeError("Не удалось выделить память размером " + std::to_string(memory_size));
+	}
+}
+
+/*!
+Конструктор состояния для выполнения программы. Таблицы меток и адресов данных
+не копируются, а в память загружается только начальное содержимое памяти программы.
+Сегмент стека не резервируется заранее, а размещается за данными при первом обращении
+к стеку, поэтому программа, не использующая стек, получает всю память под данные
+\param[in] program Программа. Должна существовать, пока существует состояние
+\param[in] memory_size Количество ячеек памяти
+\param[in] memory_mode Способ выделения памяти
+\param[in] stack_size Размер сегмента стека
+\throw RuntimeError В случае, если память не удалось выделить или данные программы не помещаются в неё
+*/
+ProgramState::ProgramState(const Program& program, int memory_size, MEMORY_MODE memory_mode, int stack_size)
+	: ProgramState(program.size(), memory_size, memory_mode, stack_size) {
+	this->program = &program;
+	load_memory_image(program.get_memory_image(), {});
 }
 
 /*!
@@ -23,29 +55,66 @@ ProgramState::ProgramState(int n) {
 \param[in] address Адрес для проверки
 */
 void ProgramState::check_memory_address(int address) {
-	if (address < 0 || address >= MEMORY_SIZE) {
+	if (address < 0 || address >= memory.get_size()) {
 		throw RuntimeError("Недопустимый адрес \"" + std::to_string(address) + "\"");
 	}
 }
 
 /*!
-Проверяет, может ли использоваться имя в качестве допустимого имени метки
-\param[in] label_name Имя для проверки
+Проверяет адрес и подключает память до него, если она ещё не подключена
+\param[in] address Адрес
+\throw RuntimeError В случае, если адрес недопустим или память не удалось подключить
+*/
+void ProgramState::commit_memory_address(int address) {
+	check_memory_address(address);
+
+	if (!memory.commit(address + 1)) {
+		throw RuntimeError("Не удалось подключить память по адресу \"" + std::to_string(address) + "\"");
+	}
+}
+
+/*!
+Ищет метку среди объявленных при выполнении, а затем в таблице меток программы
+\param[in] label_name Имя метки
+\return Индекс инструкции
+\throw RuntimeError В случае, если метка неизвестна
 */
-void ProgramState::check_label_name(const std::string& label_name) {
-	if (labels.count(label_name) == 0) {
-		throw RuntimeError("Неизвестная метка \"" + label_name + "\"");
+int ProgramState::find_label(const std::string& label_name) const {
+	auto label = labels.find(label_name);
+	if (label != labels.end()) {
+		return label->second;
 	}
+
+	if (program != nullptr) {
+		label = program->get_labels().find(label_name);
+		if (label != program->get_labels().end()) {
+			return label->second;
+		}
+	}
+
+	throw RuntimeError("Неизвестная метка \"" + label_name + "\"");
 }
 
 /*!
-Проверяет, может ли использоваться имя в качестве допустимого имени ячейки памяти
-\param[in] label_name Имя для проверки
+Ищет ячейку памяти среди объявленных при выполнении, а затем в таблице адресов данных программы
+\param[in] data_label_name Имя ячейки памяти
+\return Адрес ячейки памяти
+\throw RuntimeError В случае, если имя ячейки памяти неизвестно
 */
-void ProgramState::check_data_label_name(const std::string& data_label_name) {
-	if (data_labels.count(data_label_name) == 0) {
-		throw RuntimeError("Неизвестное имя ячейки памяти \"" + data_label_name + "\"");
+int ProgramState::find_data_label(const std::string& data_label_name) const {
+	auto data_label = data_labels.find(data_label_name);
+	if (data_label != data_labels.end()) {
+		return data_label->second;
 	}
+
+	if (program != nullptr) {
+		data_label = program->get_data_addresses().find(data_label_name);
+		if (data_label != program->get_data_addresses().end()) {
+			return data_label->second;
+		}
+	}
+
+	throw RuntimeError("Неизвестное имя ячейки памяти \"" + data_label_name + "\"");
 }
 
 /*!
@@ -66,32 +135,13 @@ bool ProgramState::is_running() const {
 	return pc < instr_count;
 }
 
-/*!
-Возвращает значение регистра
-\param[in] r Регистр
-\return Значение регистра
-*/
-int ProgramState::get_register_value(REGISTER r) const {
-	return registers.at((int)r);
-}
-
-/*!
-Устанавливает значение регистра
-\param[in] r Регистр
-\param[in] value Значение
-*/
-void ProgramState::set_register_value(REGISTER r, int value) {
-	registers[(int)r] = value;
-}
-
 /*!
 Возвращает значение из памяти по имени
 \param[in] name Имя
 \return Значение из памяти по имени
 */
 int ProgramState::get_address_of_data_label(const std::string& name) {
-	check_data_label_name(name);
-	return data_labels.at(name);
+	return find_data_label(name);
 }
 
 /*!
@@ -100,8 +150,7 @@ int ProgramState::get_address_of_data_label(const std::string& name) {
 \return Значение из памяти по имени
 */
 int ProgramState::get_memory_value_by_name(const std::string& name) {
-	check_data_label_name(name);
-	return memory[data_labels.at(name)];
+	return get_memory_value(find_data_label(name));
 }
 
 /*!
@@ -110,28 +159,7 @@ int ProgramState::get_memory_value_by_name(const std::string& name) {
 \param[in] value Значение
 */
 void ProgramState::set_memory_value_by_name(const std::string& name, int value) {
-	check_data_label_name(name);
-	data_labels[name] = value;
-}
-
-/*!
-Возвращает значение из памяти по адресу
-\param[in] value Адрес
-\return Значение из памяти по адресу
-*/
-int ProgramState::get_memory_value(int address) {
-	check_memory_address(address);
-	return memory[address];
-}
-
-/*!
-Устанавливает значение в памяти по адресу
-\param[in] address Адрес
-\param[in] value Значение
-*/
-void ProgramState::set_memory_value(int address, int value) {
-	check_memory_address(address);
-	memory[address] = value;
+	set_memory_value(find_data_label(name), value);
 }
 
 /*!
@@ -140,17 +168,17 @@ void ProgramState::set_memory_value(int address, int value) {
 \return Адрес метки
 */
 int ProgramState::get_label_address(const std::string& label_name) {
-	check_label_name(label_name);
-	return labels.at(label_name);
+	return find_label(label_name);
 }
 
 /*!
-Добавляет новую метку
+Добавляет новую метку, объявленную при выполнении
 \param[in] label_name Имя метки
 \param[in] address Адрес метки
 */
 void ProgramState::add_label(const std::string& label_name, int address) {
 	labels[label_name] = address;
+	labels_changed = true;
 }
 
 /*!
@@ -185,7 +213,7 @@ void ProgramState::extract_string(std::string& str, int address) {
 	str = "";
 
 	char ch;
-	while (address < MEMORY_SIZE) {
+	while (address < memory.get_size()) {
 		ch = get_memory_value(address);
 
 		if (ch == '\0') {
@@ -207,91 +235,64 @@ void ProgramState::extract_string(std::string& str, int address) {
 \throw RuntimeError В случае, если стек вызовов функции переполнен
 */
 void ProgramState::call_subroutine(const std::string& subroutione_name) {
+	int builtin_id = BuiltinRegistry::instance().find(subroutione_name);
+	if (builtin_id >= 0) {
+		call_builtin(builtin_id);
+		return;
+	}
+
 	if (call_stack.size() == MAX_CALL_STACK_DEPTH) {
 		throw RuntimeError("Слишком много подпрограмм вызвано");
 	}
 
-	if (subroutione_name == "putc") {
-		char r0_value = (char)get_register_value(REGISTER::R0);
-		std::cout << r0_value << std::endl;
-		inc_pc();
-	}
-	else if (subroutione_name == "puts") {
-		std::string str;
-		int str_address = get_register_value(REGISTER::R0);
-		extract_string(str, str_address);
+	int address = find_label(subroutione_name);
+	call_stack.push(get_pc() + 1);
+	set_pc(address);
+}
 
-		std::cout << str << std::endl;
-		inc_pc();
-	}
-	else if (subroutione_name == "puti") {
-		int r0_value = get_register_value(REGISTER::R0);
-		std::cout << r0_value << std::endl;
-		inc_pc();
-	}
-	else if (subroutione_name == "getc") {
-		char input;
-		std::cin >> input;
-		set_register_value(REGISTER::R0, input);
-		inc_pc();
-	}
-	else if (subroutione_name == "geti") {
-		int input;
-		std::cin >> input;
-		set_register_value(REGISTER::R0, input);
-		inc_pc();
-	}
-	else if (subroutione_name == "getline") {
-		std::string line;
-		std::getline(std::cin, line);
-		
-		set_register_value(REGISTER::R0, memory_alloc_index);
-		int i = 0;
-		while (memory_alloc_index < MEMORY_SIZE && i < line.length()) {
-			set_memory_value(memory_alloc_index, line[i]);
-			memory_alloc_index++;
-			i++;
-		}
+/*!
+Возвращает буфер вывода встроенных подпрограмм
+\return Буфер вывода
+*/
+OutputBuffer& ProgramState::get_output() {
+	return output;
+}
 
-		if (memory_alloc_index == MEMORY_SIZE && i != line.length()) {
-			throw RuntimeError("Не хватает памяти для записи строки");
-		}
-		inc_pc();
-	}
-	else if (subroutione_name == "find") {
-		int str_address = get_register_value(REGISTER::R0);
-		int substr_address = get_register_value(REGISTER::R1);
-		std::string str, substr;
-		extract_string(str, str_address);
-		extract_string(substr, substr_address);
-		set_register_value(REGISTER::R2, str.find(substr));
-		inc_pc();
-	}
-	else if (subroutione_name == "length") {
-		std::string str;
-		int str_address = get_register_value(REGISTER::R0);
-		extract_string(str, str_address);
-		set_register_value(REGISTER::R1, str.length());
-		inc_pc();
-	}
-	else if (subroutione_name == "ispalindrom") {
-		std::string str;
-		int str_address = get_register_value(REGISTER::R0);
-		extract_string(str, str_address);
-		if (str == std::string(str.rbegin(), str.rend())) {
-			set_register_value(REGISTER::R1, 1);
-		}
-		else {
-			set_register_value(REGISTER::R1, 0);
-		}
-		inc_pc();
+/*!
+Вызывает встроенную подпрограмму по идентификатору, вычисленному при трансляции
+\param[in] builtin_id Идентификатор подпрограммы в реестре встроенных подпрограмм
+\throw RuntimeError В случае, если стек вызовов функции переполнен, или в случае ошибки выполнения подпрограммы
+*/
+void ProgramState::call_builtin(int builtin_id) {
+	if (call_stack.size() == MAX_CALL_STACK_DEPTH) {
+		throw RuntimeError("Слишком много подпрограмм вызвано");
 	}
-	else {
-		check_label_name(subroutione_name);
-		int address = labels.at(subroutione_name);
-		call_stack.push(get_pc() + 1);
-		set_pc(address);
+
+	BuiltinRegistry::instance().call(builtin_id, *this);
+	inc_pc();
+}
+
+/*!
+Вызывает определенную пользователем подпрограмму по заранее вычисленному адресу
+\param[in] address Индекс первой инструкции подпрограммы
+\throw RuntimeError В случае, если стек вызовов функции переполнен
+*/
+void ProgramState::call_subroutine(int address) {
+	if (call_stack.size() == MAX_CALL_STACK_DEPTH) {
+		throw RuntimeError("Слишком много подпрограмм вызвано");
 	}
+
+	call_stack.push(get_pc() + 1);
+	set_pc(address);
+}
+
+/*!
+Проверяет, является ли подпрограмма встроенной
+\param[in] subroutine_name Имя подпрограммы
+\return Флаг, является ли подпрограмма встроенной
+*/
+bool ProgramState::is_builtin_subroutine(const std::string& subroutine_name) {
+	return BuiltinRegistry::instance().find(subroutine_name) >= 0;
 }
 
 /*!
@@ -307,26 +308,172 @@ void ProgramState::return_from_subroutine() {
 	call_stack.pop();
 }
 
+/*!
+Размещает сегмент стека сразу за уже размещенными данными и делает стек пустым.
+Стек растет от конца сегмента к его началу
+\throw RuntimeError В случае, если сегмент стека не помещается в память
+*/
+void ProgramState::allocate_stack() {
+	if (stack_size > memory.get_size() - memory_alloc_index) {
+		throw RuntimeError("Не хватает памяти для стека размером " + std::to_string(stack_size));
+	}
+
+	stack_base = memory_alloc_index;
+	memory_alloc_index += stack_size;
+	set_register_value(REGISTER::SP, stack_base + stack_size);
+}
+
+/*!
+Размещает сегмент стека, если он ещё не размещен, и проверяет, что в стек можно поместить значение
+\return Адрес, по которому помещается значение
+\throw RuntimeError В случае, если стек переполнен или указатель стека вне сегмента стека
+*/
+int ProgramState::prepare_push() {
+	if (stack_base < 0) {
+		allocate_stack();
+	}
+
+	int sp = get_register_value(REGISTER::SP);
+	if (sp == stack_base) {
+		throw RuntimeError("Переполнение стека");
+	}
+	if (sp < stack_base || sp > stack_base + stack_size) {
+		throw RuntimeError("Указатель стека \"" + std::to_string(sp) + "\" вне сегмента стека");
+	}
+
+	return sp - 1;
+}
+
+/*!
+Бросает исключение, объясняющее, почему из стека нельзя извлечь значение
+\throw RuntimeError Всегда
+*/
+void ProgramState::throw_pop_error() const {
+	int sp = get_register_value(REGISTER::SP);
+	if (stack_base < 0 || sp == stack_base + stack_size) {
+		throw RuntimeError("Стек пуст");
+	}
+	throw RuntimeError("Указатель стека \"" + std::to_string(sp) + "\" вне сегмента стека");
+}
+
 /*!
 Выделяет память для данных
 \param[in] data_label_name Метка ячейки памяти
 \throw RuntimeError В случае, если имя ячейки памяти уже определено, или если не хватает памяти
 */
 void ProgramState::allocate_memory(const std::string& data_label_name, const std::vector<int>& data) {
-	if (data_labels.count(data_label_name) > 0) {
+	bool declared = data_labels.count(data_label_name) > 0
+		|| (program != nullptr && program->get_data_addresses().count(data_label_name) > 0);
+	if (declared) {
 		throw RuntimeError("Имя переменной не может повторяться \"" + data_label_name + "\"");
 	}
 
 	data_labels[data_label_name] = memory_alloc_index;
+	labels_changed = true;
 
 	int i = 0;
-	while (memory_alloc_index < MEMORY_SIZE && i < data.size()) {
+	while (memory_alloc_index < memory.get_size() && i < data.size()) {
 		set_memory_value(memory_alloc_index, data[i]);
 		memory_alloc_index++;
 		i++;
 	}
 
-	if (memory_alloc_index == MEMORY_SIZE && i != data.size()) {
+	if (memory_alloc_index == memory.get_size() && i != data.size()) {
 		throw RuntimeError("Не хватает памяти для записи всех значений");
 	}
+}
+
+/*!
+Записывает строку в свободную память. Завершающий ноль не записывается,
+так как свободная память заполнена нулями
+\param[in] str Строка
+\return Адрес начала строки
+\throw RuntimeError В случае, если не хватает памяти
+*/
+int ProgramState::allocate_string(const std::string& str) {
+	int address = memory_alloc_index;
+
+	int i = 0;
+	while (memory_alloc_index < memory.get_size() && i < str.length()) {
+		set_memory_value(memory_alloc_index, str[i]);
+		memory_alloc_index++;
+		i++;
+	}
+
+	if (memory_alloc_index == memory.get_size() && i != str.length()) {
+		throw RuntimeError("Не хватает памяти для записи строки");
+	}
+
+	return address;
+}
+
+/*!
+Загружает в память данные, размещенные при трансляции. Свободная память
+начинается сразу после загруженных данных
+\param[in] memory_image Начальное содержимое памяти, начиная с нулевого адреса
+\param[in] data_addresses Адреса ячеек памяти по их именам
+\throw RuntimeError В случае, если данные не помещаются в память
+*/
+void ProgramState::load_memory_image(const std::vector<int>& memory_image, const std::map<std::string, int>& data_addresses) {
+	if (memory_image.size() > memory.get_size()) {
+		throw RuntimeError("Не хватает памяти для записи всех значений");
+	}
+
+	// Данные читаются и записываются без проверок, поэтому память под ними подключается сразу
+	if (!memory.commit(memory_image.size())) {
+		throw RuntimeError("Не удалось подключить память для записи всех значений");
+	}
+
+	for (int i = 0; i < memory_image.size(); i++) {
+		memory.set(i, memory_image[i]);
+	}
+	memory_alloc_index = memory_image.size();
+	data_labels = data_addresses;
+	labels_changed = true;
+}
+
+/*!
+Делает снимок состояния программы
+\return Снимок состояния
+*/
+ProgramStateSnapshot ProgramState::snapshot() {
+	ProgramStateSnapshot state_snapshot;
+	state_snapshot.registers = registers;
+	state_snapshot.memory = memory.snapshot();
+	state_snapshot.labels = labels;
+	state_snapshot.data_labels = data_labels;
+	state_snapshot.call_stack = call_stack;
+	state_snapshot.pc = pc;
+	state_snapshot.memory_alloc_index = memory_alloc_index;
+	state_snapshot.stack_base = stack_base;
+
+	labels_changed = false;
+	return state_snapshot;
+}
+
+/*!
+Восстанавливает состояние программы из снимка. Если это состояние уже делало снимок
+или восстанавливалось из него, память восстанавливается только в измененных с тех пор страницах
+\param[in] state_snapshot Снимок состояния
+\throw RuntimeError В случае, если память не удалось подключить
+*/
+void ProgramState::restore(const ProgramStateSnapshot& state_snapshot) {
+	bool same_snapshot = memory.is_based_on(state_snapshot.memory);
+
+	if (!memory.restore(state_snapshot.memory)) {
+		throw RuntimeError("Не удалось подключить память для восстановления снимка");
+	}
+
+	registers = state_snapshot.registers;
+	call_stack = state_snapshot.call_stack;
+	pc = state_snapshot.pc;
+	memory_alloc_index = state_snapshot.memory_alloc_index;
+	stack_base = state_snapshot.stack_base;
+
+	// Метки, объявленные при выполнении, появляются редко, поэтому таблицы обычно не копируются
+	if (labels_changed || !same_snapshot) {
+		labels = state_snapshot.labels;
+		data_labels = state_snapshot.data_labels;
+		labels_changed = false;
+	}
 }
\ No newline at end of file
@@ -1,16 +1,25 @@
 #pragma once
 
+#include <iostream>
 #include <array>
 #include <stack>
 #include <vector>
 #include <string>
 #include <map>
 
+#include "OutputBuffer.h"
+#include "IoPort.h"
+#include "Memory.h"
 
-const int MEMORY_SIZE = 2048;
-const int REGISTER_COUNT = 8;
+
+class Program;
+
+const int REGISTER_COUNT = 9;
 const int MAX_CALL_STACK_DEPTH = 64;
 
+/// Размер сегмента стека данных по умолчанию в ячейках
+const int DEFAULT_STACK_SIZE = 256;
+
 enum class REGISTER {
 	R0,
 	R1,
@@ -20,6 +29,7 @@ enum class REGISTER {
 	R5,
 	R6,
 	R7,
+	SP, ///< Указатель стека данных: адрес последнего помещенного в стек значения. До размещения сегмента стека равен нулю
 };
 
 class RuntimeError {
@@ -32,6 +42,37 @@ public:
 	std::string what() const;
 };
 
+/*!
+Снимок состояния программы: регистры, память, метки, объявленные при выполнении, стек вызовов,
+индекс текущей инструкции, индекс первой свободной ячейки памяти и адрес сегмента стека.
+Буфер вывода в снимок не входит
+*/
+struct ProgramStateSnapshot {
+	/// Регистры
+	std::array<int, REGISTER_COUNT> registers{};
+
+	/// Снимок памяти
+	MemorySnapshot memory;
+
+	/// Метки инструкций, объявленные при выполнении
+	std::map<std::string, int> labels;
+
+	/// Метки данных, объявленные при выполнении
+	std::map<std::string, int> data_labels;
+
+	/// Стек для вызовов подпрограмм
+	std::stack<int> call_stack;
+
+	/// Индекс текущей инструкции
+	int pc{};
+
+	/// Индекс первой свободной ячейки памяти
+	int memory_alloc_index{};
+
+	/// Адрес начала сегмента стека или -1, если сегмент ещё не размещен
+	int stack_base = -1;
+};
+
 /*!
 Класс, представляющий внутренней состояние программы
 */
@@ -42,12 +83,15 @@ private:
 	std::array<int, REGISTER_COUNT> registers{};
 
 	/// Ячейки памяти
-	std::array<int, MEMORY_SIZE> memory{};
+	Memory memory;
+
+	/// Выполняемая программа, метки и адреса данных которой известны после трансляции, или nullptr
+	const Program* program = nullptr;
 
-	/// Таблица меток для инструкций
+	/// Метки инструкций, объявленные при выполнении, а не при трансляции
 	std::map<std::string, int> labels;
 
-	/// Таблица меток для данных
+	/// Метки данных, объявленные при выполнении инструкций "data", не размещенных при трансляции
 	std::map<std::string, int> data_labels;
 
 	/// Стек для вызовов подпрограмм
@@ -62,6 +106,24 @@ private:
 	/// Количество инструкций
 	int instr_count{};
 
+	/// Размер сегмента стека в ячейках
+	int stack_size{};
+
+	/// Адрес начала сегмента стека или -1, если сегмент ещё не размещен
+	int stack_base = -1;
+
+	/// Флаг, изменялись ли таблицы меток после последнего снимка или восстановления
+	bool labels_changed{};
+
+	/// Порт ввода-вывода по умолчанию, работающий со стандартными потоками
+	StreamPort standard_port{ std::cin, std::cout };
+
+	/// Порт ввода-вывода встроенных подпрограмм
+	IoPort* io_port = &standard_port;
+
+	/// Буфер вывода встроенных подпрограмм
+	OutputBuffer output{ standard_port };
+
 	/*!
 	Проверяет, может ли использоваться адрес в качестве допустимого адреса памяти
 	\param[in] address Адрес для проверки
@@ -69,16 +131,27 @@ private:
 	void check_memory_address(int address);
 
 	/*!
-	Проверяет, может ли использоваться имя в качестве допустимого имени метки
-	\param[in] label_name Имя для проверки
+	Проверяет адрес и подключает память до него, если она ещё не подключена
+	\param[in] address Адрес
+	\throw RuntimeError В случае, если адрес недопустим или память не удалось подключить
+	*/
+	void commit_memory_address(int address);
+
+	/*!
+	Ищет метку среди объявленных при выполнении, а затем в таблице меток программы
+	\param[in] label_name Имя метки
+	\return Индекс инструкции
+	\throw RuntimeError В случае, если метка неизвестна
 	*/
-	void check_label_name(const std::string& label_name);
-	
+	int find_label(const std::string& label_name) const;
+
 	/*!
-	Проверяет, может ли использоваться имя в качестве допустимого имени ячейки памяти
-	\param[in] label_name Имя для проверки
+	Ищет ячейку памяти среди объявленных при выполнении, а затем в таблице адресов данных программы
+	\param[in] data_label_name Имя ячейки памяти
+	\return Адрес ячейки памяти
+	\throw RuntimeError В случае, если имя ячейки памяти неизвестно
 	*/
-	void check_data_label_name(const std::string& data_label_name);
+	int find_data_label(const std::string& data_label_name) const;
 
 	/*!
 	Проверяет, может ли использоваться адрес в качестве допустимого адреса инструкции
@@ -86,8 +159,56 @@ private:
 	*/
 	void check_instr_address(int address);
 
+	/*!
+	Размещает сегмент стека сразу за уже размещенными данными и делает стек пустым
+	\throw RuntimeError В случае, если сегмент стека не помещается в память
+	*/
+	void allocate_stack();
+
+	/*!
+	Размещает сегмент стека, если он ещё не размещен, и проверяет, что в стек можно поместить значение
+	\return Адрес, по которому помещается значение
+	\throw RuntimeError В случае, если стек переполнен или указатель стека вне сегмента стека
+	*/
+	int prepare_push();
+
+	/*!
+	Бросает исключение, объясняющее, почему из стека нельзя извлечь значение
+	\throw RuntimeError Всегда
+	*/
+	void throw_pop_error() const;
+
 public:
-	ProgramState(int instr_count);
+	/*!
+	Конструктор состояния программы
+	\param[in] instr_count Количество инструкций
+	\param[in] memory_size Количество ячеек памяти
+	\param[in] memory_mode Способ выделения памяти
+	\param[in] stack_size Размер сегмента стека. Сегмент размещается при первом обращении к стеку
+	\throw RuntimeError В случае, если память не удалось выделить
+	*/
+	ProgramState(int instr_count, int memory_size = DEFAULT_MEMORY_SIZE, MEMORY_MODE memory_mode = MEMORY_MODE::FIXED, int stack_size = DEFAULT_STACK_SIZE);
+
+	/*!
+	Конструктор состояния для выполнения программы. Таблицы меток и адресов данных
+	не копируются, а в память загружается только начальное содержимое памяти программы.
+	Сегмент стека не резервируется заранее, а размещается за данными при первом обращении
+	к стеку, поэтому программа, не использующая стек, получает всю память под данные
+	\param[in] program Программа. Должна существовать, пока существует состояние
+	\param[in] memory_size Количество ячеек памяти
+	\param[in] memory_mode Способ выделения памяти
+	\param[in] stack_size Размер сегмента стека
+	\throw RuntimeError В случае, если память не удалось выделить или данные программы не помещаются в неё
+	*/
+	ProgramState(const Program& program, int memory_size = DEFAULT_MEMORY_SIZE, MEMORY_MODE memory_mode = MEMORY_MODE::FIXED, int stack_size = DEFAULT_STACK_SIZE);
+
+	/*!
+	Возвращает количество ячеек памяти
+	\return Количество ячеек памяти
+	*/
+	int get_memory_size() const {
+		return memory.get_size();
+	}
 
 	/*!
 	Возвращает флаг, "работает" ли ещё интерпретатор
@@ -103,18 +224,23 @@ public:
 	void extract_string(std::string& str, int address);
 
 	/*!
-	Возвращает значение регистра
+	Возвращает значение регистра. Перечисление REGISTER закрыто, а регистры инструкций
+	байт-кода проверяются при их записи в Bytecode, поэтому индекс не проверяется
 	\param[in] r Регистр
 	\return Значение регистра
 	*/
-	int get_register_value(REGISTER r) const;
+	int get_register_value(REGISTER r) const {
+		return registers[(int)r];
+	}
 
 	/*!
-	Устанавливает значение регистра
+	Устанавливает значение регистра. Индекс не проверяется
 	\param[in] r Регистр
 	\param[in] value Значение
 	*/
-	void set_register_value(REGISTER r, int value);
+	void set_register_value(REGISTER r, int value) {
+		registers[(int)r] = value;
+	}
 
 	/*!
 	Возвращает значение из памяти по имени
@@ -142,14 +268,43 @@ public:
 	\param[in] value Адрес
 	\return Значение из памяти по адресу
 	*/
-	int get_memory_value(int address);
+	int get_memory_value(int address) {
+		if ((unsigned)address >= (unsigned)memory.get_committed_size()) {
+			commit_memory_address(address);
+		}
+		return memory.get(address);
+	}
 
 	/*!
 	Устанавливает значение в памяти по адресу
 	\param[in] address Адрес
 	\param[in] value Значение
 	*/
-	void set_memory_value(int address, int value);
+	void set_memory_value(int address, int value) {
+		if ((unsigned)address >= (unsigned)memory.get_committed_size()) {
+			commit_memory_address(address);
+		}
+		memory.set(address, value);
+	}
+
+	/*!
+	Возвращает значение ячейки данных, размещенной при трансляции. Адрес проверен
+	при размещении данных, поэтому здесь не проверяется
+	\param[in] address Адрес
+	\return Значение ячейки
+	*/
+	int get_data_value(int address) const {
+		return memory.get(address);
+	}
+
+	/*!
+	Устанавливает значение ячейки данных, размещенной при трансляции. Адрес не проверяется
+	\param[in] address Адрес
+	\param[in] value Значение
+	*/
+	void set_data_value(int address, int value) {
+		memory.set(address, value);
+	}
 
 	/*!
 	Возвращает адрес метки по имеми
@@ -159,7 +314,7 @@ public:
 	int get_label_address(const std::string& label_name);
 
 	/*!
-	Добавляет новую метку
+	Добавляет новую метку, объявленную при выполнении
 	\param[in] label_name Имя метки
 	\param[in] address Адрес метки
 	*/
@@ -189,16 +344,145 @@ public:
 	*/
 	void call_subroutine(const std::string& subroutione_name);
 
+	/*!
+	Возвращает буфер вывода встроенных подпрограмм
+	\return Буфер вывода
+	*/
+	OutputBuffer& get_output();
+
+	/*!
+	Возвращает порт ввода-вывода встроенных подпрограмм
+	\return Порт ввода-вывода
+	*/
+	IoPort& get_io_port() {
+		return *io_port;
+	}
+
+	/*!
+	Меняет порт ввода-вывода встроенных подпрограмм. Накопленный вывод
+	предварительно записывается в прежний порт
+	\param[in] new_io_port Порт ввода-вывода
+	*/
+	void set_io_port(IoPort& new_io_port) {
+		output.set_port(new_io_port);
+		io_port = &new_io_port;
+	}
+
+	/*!
+	Вызывает встроенную подпрограмму по идентификатору, вычисленному при трансляции
+	\param[in] builtin_id Идентификатор подпрограммы в реестре встроенных подпрограмм
+	\throw RuntimeError В случае, если стек вызовов функции переполнен, или в случае ошибки выполнения подпрограммы
+	*/
+	void call_builtin(int builtin_id);
+
+	/*!
+	Вызывает определенную пользователем подпрограмму по заранее вычисленному адресу
+	\param[in] address Индекс первой инструкции подпрограммы
+	\throw RuntimeError В случае, если стек вызовов функции переполнен
+	*/
+	void call_subroutine(int address);
+
+	/*!
+	Проверяет, является ли подпрограмма встроенной
+	\param[in] subroutine_name Имя подпрограммы
+	\return Флаг, является ли подпрограмма встроенной
+	*/
+	static bool is_builtin_subroutine(const std::string& subroutine_name);
+
 	/*!
 	Прекращает выполнение подпрограммы
 	\throw RuntimeError В случае, если была попытка прекратить выполение подпрограммы вне какой-либо подпрограммы
 	*/
 	void return_from_subroutine();
 
+	/*!
+	Помещает значение в стек данных. Указатель стека доступен программе как регистр,
+	поэтому проверяется при каждом обращении
+	\param[in] value Значение
+	\throw RuntimeError В случае, если стек переполнен или указатель стека вне сегмента стека
+	*/
+	void push(int value) {
+		int sp = registers[(int)REGISTER::SP] - 1;
+		if (stack_base < 0 || (unsigned)(sp - stack_base) >= (unsigned)stack_size) {
+			sp = prepare_push();
+		}
+		set_memory_value(sp, value);
+		registers[(int)REGISTER::SP] = sp;
+	}
+
+	/*!
+	Извлекает значение из стека данных
+	\return Значение
+	\throw RuntimeError В случае, если стек пуст или указатель стека вне сегмента стека
+	*/
+	int pop() {
+		int sp = registers[(int)REGISTER::SP];
+		if (stack_base < 0 || (unsigned)(sp - stack_base) >= (unsigned)stack_size) {
+			throw_pop_error();
+		}
+		registers[(int)REGISTER::SP] = sp + 1;
+		return get_memory_value(sp);
+	}
+
+	/*!
+	Возвращает адрес начала сегмента стека
+	\return Адрес начала сегмента стека или -1, если сегмент ещё не размещен
+	*/
+	int get_stack_base() const {
+		return stack_base;
+	}
+
+	/*!
+	Возвращает размер сегмента стека
+	\return Размер сегмента стека в ячейках
+	*/
+	int get_stack_size() const {
+		return stack_size;
+	}
+
 	/*!
 	Выделяет память для данных
 	\param[in] data_label_name Метка ячейки памяти
 	\throw RuntimeError В случае, если имя ячейки памяти уже определено, или если не хватает памяти
 	*/
 	void allocate_memory(const std::string& data_label_name, const std::vector<int>& data);
+
+	/*!
+	Записывает строку в свободную память
+	\param[in] str Строка
+	\return Адрес начала строки
+	\throw RuntimeError В случае, если не хватает памяти
+	*/
+	int allocate_string(const std::string& str);
+
+	/*!
+	Загружает в память данные, размещенные при трансляции. Свободная память
+	начинается сразу после загруженных данных
+	\param[in] memory_image Начальное содержимое памяти, начиная с нулевого адреса
+	\param[in] data_addresses Адреса ячеек памяти по их именам
+	\throw RuntimeError В случае, если данные не помещаются в память
+	*/
+	void load_memory_image(const std::vector<int>& memory_image, const std::map<std::string, int>& data_addresses);
+
+	/*!
+	Делает снимок состояния программы
+	\return Снимок состояния
+	*/
+	ProgramStateSnapshot snapshot();
+
+	/*!
+	Восстанавливает состояние программы из снимка. Если это состояние уже делало снимок
+	или восстанавливалось из него, память восстанавливается только в измененных с тех пор страницах
+	\param[in] state_snapshot Снимок состояния
+	\throw RuntimeError В случае, если память не удалось подключить
+	*/
+	void restore(const ProgramStateSnapshot& state_snapshot);
+
+	/*!
+	Возвращает количество страниц памяти, измененных после последнего снимка или восстановления
+	\return Количество измененных страниц
+	*/
+	int get_dirty_page_count() const {
+		return memory.get_dirty_page_count();
+	}
 };
\ No newline at end of file
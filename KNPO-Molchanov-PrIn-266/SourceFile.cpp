@@ -0,0 +1,152 @@
+#include <istream>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "SourceFile.h"
+
+/// Размер блока, которым считывается текст, если файл не удалось отобразить в память
+const size_t READ_BLOCK_SIZE = 1 << 16;
+
+
+SourceFile::~SourceFile() {
+	close();
+}
+
+/*!
+Отображает файл в память
+\param[in] path Путь к файлу
+\return Флаг, удалось ли отобразить файл
+*/
+bool SourceFile::map(const std::string& path) {
+#ifdef _WIN32
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+
+	LARGE_INTEGER file_size;
+	if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0) {
+		CloseHandle(file);
+		return false;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file);
+	if (mapping == nullptr) {
+		return false;
+	}
+
+	void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping);
+	if (view == nullptr) {
+		return false;
+	}
+
+	mapped_data = view;
+	mapped_size = (size_t)file_size.QuadPart;
+#else
+	int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0) {
+		return false;
+	}
+
+	struct stat file_stat;
+	if (fstat(fd, &file_stat) != 0 || !S_ISREG(file_stat.st_mode) || file_stat.st_size == 0) {
+		::close(fd);
+		return false;
+	}
+
+	void* view = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd);
+	if (view == MAP_FAILED) {
+		return false;
+	}
+
+	mapped_data = view;
+	mapped_size = file_stat.st_size;
+#endif
+
+	data = (const char*)mapped_data;
+	size = mapped_size;
+	return true;
+}
+
+/*!
+Освобождает загруженный текст
+*/
+void SourceFile::close() {
+	if (mapped_data != nullptr) {
+#ifdef _WIN32
+		UnmapViewOfFile(mapped_data);
+#else
+		munmap(mapped_data, mapped_size);
+#endif
+		mapped_data = nullptr;
+		mapped_size = 0;
+	}
+
+	buffer.clear();
+	data = nullptr;
+	size = 0;
+}
+
+/*!
+Загружает текст из файла
+\param[in] path Путь к файлу
+\return Флаг, удалось ли открыть файл
+*/
+bool SourceFile::open(const std::string& path) {
+	close();
+
+	if (map(path)) {
+		return true;
+	}
+
+	// Пустые файлы и файлы, которые нельзя отобразить в память, считываются обычным образом
+	std::ifstream stream(path, std::ios::binary);
+	if (!stream.is_open()) {
+		return false;
+	}
+
+	read(stream);
+	return true;
+}
+
+/*!
+Считывает текст из потока блоками до его конца
+\param[in] stream Входной поток
+*/
+void SourceFile::read(std::istream& stream) {
+	close();
+
+	size_t length = 0;
+	while (stream) {
+		buffer.resize(length + READ_BLOCK_SIZE);
+		stream.read(buffer.data() + length, READ_BLOCK_SIZE);
+		length += stream.gcount();
+	}
+	buffer.resize(length);
+
+	data = buffer.data();
+	size = buffer.size();
+}
+
+/*!
+Возвращает загруженный текст
+\return Текст программы
+*/
+std::string_view SourceFile::get_text() const {
+	return std::string_view(data, size);
+}
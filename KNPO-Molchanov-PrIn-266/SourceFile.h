@@ -0,0 +1,70 @@
+#pragma once
+
+#include <istream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*!
+\brief Текст программы на псевдо-ассемблере, загруженный в память целиком
+
+Файл отображается в память, а если это невозможно, считывается крупными блоками.
+Строки и токены, выделяемые при трансляции, ссылаются на этот текст, поэтому
+объект должен существовать, пока они используются
+*/
+class SourceFile {
+private:
+	/// Начало текста
+	const char* data = nullptr;
+
+	/// Длина текста
+	size_t size = 0;
+
+	/// Текст, считанный блоками, если файл не был отображен в память
+	std::vector<char> buffer;
+
+	/// Начало области, отображенной в память, или nullptr
+	void* mapped_data = nullptr;
+
+	/// Длина области, отображенной в память
+	size_t mapped_size = 0;
+
+	/*!
+	Отображает файл в память
+	\param[in] path Путь к файлу
+	\return Флаг, удалось ли отобразить файл
+	*/
+	bool map(const std::string& path);
+
+	/*!
+	Освобождает загруженный текст
+	*/
+	void close();
+
+public:
+	SourceFile() = default;
+
+	SourceFile(const SourceFile&) = delete;
+	SourceFile& operator=(const SourceFile&) = delete;
+
+	~SourceFile();
+
+	/*!
+	Загружает текст из файла
+	\param[in] path Путь к файлу
+	\return Флаг, удалось ли открыть файл
+	*/
+	bool open(const std::string& path);
+
+	/*!
+	Считывает текст из потока блоками до его конца
+	\param[in] stream Входной поток
+	*/
+	void read(std::istream& stream);
+
+	/*!
+	Возвращает загруженный текст
+	\return Текст программы
+	*/
+	std::string_view get_text() const;
+};
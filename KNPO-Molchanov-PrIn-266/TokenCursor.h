@@ -0,0 +1,74 @@
+#pragma once
+
+#include <vector>
+
+#include "Tokenizer.h"
+
+/*!
+\brief Курсор по токенам одной строки
+
+Не владеет токенами, а ссылается на непрерывный массив токенов, поэтому
+передача курсора в функции разбора не копирует ни токены, ни их текст.
+Методы объявлены в заголовке, чтобы компилятор мог их встроить
+*/
+class TokenCursor {
+private:
+	/// Первый токен строки
+	const Token* tokens;
+
+	/// Количество токенов
+	int count;
+
+	/// Индекс текущего токена
+	int pos;
+
+public:
+	/*!
+	Конструктор курсора, указывающего на первый токен
+	\param[in] line_tokens Токены строки. Должны существовать, пока используется курсор
+	*/
+	explicit TokenCursor(const std::vector<Token>& line_tokens)
+		: tokens{ line_tokens.data() }, count{ (int)line_tokens.size() }, pos{ 0 } {
+	}
+
+	/*!
+	Проверяет, пройдены ли все токены
+	\return Флаг, пройдены ли все токены
+	*/
+	bool at_end() const {
+		return pos >= count;
+	}
+
+	/*!
+	Возвращает текущий токен. Курсор не должен находиться в конце
+	\return Текущий токен
+	*/
+	const Token& peek() const {
+		return tokens[pos];
+	}
+
+	/*!
+	Проверяет, имеет ли текущий токен заданный тип
+	\param[in] type Тип токена
+	\return Флаг, имеет ли текущий токен заданный тип. В конце всегда false
+	*/
+	bool is(TOKEN_TYPE type) const {
+		return pos < count && tokens[pos].type == type;
+	}
+
+	/*!
+	Возвращает текущий токен и переходит к следующему. Курсор не должен находиться в конце
+	\return Текущий токен
+	*/
+	const Token& next() {
+		return tokens[pos++];
+	}
+
+	/*!
+	Возвращает индекс текущего токена
+	\return Индекс текущего токена
+	*/
+	int position() const {
+		return pos;
+	}
+};
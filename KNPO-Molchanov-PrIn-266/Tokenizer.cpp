@@ -1,5 +1,7 @@
 #include <vector>
 #include <set>
+#include <string>
+#include <string_view>
 #include <regex>
 
 #include "Tokenizer.h"
@@ -54,8 +56,8 @@ TOKEN_TYPE Tokenizer::TokenRegex::get_type() {
 \param[out] m Объект, в котором хранятся данные о результате сопоставления
 \return Флаг, указывающий об успешности результата сопоставления 
 */
-bool Tokenizer::TokenRegex::match(const std::string& str, int start_index, std::smatch& m) {
-	return std::regex_search(str.begin() + start_index, str.end(), m, matching_regex);
+bool Tokenizer::TokenRegex::match(std::string_view str, int start_index, std::cmatch& m) {
+	return std::regex_search(str.data() + start_index, str.data() + str.size(), m, matching_regex);
 }
 
 
@@ -71,14 +73,23 @@ Tokenizer::Tokenizer() {
 	add_token(TOKEN_TYPE::NOT, "not\\b");
 	add_token(TOKEN_TYPE::SHR, "shr\\b");
 	add_token(TOKEN_TYPE::SHL, "shl\\b");
+	add_token(TOKEN_TYPE::MUL, "mul\\b");
+	add_token(TOKEN_TYPE::DIV, "div\\b");
+	add_token(TOKEN_TYPE::MOD, "mod\\b");
 	add_token(TOKEN_TYPE::SET, "set\\b");
 	add_token(TOKEN_TYPE::LD, "ld\\b");
 	add_token(TOKEN_TYPE::ST, "st\\b");
 	add_token(TOKEN_TYPE::LDI, "ldi\\b");
 	add_token(TOKEN_TYPE::STI, "sti\\b");
+	add_token(TOKEN_TYPE::PUSH, "push\\b");
+	add_token(TOKEN_TYPE::POP, "pop\\b");
 	add_token(TOKEN_TYPE::JMP, "jmp\\b");
 	add_token(TOKEN_TYPE::JEQ, "jeq\\b");
+	add_token(TOKEN_TYPE::JNE, "jne\\b");
 	add_token(TOKEN_TYPE::JGT, "jgt\\b");
+	add_token(TOKEN_TYPE::JLT, "jlt\\b");
+	add_token(TOKEN_TYPE::JGE, "jge\\b");
+	add_token(TOKEN_TYPE::JLE, "jle\\b");
 	add_token(TOKEN_TYPE::CALL, "call\\b");
 	add_token(TOKEN_TYPE::RET, "ret\\b");
 	add_token(TOKEN_TYPE::DATA, "data\\b");
@@ -91,6 +102,7 @@ Tokenizer::Tokenizer() {
 	add_token(TOKEN_TYPE::R5, "r5\\b");
 	add_token(TOKEN_TYPE::R6, "r6\\b");
 	add_token(TOKEN_TYPE::R7, "r7\\b");
+	add_token(TOKEN_TYPE::SP, "sp\\b");
 
 	add_token(TOKEN_TYPE::NAME, "([a-zA-Z_]\\w*)");
 	add_token(TOKEN_TYPE::HEX_NUMBER, "0(?:[xX])([0-9A-Fa-f]+)");
@@ -141,8 +153,8 @@ void Tokenizer::ignore(TOKEN_TYPE type) {
 \return Итератор, указывающий на символ, следующий сразу после последнего символа считанного токена
 \throw NoTokenFoundError В случае, если не было найдено соответствующего шаблона для извлечения токена
 */
-int Tokenizer::extract_token(const std::string& str, int start_index, std::vector<Token>& tokens) {
-	std::smatch matched_token;
+int Tokenizer::extract_token(std::string_view str, int start_index, std::vector<Token>& tokens) {
+	std::cmatch matched_token;
 	TOKEN_TYPE type = TOKEN_TYPE::UNSPECIFIED;
 
 	// Для каждого заданного шаблона токена...
@@ -165,14 +177,14 @@ int Tokenizer::extract_token(const std::string& str, int start_index, std::vecto
 	// Если найденный токен не нужно игнорировать, поместить его
 	// в список найденных токенов
 	if (ignored_tokens.find(type) == ignored_tokens.end()) {
-		std::string text = matched_token[0].str();
-		int start_index = matched_token[0].first - str.begin();
-		int end_index = matched_token[0].second - str.begin() - 1;
+		int start_index = matched_token[0].first - str.data();
+		int end_index = matched_token[0].second - str.data() - 1;
+		std::string_view text = str.substr(start_index, end_index - start_index + 1);
 
 		tokens.push_back(Token{ type, text, start_index, end_index });
 	}
 
-	return matched_token[0].second - str.begin();
+	return matched_token[0].second - str.data();
 }
 
 /*!
@@ -182,7 +194,7 @@ int Tokenizer::extract_token(const std::string& str, int start_index, std::vecto
 \param[in] str Входная строка
 \param[out] tokens Считанные токены
 */
-void Tokenizer::tokenize(const std::string& str, std::vector<Token>& tokens) {
+void Tokenizer::tokenize(std::string_view str, std::vector<Token>& tokens) {
 	int i = 0;
 
 	// Пока не пройдена вся строка...
@@ -2,6 +2,8 @@
 
 #include <vector>
 #include <set>
+#include <string>
+#include <string_view>
 #include <regex>
 
 
@@ -31,6 +33,9 @@ enum class TOKEN_TYPE {
 	NOT, ///< Зарезервированное слово "not"
 	SHR, ///< Зарезервированное слово "shr"
 	SHL, ///< Зарезервированное слово "shl"
+	MUL, ///< Зарезервированное слово "mul"
+	DIV, ///< Зарезервированное слово "div"
+	MOD, ///< Зарезервированное слово "mod"
 
 	SET, ///< Зарезервированное слово "set"
 
@@ -38,10 +43,16 @@ enum class TOKEN_TYPE {
 	ST, ///< Зарезервированное слово "st"
 	LDI, ///< Зарезервированное слово "ldi"
 	STI, ///< Зарезервированное слово "sti"
+	PUSH, ///< Зарезервированное слово "push"
+	POP, ///< Зарезервированное слово "pop"
 
 	JMP, ///< Зарезервированное слово "jmp"
 	JEQ, ///< Зарезервированное слово "jeq"
+	JNE, ///< Зарезервированное слово "jne"
 	JGT, ///< Зарезервированное слово "jgt"
+	JLT, ///< Зарезервированное слово "jlt"
+	JGE, ///< Зарезервированное слово "jge"
+	JLE, ///< Зарезервированное слово "jle"
 
 	CALL, ///< Зарезервированное слово "call"
 	RET, ///< Зарезервированное слово "ret"
@@ -56,6 +67,7 @@ enum class TOKEN_TYPE {
 	R5, ///< Зарезервированное слово "r5"
 	R6, ///< Зарезервированное слово "r6"
 	R7, ///< Зарезервированное слово "r7"
+	SP, ///< Зарезервированное слово "sp"
 
 	UNSPECIFIED, ///< Значение, указывающее, что токен не определен
 };
@@ -96,8 +108,9 @@ public:
 struct Token {
 	/// Тип токена
 	TOKEN_TYPE type;
-	/// Тектовое представление токена
-	std::string text;
+	/// Тектовое представление токена. Ссылается на разбираемую строку,
+	/// поэтому действительно, пока существует эта строка
+	std::string_view text;
 	/// Индекс начала токена в строке
 	int start_index;
 	/// Индекс конца токена в строке
@@ -106,9 +119,27 @@ struct Token {
 
 
 /*!
-Токенайзер для языка псевдо-ассмеблера
+Интерфейс токенайзера для языка псевдо-ассемблера
 */
-class Tokenizer
+class AbstractTokenizer {
+public:
+	virtual ~AbstractTokenizer() = default;
+
+	/*!
+	\brief Выделяет токены языка псевдо-ассемблера из строки
+
+	Выделяет токены языка псевдо-ассемблера из строки
+	\param[in] str Входная строка
+	\param[out] tokens Считанные токены
+	\throw TokenizerError В случае, если в строке встретился недопустимый токен
+	*/
+	virtual void tokenize(std::string_view str, std::vector<Token>& tokens) = 0;
+};
+
+/*!
+Токенайзер для языка псевдо-ассмеблера, основанный на регулярных выражениях
+*/
+class Tokenizer : public AbstractTokenizer
 {
 private:
 	/*!
@@ -142,7 +173,7 @@ private:
 		\param[out] m Объект, в котором хранятся данные о результате сопоставления
 		\return Флаг, указывающий об успешности результата сопоставления
 		*/
-		bool match(const std::string& str, int start_index, std::smatch& m);
+		bool match(std::string_view str, int start_index, std::cmatch& m);
 	};
 
 	/// Допустимые шаблоны для токенов
@@ -174,7 +205,7 @@ private:
 	\return Индекс указывающий на символ, идущий сразу после найденого токена
 	\throw NoTokenFoundError В случае, если не было найдено соответствующего шаблона для извлечения токена
 	*/
-	int extract_token(const std::string& str, int start_index, std::vector<Token>& tokens);
+	int extract_token(std::string_view str, int start_index, std::vector<Token>& tokens);
 
 public:
 	/*!
@@ -189,5 +220,5 @@ public:
 	\param[in] str Входная строка
 	\param[out] tokens Считанные токены
 	*/
-	void tokenize(const std::string& str, std::vector<Token>& tokens);
+	void tokenize(std::string_view str, std::vector<Token>& tokens) override;
 };
\ No newline at end of file
@@ -0,0 +1,110 @@
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <fstream>
+#include <filesystem>
+#include <random>
+
+#include "TranslationCache.h"
+#include "ProgramImage.h"
+#include "SourceFile.h"
+
+
+/*!
+Конструктор кэша
+\param[in] directory Каталог кэша. Создается при первой записи
+*/
+TranslationCache::TranslationCache(const std::string& directory) : directory{ directory } {
+}
+
+/*!
+Вычисляет 64-битный хэш FNV-1a
+\param[in] data Данные
+\return Хэш
+*/
+uint64_t TranslationCache::hash(std::string_view data) {
+	uint64_t value = 14695981039346656037ull;
+	for (char ch : data) {
+		value ^= (uint8_t)ch;
+		value *= 1099511628211ull;
+	}
+	return value;
+}
+
+/*!
+Возвращает путь к файлу записи кэша для текста программы
+\param[in] source Текст программы
+\param[in] options Параметры интерпретатора, влияющие на результат трансляции
+\return Путь к файлу
+*/
+std::string TranslationCache::get_entry_path(std::string_view source, const InterpreterOptions& options) const {
+	char name[128];
+	std::snprintf(name, sizeof(name), "%016llx-%zx-v%u.%u-m%d%s.kbin", (unsigned long long)hash(source), source.size(),
+		(unsigned)INTERPRETER_VERSION, (unsigned)PROGRAM_IMAGE_VERSION, options.memory_size, options.fuse ? "" : "-nofusion");
+
+	return (std::filesystem::path(directory) / name).string();
+}
+
+/*!
+Ищет программу в кэше. Поврежденная или нечитаемая запись считается отсутствующей
+\param[in] source Текст программы
+\param[in] options Параметры интерпретатора, влияющие на результат трансляции
+\param[out] program Программа с записанным байт-кодом
+\return Флаг, найдена ли программа
+*/
+bool TranslationCache::load(std::string_view source, const InterpreterOptions& options, TranslatedProgram& program) const {
+	SourceFile entry;
+	if (!entry.open(get_entry_path(source, options))) {
+		return false;
+	}
+
+	try {
+		ProgramImage::read(entry.get_text(), program);
+	}
+	catch (ImageError&) {
+		program = TranslatedProgram();
+		return false;
+	}
+
+	return true;
+}
+
+/*!
+Записывает программу в кэш. Запись сначала создается во временном файле,
+а затем переименовывается, поэтому параллельные запуски не видят её частично записанной
+\param[in] source Текст программы
+\param[in] options Параметры интерпретатора, влияющие на результат трансляции
+\param[in] program Программа с записанным байт-кодом
+\return Флаг, удалось ли записать программу
+*/
+bool TranslationCache::store(std::string_view source, const InterpreterOptions& options, const TranslatedProgram& program) const {
+	std::error_code error;
+	std::filesystem::create_directories(directory, error);
+	if (error) {
+		return false;
+	}
+
+	std::string path = get_entry_path(source, options);
+	std::string temp_path = path + "." + std::to_string(std::random_device()()) + ".tmp";
+	{
+		std::ofstream temp_file(temp_path, std::ios::binary);
+		if (!temp_file) {
+			return false;
+		}
+		ProgramImage::write(program, temp_file);
+		if (!temp_file) {
+			temp_file.close();
+			std::filesystem::remove(temp_path, error);
+			return false;
+		}
+	}
+
+	std::filesystem::rename(temp_path, path, error);
+	if (error) {
+		std::filesystem::remove(temp_path, error);
+		return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "Interpreter.h"
+
+/// Каталог кэша трансляции по умолчанию
+const char* const DEFAULT_TRANSLATION_CACHE_DIRECTORY = ".knpo-cache";
+
+/*!
+\brief Кэш оттранслированных программ на диске
+
+Программа хранится в каталоге кэша как двоичный образ ProgramImage. Имя файла
+составляется из хэша текста программы, его длины, версии интерпретатора, версии
+формата образа, размера памяти и флага объединения инструкций, поэтому изменение
+любого из них приводит к новой записи, а не к использованию устаревшей
+*/
+class TranslationCache {
+private:
+	/// Каталог кэша
+	std::string directory;
+
+	/*!
+	Возвращает путь к файлу записи кэша для текста программы
+	\param[in] source Текст программы
+	\param[in] options Параметры интерпретатора, влияющие на результат трансляции
+	\return Путь к файлу
+	*/
+	std::string get_entry_path(std::string_view source, const InterpreterOptions& options) const;
+
+public:
+	/*!
+	Конструктор кэша
+	\param[in] directory Каталог кэша. Создается при первой записи
+	*/
+	TranslationCache(const std::string& directory = DEFAULT_TRANSLATION_CACHE_DIRECTORY);
+
+	/*!
+	Вычисляет 64-битный хэш FNV-1a
+	\param[in] data Данные
+	\return Хэш
+	*/
+	static uint64_t hash(std::string_view data);
+
+	/*!
+	Ищет программу в кэше. Поврежденная или нечитаемая запись считается отсутствующей
+	\param[in] source Текст программы
+	\param[in] options Параметры интерпретатора, влияющие на результат трансляции
+	\param[out] program Программа с записанным байт-кодом
+	\return Флаг, найдена ли программа
+	*/
+	bool load(std::string_view source, const InterpreterOptions& options, TranslatedProgram& program) const;
+
+	/*!
+	Записывает программу в кэш. Запись сначала создается во временном файле,
+	а затем переименовывается, поэтому параллельные запуски не видят её частично записанной
+	\param[in] source Текст программы
+	\param[in] options Параметры интерпретатора, влияющие на результат трансляции
+	\param[in] program Программа с записанным байт-кодом
+	\return Флаг, удалось ли записать программу
+	*/
+	bool store(std::string_view source, const InterpreterOptions& options, const TranslatedProgram& program) const;
+};
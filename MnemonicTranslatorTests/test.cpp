@@ -4,6 +4,7 @@
 #include <fstream>
 #include <vector>
 #include <typeinfo>
+#include <climits>
 
 #include "../KNPO-Molchanov-PrIn-266/MnemonicTranslator.h"
 
@@ -344,6 +345,150 @@ TEST(MnemonicTranslatorTest, ShlImmInstruction) {
 	EXPECT_EQ(instr->get_imm_value(), 2);
 }
 
+TEST(MnemonicTranslatorTest, MulRegInstruction) {
+	std::ofstream output_file("test.asm");
+	output_file << "mul r1, r2" << std::endl;
+	output_file.close();
+
+	std::ifstream input_file("test.asm");
+	std::vector<std::shared_ptr<Instr>> instrs;
+	std::map<std::string, int> labels;
+	std::vector<TokenizerError> tokenizer_errors;
+	std::vector<SyntaxError> syntax_errors;
+
+	MnemonicTranslator mn;
+	bool result = mn.translate(input_file, instrs, labels, tokenizer_errors, syntax_errors);
+
+	ASSERT_TRUE(result);
+	EXPECT_EQ(instrs.size(), 1);
+	EXPECT_EQ(tokenizer_errors.size(), 0);
+	EXPECT_EQ(syntax_errors.size(), 0);
+	MulRegInstr* instr = dynamic_cast<MulRegInstr*>(instrs[0].get());
+	ASSERT_NE(instr, nullptr);
+	EXPECT_EQ(instr->get_dest(), REGISTER::R1);
+	EXPECT_EQ(instr->get_src(), REGISTER::R2);
+}
+
+TEST(MnemonicTranslatorTest, MulImmInstruction) {
+	std::ofstream output_file("test.asm");
+	output_file << "mul r4, -3" << std::endl;
+	output_file.close();
+
+	std::ifstream input_file("test.asm");
+	std::vector<std::shared_ptr<Instr>> instrs;
+	std::map<std::string, int> labels;
+	std::vector<TokenizerError> tokenizer_errors;
+	std::vector<SyntaxError> syntax_errors;
+
+	MnemonicTranslator mn;
+	bool result = mn.translate(input_file, instrs, labels, tokenizer_errors, syntax_errors);
+
+	ASSERT_TRUE(result);
+	EXPECT_EQ(instrs.size(), 1);
+	EXPECT_EQ(tokenizer_errors.size(), 0);
+	EXPECT_EQ(syntax_errors.size(), 0);
+	MulImmInstr* instr = dynamic_cast<MulImmInstr*>(instrs[0].get());
+	ASSERT_NE(instr, nullptr);
+	EXPECT_EQ(instr->get_dest(), REGISTER::R4);
+	EXPECT_EQ(instr->get_imm_value(), -3);
+}
+
+TEST(MnemonicTranslatorTest, DivRegInstruction) {
+	std::ofstream output_file("test.asm");
+	output_file << "div r5, r6" << std::endl;
+	output_file.close();
+
+	std::ifstream input_file("test.asm");
+	std::vector<std::shared_ptr<Instr>> instrs;
+	std::map<std::string, int> labels;
+	std::vector<TokenizerError> tokenizer_errors;
+	std::vector<SyntaxError> syntax_errors;
+
+	MnemonicTranslator mn;
+	bool result = mn.translate(input_file, instrs, labels, tokenizer_errors, syntax_errors);
+
+	ASSERT_TRUE(result);
+	EXPECT_EQ(instrs.size(), 1);
+	EXPECT_EQ(tokenizer_errors.size(), 0);
+	EXPECT_EQ(syntax_errors.size(), 0);
+	DivRegInstr* instr = dynamic_cast<DivRegInstr*>(instrs[0].get());
+	ASSERT_NE(instr, nullptr);
+	EXPECT_EQ(instr->get_dest(), REGISTER::R5);
+	EXPECT_EQ(instr->get_src(), REGISTER::R6);
+}
+
+TEST(MnemonicTranslatorTest, DivImmInstruction) {
+	std::ofstream output_file("test.asm");
+	output_file << "div r0, 10" << std::endl;
+	output_file.close();
+
+	std::ifstream input_file("test.asm");
+	std::vector<std::shared_ptr<Instr>> instrs;
+	std::map<std::string, int> labels;
+	std::vector<TokenizerError> tokenizer_errors;
+	std::vector<SyntaxError> syntax_errors;
+
+	MnemonicTranslator mn;
+	bool result = mn.translate(input_file, instrs, labels, tokenizer_errors, syntax_errors);
+
+	ASSERT_TRUE(result);
+	EXPECT_EQ(instrs.size(), 1);
+	EXPECT_EQ(tokenizer_errors.size(), 0);
+	EXPECT_EQ(syntax_errors.size(), 0);
+	DivImmInstr* instr = dynamic_cast<DivImmInstr*>(instrs[0].get());
+	ASSERT_NE(instr, nullptr);
+	EXPECT_EQ(instr->get_dest(), REGISTER::R0);
+	EXPECT_EQ(instr->get_imm_value(), 10);
+}
+
+TEST(MnemonicTranslatorTest, ModRegInstruction) {
+	std::ofstream output_file("test.asm");
+	output_file << "mod r3, r7" << std::endl;
+	output_file.close();
+
+	std::ifstream input_file("test.asm");
+	std::vector<std::shared_ptr<Instr>> instrs;
+	std::map<std::string, int> labels;
+	std::vector<TokenizerError> tokenizer_errors;
+	std::vector<SyntaxError> syntax_errors;
+
+	MnemonicTranslator mn;
+	bool result = mn.translate(input_file, instrs, labels, tokenizer_errors, syntax_errors);
+
+	ASSERT_TRUE(result);
+	EXPECT_EQ(instrs.size(), 1);
+	EXPECT_EQ(tokenizer_errors.size(), 0);
+	EXPECT_EQ(syntax_errors.size(), 0);
+	ModRegInstr* instr = dynamic_cast<ModRegInstr*>(instrs[0].get());
+	ASSERT_NE(instr, nullptr);
+	EXPECT_EQ(instr->get_dest(), REGISTER::R3);
+	EXPECT_EQ(instr->get_src(), REGISTER::R7);
+}
+
+TEST(MnemonicTranslatorTest, ModImmInstruction) {
+	std::ofstream output_file("test.asm");
+	output_file << "mod r2, 0x10" << std::endl;
+	output_file.close();
+
+	std::ifstream input_file("test.asm");
+	std::vector<std::shared_ptr<Instr>> instrs;
+	std::map<std::string, int> labels;
+	std::vector<TokenizerError> tokenizer_errors;
+	std::vector<SyntaxError> syntax_errors;
+
+	MnemonicTranslator mn;
+	bool result = mn.translate(input_file, instrs, labels, tokenizer_errors, syntax_errors);
+
+	ASSERT_TRUE(result);
+	EXPECT_EQ(instrs.size(), 1);
+	EXPECT_EQ(tokenizer_errors.size(), 0);
+	EXPECT_EQ(syntax_errors.size(), 0);
+	ModImmInstr* instr = dynamic_cast<ModImmInstr*>(instrs[0].get());
+	ASSERT_NE(instr, nullptr);
+	EXPECT_EQ(instr->get_dest(), REGISTER::R2);
+	EXPECT_EQ(instr->get_imm_value(), 16);
+}
+
 TEST(MnemonicTranslatorTest, SetRegInstruction) {
 	std::ofstream output_file("test.asm");
 	output_file << "set r1, r2" << std::endl;
@@ -488,6 +633,225 @@ TEST(MnemonicTranslatorTest, LdiInstruction) {
 	EXPECT_EQ(instr->get_src(), REGISTER::R1);
 }
 
+TEST(MnemonicTranslatorTest, LdiOffsetInstruction) {
+	std::ofstream output_file("test.asm");
+	output_file << "ldi r0, r1, -4" << std::endl;
+	output_file.close();
+
+	std::ifstream input_file("test.asm");
+	std::vector<std::shared_ptr<Instr>> instrs;
+	std::map<std::string, int> labels;
+	std::vector<TokenizerError> tokenizer_errors;
+	std::vector<SyntaxError> syntax_errors;
+
+	MnemonicTranslator mn;
+	bool result = mn.translate(input_file, instrs, labels, tokenizer_errors, syntax_errors);
+
+	ASSERT_TRUE(result);
+	EXPECT_EQ(instrs.size(), 1);
+	EXPECT_EQ(tokenizer_errors.size(), 0);
+	EXPECT_EQ(syntax_errors.size(), 0);
+	LdiOffsetInstr* instr = dynamic_cast<LdiOffsetInstr*>(instrs[0].get());
+	ASSERT_NE(instr, nullptr);
+	EXPECT_EQ(instr->get_dest(), REGISTER::R0);
+	EXPECT_EQ(instr->get_src(), REGISTER::R1);
+	EXPECT_EQ(instr->get_offset(), -4);
+}
+
+TEST(MnemonicTranslatorTest, LdiIndexInstruction) {
+	std::ofstream output_file("test.asm");
+	output_file << "ldi r2, r3, r4" << std::endl;
+	output_file.close();
+
+	std::ifstream input_file("test.asm");
+	std::vector<std::shared_ptr<Instr>> instrs;
+	std::map<std::string, int> labels;
+	std::vector<TokenizerError> tokenizer_errors;
+	std::vector<SyntaxError> syntax_errors;
+
+	MnemonicTranslator mn;
+	bool result = mn.translate(input_file, instrs, labels, tokenizer_errors, syntax_errors);
+
+	ASSERT_TRUE(result);
+	EXPECT_EQ(instrs.size(), 1);
+	EXPECT_EQ(tokenizer_errors.size(), 0);
+	EXPECT_EQ(syntax_errors.size(), 0);
+	LdiIndexInstr* instr = dynamic_cast<LdiIndexInstr*>(instrs[0].get());
+	ASSERT_NE(instr, nullptr);
+	EXPECT_EQ(instr->get_dest(), REGISTER::R2);
+	EXPECT_EQ(instr->get_src(), REGISTER::R3);
+	EXPECT_EQ(instr->get_index(), REGISTER::R4);
+}
+
+TEST(MnemonicTranslatorTest, StiInstruction) {
+	std::ofstream output_file("test.asm");
+	output_file << "sti r0, r1" << std::endl;
+	output_file.close();
+
+	std::ifstream input_file("test.asm");
+	std::vector<std::shared_ptr<Instr>> instrs;
+	std::map<std::string, int> labels;
+	std::vector<TokenizerError> tokenizer_errors;
+	std::vector<SyntaxError> syntax_errors;
+
+	MnemonicTranslator mn;
+	bool result = mn.translate(input_file, instrs, labels, tokenizer_errors, syntax_errors);
+
+	ASSERT_TRUE(result);
+	EXPECT_EQ(instrs.size(), 1);
+	EXPECT_EQ(tokenizer_errors.size(), 0);
+	EXPECT_EQ(syntax_errors.size(), 0);
+	StiInstr* instr = dynamic_cast<StiInstr*>(instrs[0].get());
+	ASSERT_NE(instr, nullptr);
+	EXPECT_EQ(instr->get_dest(), REGISTER::R0);
+	EXPECT_EQ(instr->get_src(), REGISTER::R1);
+}
+
+TEST(MnemonicTranslatorTest, StiOffsetInstruction) {
+	std::ofstream output_file("test.asm");
+	output_file << "sti r5, 0x10, r6" << std::endl;
+	output_file.close();
+
+	std::ifstream input_file("test.asm");
+	std::vector<std::shared_ptr<Instr>> instrs;
+	std::map<std::string, int> labels;
+	std::vector<TokenizerError> tokenizer_errors;
+	std::vector<SyntaxError> syntax_errors;
+
+	MnemonicTranslator mn;
+	bool result = mn.translate(input_file, instrs, labels, tokenizer_errors, syntax_errors);
+
+	ASSERT_TRUE(result);
+	EXPECT_EQ(instrs.size(), 1);
+	EXPECT_EQ(tokenizer_errors.size(), 0);
+	EXPECT_EQ(syntax_errors.size(), 0);
+	StiOffsetInstr* instr = dynamic_cast<StiOffsetInstr*>(instrs[0].get());
+	ASSERT_NE(instr, nullptr);
+	EXPECT_EQ(instr->get_dest(), REGISTER::R5);
+	EXPECT_EQ(instr->get_offset(), 16);
+	EXPECT_EQ(instr->get_src(), REGISTER::R6);
+}
+
+TEST(MnemonicTranslatorTest, StiIndexInstruction) {
+	std::ofstream output_file("test.asm");
+	output_file << "sti r1, r2, r3" << std::endl;
+	output_file.close();
+
+	std::ifstream input_file("test.asm");
+	std::vector<std::shared_ptr<Instr>> instrs;
+	std::map<std::string, int> labels;
+	std::vector<TokenizerError> tokenizer_errors;
+	std::vector<SyntaxError> syntax_errors;
+
+	MnemonicTranslator mn;
+	bool result = mn.translate(input_file, instrs, labels, tokenizer_errors, syntax_errors);
+
+	ASSERT_TRUE(result);
+	EXPECT_EQ(instrs.size(), 1);
+	EXPECT_EQ(tokenizer_errors.size(), 0);
+	EXPECT_EQ(syntax_errors.size(), 0);
+	StiIndexInstr* instr = dynamic_cast<StiIndexInstr*>(instrs[0].get());
+	ASSERT_NE(instr, nullptr);
+	EXPECT_EQ(instr->get_dest(), REGISTER::R1);
+	EXPECT_EQ(instr->get_index(), REGISTER::R2);
+	EXPECT_EQ(instr->get_src(), REGISTER::R3);
+}
+
+TEST(MnemonicTranslatorTest, IndexedAddressingErrors) {
+	std::ofstream output_file("test.asm");
+	output_file << "ldi r0, r1," << std::endl;
+	output_file << "ldi r0, r1, name" << std::endl;
+	output_file << "sti r0, 4" << std::endl;
+	output_file << "sti r0, 4, 5" << std::endl;
+	output_file << "sti r0, r1, 2" << std::endl;
+	output_file.close();
+
+	std::ifstream input_file("test.asm");
+	std::vector<std::shared_ptr<Instr>> instrs;
+	std::map<std::string, int> labels;
+	std::vector<TokenizerError> tokenizer_errors;
+	std::vector<SyntaxError> syntax_errors;
+
+	MnemonicTranslator mn;
+	bool result = mn.translate(input_file, instrs, labels, tokenizer_errors, syntax_errors);
+
+	ASSERT_FALSE(result);
+	EXPECT_EQ(instrs.size(), 0);
+	EXPECT_EQ(tokenizer_errors.size(), 0);
+	EXPECT_EQ(syntax_errors.size(), 5);
+}
+
+TEST(MnemonicTranslatorTest, PushInstruction) {
+	std::ofstream output_file("test.asm");
+	output_file << "push r3" << std::endl;
+	output_file.close();
+
+	std::ifstream input_file("test.asm");
+	std::vector<std::shared_ptr<Instr>> instrs;
+	std::map<std::string, int> labels;
+	std::vector<TokenizerError> tokenizer_errors;
+	std::vector<SyntaxError> syntax_errors;
+
+	MnemonicTranslator mn;
+	bool result = mn.translate(input_file, instrs, labels, tokenizer_errors, syntax_errors);
+
+	ASSERT_TRUE(result);
+	EXPECT_EQ(instrs.size(), 1);
+	EXPECT_EQ(tokenizer_errors.size(), 0);
+	EXPECT_EQ(syntax_errors.size(), 0);
+	PushInstr* instr = dynamic_cast<PushInstr*>(instrs[0].get());
+	ASSERT_NE(instr, nullptr);
+	EXPECT_EQ(instr->get_src(), REGISTER::R3);
+}
+
+TEST(MnemonicTranslatorTest, PopInstruction) {
+	std::ofstream output_file("test.asm");
+	output_file << "pop r4" << std::endl;
+	output_file.close();
+
+	std::ifstream input_file("test.asm");
+	std::vector<std::shared_ptr<Instr>> instrs;
+	std::map<std::string, int> labels;
+	std::vector<TokenizerError> tokenizer_errors;
+	std::vector<SyntaxError> syntax_errors;
+
+	MnemonicTranslator mn;
+	bool result = mn.translate(input_file, instrs, labels, tokenizer_errors, syntax_errors);
+
+	ASSERT_TRUE(result);
+	EXPECT_EQ(instrs.size(), 1);
+	EXPECT_EQ(tokenizer_errors.size(), 0);
+	EXPECT_EQ(syntax_errors.size(), 0);
+	PopInstr* instr = dynamic_cast<PopInstr*>(instrs[0].get());
+	ASSERT_NE(instr, nullptr);
+	EXPECT_EQ(instr->get_dest(), REGISTER::R4);
+}
+
+TEST(MnemonicTranslatorTest, StackPointerRegister) {
+	std::ofstream output_file("test.asm");
+	output_file << "ldi r0, sp, 1" << std::endl;
+	output_file.close();
+
+	std::ifstream input_file("test.asm");
+	std::vector<std::shared_ptr<Instr>> instrs;
+	std::map<std::string, int> labels;
+	std::vector<TokenizerError> tokenizer_errors;
+	std::vector<SyntaxError> syntax_errors;
+
+	MnemonicTranslator mn;
+	bool result = mn.translate(input_file, instrs, labels, tokenizer_errors, syntax_errors);
+
+	ASSERT_TRUE(result);
+	EXPECT_EQ(instrs.size(), 1);
+	EXPECT_EQ(tokenizer_errors.size(), 0);
+	EXPECT_EQ(syntax_errors.size(), 0);
+	LdiOffsetInstr* instr = dynamic_cast<LdiOffsetInstr*>(instrs[0].get());
+	ASSERT_NE(instr, nullptr);
+	EXPECT_EQ(instr->get_dest(), REGISTER::R0);
+	EXPECT_EQ(instr->get_src(), REGISTER::SP);
+	EXPECT_EQ(instr->get_offset(), 1);
+}
+
 TEST(MnemonicTranslatorTest, JmpInstruction) {
 	std::ofstream output_file("test.asm");
 	output_file << "jmp loop" << std::endl;
@@ -561,6 +925,131 @@ TEST(MnemonicTranslatorTest, JgtInstruction) {
 	EXPECT_EQ(instr->get_label_name(), "loop");
 }
 
+TEST(MnemonicTranslatorTest, JeqImmInstruction) {
+	std::ofstream output_file("test.asm");
+	output_file << "jeq loop, r0, 10" << std::endl;
+	output_file.close();
+
+	std::ifstream input_file("test.asm");
+	std::vector<std::shared_ptr<Instr>> instrs;
+	std::map<std::string, int> labels;
+	std::vector<TokenizerError> tokenizer_errors;
+	std::vector<SyntaxError> syntax_errors;
+
+	MnemonicTranslator mn;
+	bool result = mn.translate(input_file, instrs, labels, tokenizer_errors, syntax_errors);
+
+	ASSERT_TRUE(result);
+	EXPECT_EQ(instrs.size(), 1);
+	EXPECT_EQ(tokenizer_errors.size(), 0);
+	EXPECT_EQ(syntax_errors.size(), 0);
+	JeqImmInstr* instr = dynamic_cast<JeqImmInstr*>(instrs[0].get());
+	ASSERT_NE(instr, nullptr);
+	EXPECT_EQ(instr->get_src1(), REGISTER::R0);
+	EXPECT_EQ(instr->get_imm_value(), 10);
+	EXPECT_EQ(instr->get_label_name(), "loop");
+}
+
+TEST(MnemonicTranslatorTest, JneInstruction) {
+	std::ofstream output_file("test.asm");
+	output_file << "jne loop, r2, r3" << std::endl;
+	output_file.close();
+
+	std::ifstream input_file("test.asm");
+	std::vector<std::shared_ptr<Instr>> instrs;
+	std::map<std::string, int> labels;
+	std::vector<TokenizerError> tokenizer_errors;
+	std::vector<SyntaxError> syntax_errors;
+
+	MnemonicTranslator mn;
+	bool result = mn.translate(input_file, instrs, labels, tokenizer_errors, syntax_errors);
+
+	ASSERT_TRUE(result);
+	EXPECT_EQ(instrs.size(), 1);
+	EXPECT_EQ(tokenizer_errors.size(), 0);
+	EXPECT_EQ(syntax_errors.size(), 0);
+	JneInstr* instr = dynamic_cast<JneInstr*>(instrs[0].get());
+	ASSERT_NE(instr, nullptr);
+	EXPECT_EQ(instr->get_src1(), REGISTER::R2);
+	EXPECT_EQ(instr->get_src2(), REGISTER::R3);
+	EXPECT_EQ(instr->get_label_name(), "loop");
+}
+
+TEST(MnemonicTranslatorTest, JltImmInstruction) {
+	std::ofstream output_file("test.asm");
+	output_file << "jlt loop, r1, -0x10" << std::endl;
+	output_file.close();
+
+	std::ifstream input_file("test.asm");
+	std::vector<std::shared_ptr<Instr>> instrs;
+	std::map<std::string, int> labels;
+	std::vector<TokenizerError> tokenizer_errors;
+	std::vector<SyntaxError> syntax_errors;
+
+	MnemonicTranslator mn;
+	bool result = mn.translate(input_file, instrs, labels, tokenizer_errors, syntax_errors);
+
+	ASSERT_TRUE(result);
+	EXPECT_EQ(instrs.size(), 1);
+	EXPECT_EQ(tokenizer_errors.size(), 0);
+	EXPECT_EQ(syntax_errors.size(), 0);
+	JltImmInstr* instr = dynamic_cast<JltImmInstr*>(instrs[0].get());
+	ASSERT_NE(instr, nullptr);
+	EXPECT_EQ(instr->get_src1(), REGISTER::R1);
+	EXPECT_EQ(instr->get_imm_value(), -16);
+	EXPECT_EQ(instr->get_label_name(), "loop");
+}
+
+TEST(MnemonicTranslatorTest, JgeInstruction) {
+	std::ofstream output_file("test.asm");
+	output_file << "jge end, r4, r5" << std::endl;
+	output_file.close();
+
+	std::ifstream input_file("test.asm");
+	std::vector<std::shared_ptr<Instr>> instrs;
+	std::map<std::string, int> labels;
+	std::vector<TokenizerError> tokenizer_errors;
+	std::vector<SyntaxError> syntax_errors;
+
+	MnemonicTranslator mn;
+	bool result = mn.translate(input_file, instrs, labels, tokenizer_errors, syntax_errors);
+
+	ASSERT_TRUE(result);
+	EXPECT_EQ(instrs.size(), 1);
+	EXPECT_EQ(tokenizer_errors.size(), 0);
+	EXPECT_EQ(syntax_errors.size(), 0);
+	JgeInstr* instr = dynamic_cast<JgeInstr*>(instrs[0].get());
+	ASSERT_NE(instr, nullptr);
+	EXPECT_EQ(instr->get_src1(), REGISTER::R4);
+	EXPECT_EQ(instr->get_src2(), REGISTER::R5);
+	EXPECT_EQ(instr->get_label_name(), "end");
+}
+
+TEST(MnemonicTranslatorTest, JleImmInstruction) {
+	std::ofstream output_file("test.asm");
+	output_file << "jle end, r6, 'a'" << std::endl;
+	output_file.close();
+
+	std::ifstream input_file("test.asm");
+	std::vector<std::shared_ptr<Instr>> instrs;
+	std::map<std::string, int> labels;
+	std::vector<TokenizerError> tokenizer_errors;
+	std::vector<SyntaxError> syntax_errors;
+
+	MnemonicTranslator mn;
+	bool result = mn.translate(input_file, instrs, labels, tokenizer_errors, syntax_errors);
+
+	ASSERT_TRUE(result);
+	EXPECT_EQ(instrs.size(), 1);
+	EXPECT_EQ(tokenizer_errors.size(), 0);
+	EXPECT_EQ(syntax_errors.size(), 0);
+	JleImmInstr* instr = dynamic_cast<JleImmInstr*>(instrs[0].get());
+	ASSERT_NE(instr, nullptr);
+	EXPECT_EQ(instr->get_src1(), REGISTER::R6);
+	EXPECT_EQ(instr->get_imm_value(), 'a');
+	EXPECT_EQ(instr->get_label_name(), "end");
+}
+
 TEST(MnemonicTranslatorTest, CallInstruction) {
 	std::ofstream output_file("test.asm");
 	output_file << "call factorial" << std::endl;
@@ -806,4 +1295,214 @@ TEST(MnemonicTranslatorTest, LabelWithoutColon) {
 	ASSERT_NE(instr1, nullptr);
 	EXPECT_EQ(instr1->get_dest(), REGISTER::R0);
 	EXPECT_EQ(instr1->get_imm_value(), 12);
-}
\ No newline at end of file
+}
+
+TEST(MnemonicTranslatorTest, LinkResolvesLabels) {
+	std::ofstream output_file("test.asm");
+	output_file << "jmp end" << std::endl;
+	output_file << "loop:" << std::endl;
+	output_file << "add r0, 1" << std::endl;
+	output_file << "call puti" << std::endl;
+	output_file << "end: jgt loop, r1, r0" << std::endl;
+	output_file.close();
+
+	std::ifstream input_file("test.asm");
+	std::vector<std::shared_ptr<Instr>> instrs;
+	std::map<std::string, int> labels;
+	std::vector<TokenizerError> tokenizer_errors;
+	std::vector<SyntaxError> syntax_errors;
+
+	MnemonicTranslator mn;
+	ASSERT_TRUE(mn.translate(input_file, instrs, labels, tokenizer_errors, syntax_errors));
+	bool result = mn.link(instrs, labels, syntax_errors);
+
+	ASSERT_TRUE(result);
+	EXPECT_EQ(syntax_errors.size(), 0);
+
+	JmpInstr* instr1 = dynamic_cast<JmpInstr*>(instrs[0].get());
+	ASSERT_NE(instr1, nullptr);
+	EXPECT_EQ(instr1->get_address(), 3);
+
+	CallInstr* instr2 = dynamic_cast<CallInstr*>(instrs[2].get());
+	ASSERT_NE(instr2, nullptr);
+	EXPECT_FALSE(instr2->is_linked());
+
+	JgtInstr* instr3 = dynamic_cast<JgtInstr*>(instrs[3].get());
+	ASSERT_NE(instr3, nullptr);
+	EXPECT_EQ(instr3->get_address(), 1);
+}
+
+TEST(MnemonicTranslatorTest, LinkUnknownLabel) {
+	std::ofstream output_file("test.asm");
+	output_file << "jmp loop" << std::endl;
+	output_file << "call factorial" << std::endl;
+	output_file.close();
+
+	std::ifstream input_file("test.asm");
+	std::vector<std::shared_ptr<Instr>> instrs;
+	std::map<std::string, int> labels;
+	std::vector<TokenizerError> tokenizer_errors;
+	std::vector<SyntaxError> syntax_errors;
+
+	MnemonicTranslator mn;
+	ASSERT_TRUE(mn.translate(input_file, instrs, labels, tokenizer_errors, syntax_errors));
+	bool result = mn.link(instrs, labels, syntax_errors);
+
+	ASSERT_FALSE(result);
+	ASSERT_EQ(syntax_errors.size(), 2);
+	EXPECT_EQ(syntax_errors[0].what(), "Строка 1: Неизвестная метка \"loop\"");
+	EXPECT_EQ(syntax_errors[1].what(), "Строка 2: Неизвестная метка \"factorial\"");
+}
+
+TEST(MnemonicTranslatorTest, TranslateFromMemory) {
+	// Последняя строка не заканчивается переводом строки, а строки могут заканчиваться на \r\n
+	std::string source = "data msg \"hi\"\r\nloop: sub r0, 1\r\n\njgt loop, r0, r1";
+	std::vector<std::shared_ptr<Instr>> instrs;
+	std::map<std::string, int> labels;
+	std::vector<TokenizerError> tokenizer_errors;
+	std::vector<SyntaxError> syntax_errors;
+
+	MnemonicTranslator mn;
+	bool result = mn.translate(std::string_view(source), instrs, labels, tokenizer_errors, syntax_errors);
+
+	ASSERT_TRUE(result);
+	ASSERT_EQ(instrs.size(), 3);
+	EXPECT_EQ(labels["loop"], 1);
+	EXPECT_EQ(instrs[2]->get_line_number(), 4);
+
+	DataInstr* instr = dynamic_cast<DataInstr*>(instrs[0].get());
+	ASSERT_NE(instr, nullptr);
+	EXPECT_EQ(instr->get_data_label_name(), "msg");
+	EXPECT_EQ(instr->get_data(), std::vector<int>({ 'h', 'i', 0 }));
+}
+
+TEST(MnemonicTranslatorTest, NumberLiterals) {
+	std::string source = "add r0, -0x1F\nadd r1, +0o17\nset r2, 0b101\nset r3, 'a'\nset r4, 99999999999999999999\n"
+		"set r5, 3000000000\nset r6, 0x1FFFFFFFF\nset r7, 0xFFFFFFFF\nadd r0, -2147483648\nset r1, 2147483648";
+	std::vector<std::shared_ptr<Instr>> instrs;
+	std::map<std::string, int> labels;
+	std::vector<TokenizerError> tokenizer_errors;
+	std::vector<SyntaxError> syntax_errors;
+
+	MnemonicTranslator mn;
+	bool result = mn.translate(std::string_view(source), instrs, labels, tokenizer_errors, syntax_errors);
+
+	ASSERT_FALSE(result);
+	ASSERT_EQ(instrs.size(), 6);
+	EXPECT_EQ(dynamic_cast<AddImmInstr*>(instrs[0].get())->get_imm_value(), -0x1F);
+	EXPECT_EQ(dynamic_cast<AddImmInstr*>(instrs[1].get())->get_imm_value(), 017);
+	EXPECT_EQ(dynamic_cast<SetImmInstr*>(instrs[2].get())->get_imm_value(), 5);
+	EXPECT_EQ(dynamic_cast<SetImmInstr*>(instrs[3].get())->get_imm_value(), 'a');
+	// Шестнадцатеричное число до 0xFFFFFFFF задает образ числа, а десятичное должно помещаться в int
+	EXPECT_EQ(dynamic_cast<SetImmInstr*>(instrs[4].get())->get_imm_value(), -1);
+	EXPECT_EQ(dynamic_cast<AddImmInstr*>(instrs[5].get())->get_imm_value(), INT_MIN);
+	ASSERT_EQ(syntax_errors.size(), 4);
+	EXPECT_EQ(syntax_errors[0].what(), "Строка 5: Слишком большое число \"99999999999999999999\"");
+	EXPECT_EQ(syntax_errors[1].what(), "Строка 6: Слишком большое число \"3000000000\"");
+	EXPECT_EQ(syntax_errors[2].what(), "Строка 7: Слишком большое число \"0x1FFFFFFFF\"");
+	EXPECT_EQ(syntax_errors[3].what(), "Строка 10: Слишком большое число \"2147483648\"");
+}
+
+TEST(MnemonicTranslatorTest, LayoutDataAssignsAddresses) {
+	std::string source = "set r0, count\nst count, r0\ndata msg \"ab\"\ndata count 7\nld r1, msg";
+	std::vector<std::shared_ptr<Instr>> instrs;
+	std::map<std::string, int> labels;
+	std::vector<TokenizerError> tokenizer_errors;
+	std::vector<SyntaxError> syntax_errors;
+
+	MnemonicTranslator mn;
+	ASSERT_TRUE(mn.translate(std::string_view(source), instrs, labels, tokenizer_errors, syntax_errors));
+
+	std::map<std::string, int> data_addresses;
+	std::vector<int> memory_image;
+	ASSERT_TRUE(mn.layout_data(instrs, data_addresses, memory_image, syntax_errors));
+
+	EXPECT_EQ(data_addresses["msg"], 0);
+	EXPECT_EQ(data_addresses["count"], 3);
+	EXPECT_EQ(memory_image, std::vector<int>({ 'a', 'b', 0, 7 }));
+	EXPECT_EQ(dynamic_cast<SetNameInstr*>(instrs[0].get())->get_data_address(), 3);
+	EXPECT_EQ(dynamic_cast<StInstr*>(instrs[1].get())->get_data_address(), 3);
+	EXPECT_EQ(dynamic_cast<DataInstr*>(instrs[2].get())->get_data_address(), 0);
+	EXPECT_EQ(dynamic_cast<LdInstr*>(instrs[4].get())->get_data_address(), 0);
+}
+
+TEST(MnemonicTranslatorTest, LayoutDataErrors) {
+	std::string source = "data x 1\ndata x 2\nld r0, y";
+	std::vector<std::shared_ptr<Instr>> instrs;
+	std::map<std::string, int> labels;
+	std::vector<TokenizerError> tokenizer_errors;
+	std::vector<SyntaxError> syntax_errors;
+
+	MnemonicTranslator mn;
+	ASSERT_TRUE(mn.translate(std::string_view(source), instrs, labels, tokenizer_errors, syntax_errors));
+
+	std::map<std::string, int> data_addresses;
+	std::vector<int> memory_image;
+	ASSERT_FALSE(mn.layout_data(instrs, data_addresses, memory_image, syntax_errors));
+
+	ASSERT_EQ(syntax_errors.size(), 2);
+	EXPECT_EQ(syntax_errors[0].what(), "Строка 2: Имя переменной не может повторяться \"x\"");
+	EXPECT_EQ(syntax_errors[1].what(), "Строка 3: Неизвестное имя ячейки памяти \"y\"");
+	EXPECT_EQ(memory_image, std::vector<int>({ 1 }));
+}
+
+TEST(MnemonicTranslatorTest, ParallelTranslationMatchesSequential) {
+	// Метки на отдельных строках и их повторные объявления часто оказываются на границах частей
+	std::string source;
+	for (int i = 0; source.size() < 2 * PARALLEL_TRANSLATION_MIN_SIZE; i++) {
+		std::string n = std::to_string(i);
+		source += "l" + n + ":\nm" + n + ": add r0, " + n + "\nd" + n + ":\nd" + n + ": sub r0, 1\njmp l" + n + "\nset r1, &\n";
+	}
+
+	std::vector<std::shared_ptr<Instr>> expected_instrs;
+	std::map<std::string, int> expected_labels;
+	std::vector<TokenizerError> expected_tokenizer_errors;
+	std::vector<SyntaxError> expected_syntax_errors;
+
+	MnemonicTranslator mn;
+	ASSERT_FALSE(mn.translate(std::string_view(source), expected_instrs, expected_labels, expected_tokenizer_errors, expected_syntax_errors));
+
+	for (int thread_count = 2; thread_count <= 7; thread_count++) {
+		std::vector<std::shared_ptr<Instr>> instrs;
+		std::map<std::string, int> labels;
+		std::vector<TokenizerError> tokenizer_errors;
+		std::vector<SyntaxError> syntax_errors;
+
+		ASSERT_FALSE(mn.translate(std::string_view(source), instrs, labels, tokenizer_errors, syntax_errors, thread_count));
+
+		ASSERT_EQ(instrs.size(), expected_instrs.size());
+		for (size_t i = 0; i < instrs.size(); i++) {
+			ASSERT_EQ(typeid(*instrs[i]), typeid(*expected_instrs[i]));
+			ASSERT_EQ(instrs[i]->get_line_number(), expected_instrs[i]->get_line_number());
+		}
+		EXPECT_EQ(labels, expected_labels);
+
+		ASSERT_EQ(tokenizer_errors.size(), expected_tokenizer_errors.size());
+		for (size_t i = 0; i < tokenizer_errors.size(); i++) {
+			ASSERT_EQ(tokenizer_errors[i].what(), expected_tokenizer_errors[i].what());
+		}
+		ASSERT_EQ(syntax_errors.size(), expected_syntax_errors.size());
+		for (size_t i = 0; i < syntax_errors.size(); i++) {
+			ASSERT_EQ(syntax_errors[i].what(), expected_syntax_errors[i].what());
+		}
+	}
+
+	// Граница двух частей проходит сразу после строки "dup:", повторное объявление обнаруживается во второй части
+	std::string filler;
+	int filler_lines = PARALLEL_TRANSLATION_MIN_SIZE / 10;
+	for (int i = 0; i < filler_lines; i++) {
+		filler += "add r0, 1\n";
+	}
+	std::string boundary_source = filler + "add r0, 1\nadd r0, 1\ndup:\ndup: add r0, 1\n" + filler;
+
+	std::vector<std::shared_ptr<Instr>> instrs;
+	std::map<std::string, int> labels;
+	std::vector<TokenizerError> tokenizer_errors;
+	std::vector<SyntaxError> syntax_errors;
+
+	ASSERT_FALSE(mn.translate(std::string_view(boundary_source), instrs, labels, tokenizer_errors, syntax_errors, 2));
+	ASSERT_EQ(syntax_errors.size(), 1);
+	EXPECT_EQ(syntax_errors[0].what(), "Строка " + std::to_string(filler_lines + 4) + ": Метка \"dup\" объявляется более одного раза");
+	EXPECT_EQ(instrs.size(), 2 * filler_lines + 2);
+	EXPECT_EQ(labels["dup"], filler_lines + 2);
+}
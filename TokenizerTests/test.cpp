@@ -4,10 +4,20 @@
 
 #include "pch.h"
 #include "../KNPO-Molchanov-PrIn-266/Tokenizer.h"
+#include "../KNPO-Molchanov-PrIn-266/DfaTokenizer.h"
 
 
-TEST(TokenizerTest, NoTokens) {
-	Tokenizer tokenizer;
+// Все тесты выполняются для обоих токенайзеров, так как они должны выделять одинаковые токены
+template <typename T>
+class TokenizerTest : public ::testing::Test {
+};
+
+typedef ::testing::Types<Tokenizer, DfaTokenizer> TokenizerTypes;
+TYPED_TEST_CASE(TokenizerTest, TokenizerTypes);
+
+
+TYPED_TEST(TokenizerTest, NoTokens) {
+	TypeParam tokenizer;
 	std::vector<Token> tokens;
 	std::string str = "";
 
@@ -16,8 +26,8 @@ TEST(TokenizerTest, NoTokens) {
 	ASSERT_EQ(tokens.size(), 0);
 }
 
-TEST(TokenizerTest, CommentWithReservedWords) {
-	Tokenizer tokenizer;
+TYPED_TEST(TokenizerTest, CommentWithReservedWords) {
+	TypeParam tokenizer;
 	std::vector<Token> tokens;
 	std::string str = "; add r0";
 
@@ -26,8 +36,8 @@ TEST(TokenizerTest, CommentWithReservedWords) {
 	ASSERT_EQ(tokens.size(), 0);
 }
 
-TEST(TokenizerTest, String) {
-	Tokenizer tokenizer;
+TYPED_TEST(TokenizerTest, String) {
+	TypeParam tokenizer;
 	std::vector<Token> tokens;
 	std::string str = "\"string\"";
 	Token expected_token = { TOKEN_TYPE::STRING, "\"string\"", 0, 7 };
@@ -41,8 +51,8 @@ TEST(TokenizerTest, String) {
 	EXPECT_EQ(tokens[0].end_index, expected_token.end_index);
 }
 
-TEST(TokenizerTest, Char) {
-	Tokenizer tokenizer;
+TYPED_TEST(TokenizerTest, Char) {
+	TypeParam tokenizer;
 	std::vector<Token> tokens;
 	std::string str = "'a'";
 	Token expected_token = { TOKEN_TYPE::CHAR, "'a'", 0, 2 };
@@ -56,8 +66,8 @@ TEST(TokenizerTest, Char) {
 	EXPECT_EQ(tokens[0].end_index, expected_token.end_index);
 }
 
-TEST(TokenizerTest, Numbers) {
-	Tokenizer tokenizer;
+TYPED_TEST(TokenizerTest, Numbers) {
+	TypeParam tokenizer;
 
 	std::vector<std::pair<std::string, Token>> test_data = {
 		{ "0xffa21", { TOKEN_TYPE::HEX_NUMBER, "0xffa21", 0, 6 } },
@@ -79,8 +89,8 @@ TEST(TokenizerTest, Numbers) {
 	}
 }
 
-TEST(TokenizerTest, ReservedWords) {
-	Tokenizer tokenizer;
+TYPED_TEST(TokenizerTest, ReservedWords) {
+	TypeParam tokenizer;
 
 	std::vector<std::pair<std::string, Token>> test_data = {
 		{ "add", { TOKEN_TYPE::ADD, "add", 0, 2 } },
@@ -91,14 +101,23 @@ TEST(TokenizerTest, ReservedWords) {
 		{ "not", { TOKEN_TYPE::NOT, "not", 0, 2 } },
 		{ "shr", { TOKEN_TYPE::SHR, "shr", 0, 2 } },
 		{ "shl", { TOKEN_TYPE::SHL, "shl", 0, 2 } },
+		{ "mul", { TOKEN_TYPE::MUL, "mul", 0, 2 } },
+		{ "div", { TOKEN_TYPE::DIV, "div", 0, 2 } },
+		{ "mod", { TOKEN_TYPE::MOD, "mod", 0, 2 } },
 		{ "set", { TOKEN_TYPE::SET, "set", 0, 2 } },
 		{ "ld", { TOKEN_TYPE::LD, "ld", 0, 1 } },
 		{ "st", { TOKEN_TYPE::ST, "st", 0, 1 } },
 		{ "ldi", { TOKEN_TYPE::LDI, "ldi", 0, 2 } },
 		{ "sti", { TOKEN_TYPE::STI, "sti", 0, 2 } },
+		{ "push", { TOKEN_TYPE::PUSH, "push", 0, 3 } },
+		{ "pop", { TOKEN_TYPE::POP, "pop", 0, 2 } },
 		{ "jmp", { TOKEN_TYPE::JMP, "jmp", 0, 2 } },
 		{ "jeq", { TOKEN_TYPE::JEQ, "jeq", 0, 2 } },
+		{ "jne", { TOKEN_TYPE::JNE, "jne", 0, 2 } },
 		{ "jgt", { TOKEN_TYPE::JGT, "jgt", 0, 2 } },
+		{ "jlt", { TOKEN_TYPE::JLT, "jlt", 0, 2 } },
+		{ "jge", { TOKEN_TYPE::JGE, "jge", 0, 2 } },
+		{ "jle", { TOKEN_TYPE::JLE, "jle", 0, 2 } },
 		{ "call", { TOKEN_TYPE::CALL, "call", 0, 3 } },
 		{ "ret", { TOKEN_TYPE::RET, "ret", 0, 2 } },
 		{ "data", { TOKEN_TYPE::DATA, "data", 0, 3 } },
@@ -110,6 +129,7 @@ TEST(TokenizerTest, ReservedWords) {
 		{ "r5", { TOKEN_TYPE::R5, "r5", 0, 1  } },
 		{ "r6", { TOKEN_TYPE::R6, "r6", 0, 1  } },
 		{ "r7", { TOKEN_TYPE::R7, "r7", 0, 1  } },
+		{ "sp", { TOKEN_TYPE::SP, "sp", 0, 1  } },
 	};
 
 	for (const auto& test : test_data) {
@@ -125,8 +145,8 @@ TEST(TokenizerTest, ReservedWords) {
 	}
 }
 
-TEST(TokenizerTest, SeveralNames) {
-	Tokenizer tokenizer;
+TYPED_TEST(TokenizerTest, SeveralNames) {
+	TypeParam tokenizer;
 	std::vector<Token> tokens;
 	std::string str = "hello world";
 	std::vector<Token> expected_tokens = {
@@ -145,8 +165,8 @@ TEST(TokenizerTest, SeveralNames) {
 	}
 }
 
-TEST(TokenizerTest, SpecialSymbols) {
-	Tokenizer tokenizer;
+TYPED_TEST(TokenizerTest, SpecialSymbols) {
+	TypeParam tokenizer;
 
 	std::vector<std::pair<std::string, Token>> test_data = {
 		{ "+", { TOKEN_TYPE::PLUS, "+", 0, 0 }  },
@@ -168,8 +188,8 @@ TEST(TokenizerTest, SpecialSymbols) {
 	}
 }
 
-TEST(TokenizerTest, Spaces) {
-	Tokenizer tokenizer;
+TYPED_TEST(TokenizerTest, Spaces) {
+	TypeParam tokenizer;
 	std::vector<Token> tokens;
 	std::string str = "              ";
 
@@ -178,40 +198,40 @@ TEST(TokenizerTest, Spaces) {
 	ASSERT_EQ(tokens.size(), 0);
 }
 
-TEST(TokenizerTest, UnknownToken) {
-	Tokenizer tokenizer;
+TYPED_TEST(TokenizerTest, UnknownToken) {
+	TypeParam tokenizer;
 	std::vector<Token> tokens;
 	std::string str = "!";
 
 	ASSERT_THROW(tokenizer.tokenize(str, tokens), TokenizerError);
 }
 
-TEST(TokenizerTest, UnclosedString) {
-	Tokenizer tokenizer;
+TYPED_TEST(TokenizerTest, UnclosedString) {
+	TypeParam tokenizer;
 	std::vector<Token> tokens;
 	std::string str = "\"hello world";
 
 	ASSERT_THROW(tokenizer.tokenize(str, tokens), TokenizerError);
 }
 
-TEST(TokenizerTest, UnclosedChar) {
-	Tokenizer tokenizer;
+TYPED_TEST(TokenizerTest, UnclosedChar) {
+	TypeParam tokenizer;
 	std::vector<Token> tokens;
 	std::string str = "'a";
 
 	ASSERT_THROW(tokenizer.tokenize(str, tokens), TokenizerError);
 }
 
-TEST(TokenizerTest, CharHoldsOnlyOneSymbol) {
-	Tokenizer tokenizer;
+TYPED_TEST(TokenizerTest, CharHoldsOnlyOneSymbol) {
+	TypeParam tokenizer;
 	std::vector<Token> tokens;
 	std::string str = "'aascasc'";
 
 	ASSERT_THROW(tokenizer.tokenize(str, tokens), TokenizerError);
 }
 
-TEST(TokenizerTest, NonReservedTokenStartsWithReservedWord) {
-	Tokenizer tokenizer;
+TYPED_TEST(TokenizerTest, NonReservedTokenStartsWithReservedWord) {
+	TypeParam tokenizer;
 	std::vector<Token> tokens;
 	std::string str = "callmelater";
 	Token expeceted_token = { TOKEN_TYPE::NAME, "callmelater", 0, 10 };
@@ -225,8 +245,8 @@ TEST(TokenizerTest, NonReservedTokenStartsWithReservedWord) {
 	EXPECT_EQ(tokens[0].end_index, expeceted_token.end_index);
 }
 
-TEST(TokenizerTest, ComplexTest) {
-	Tokenizer tokenizer;
+TYPED_TEST(TokenizerTest, ComplexTest) {
+	TypeParam tokenizer;
 	std::vector<Token> tokens;
 	const std::string str = "add r0, r1; add r0 adfsdfg asdf as";
 	std::vector<Token> expected_tokens = {
@@ -246,3 +266,65 @@ TEST(TokenizerTest, ComplexTest) {
 		EXPECT_EQ(tokens[i].end_index, expected_tokens[i].end_index);
 	}
 }
+
+TYPED_TEST(TokenizerTest, TokenTextReferencesSource) {
+	TypeParam tokenizer;
+	std::vector<Token> tokens;
+	const std::string str = "set r0, name";
+
+	tokenizer.tokenize(str, tokens);
+
+	ASSERT_EQ(tokens.size(), 4);
+	for (const Token& token : tokens) {
+		EXPECT_EQ(token.text.data(), str.data() + token.start_index);
+	}
+}
+
+TEST(DfaTokenizerTest, SameTokensAsRegexTokenizer) {
+	Tokenizer regex_tokenizer;
+	DfaTokenizer dfa_tokenizer;
+	std::vector<std::string> lines = {
+		"loop: sub r1, 1 ; comment",
+		"data msg \"a\", \"b\"",
+		"set r0, '\\''",
+		"set r0, '\\n'",
+		"set r0, ' '",
+		"add r0, 0xffg",
+		"add r0, 0o19",
+		"add r0, 0b102",
+		"add r0, 0x",
+		"callmelater r8 _name1 ldi sti",
+		"\"\"",
+		"\t set\tr7 , -0X1F\r",
+	};
+
+	for (const std::string& line : lines) {
+		std::vector<Token> expected_tokens;
+		std::vector<Token> tokens;
+
+		regex_tokenizer.tokenize(line, expected_tokens);
+		dfa_tokenizer.tokenize(line, tokens);
+
+		ASSERT_EQ(tokens.size(), expected_tokens.size()) << line;
+		for (int i = 0; i < tokens.size(); i++) {
+			EXPECT_EQ(tokens[i].type, expected_tokens[i].type) << line;
+			EXPECT_EQ(tokens[i].text, expected_tokens[i].text) << line;
+			EXPECT_EQ(tokens[i].start_index, expected_tokens[i].start_index) << line;
+			EXPECT_EQ(tokens[i].end_index, expected_tokens[i].end_index) << line;
+		}
+	}
+}
+
+TEST(DfaTokenizerTest, SameErrorsAsRegexTokenizer) {
+	Tokenizer regex_tokenizer;
+	DfaTokenizer dfa_tokenizer;
+	std::vector<std::string> lines = { "add r0, #1", "\"unclosed", "'ab'", "'", "\"a\nb\"" };
+
+	for (const std::string& line : lines) {
+		std::vector<Token> tokens;
+
+		EXPECT_THROW(regex_tokenizer.tokenize(line, tokens), TokenizerError) << line;
+		tokens.clear();
+		EXPECT_THROW(dfa_tokenizer.tokenize(line, tokens), TokenizerError) << line;
+	}
+}